@@ -0,0 +1,51 @@
+#EScript performance scripts
+#runs every script of the subtest with and without superinstructions and prints the timings
+
+cmake_minimum_required(VERSION 3.2)
+if(NOT DEFINED testdir)
+  message(FATAL_ERROR "testdir not defined")
+endif()
+if(NOT DEFINED subtest)
+  message(FATAL_ERROR "subtest not defined")
+endif()
+if(NOT DEFINED runecl)
+  message(FATAL_ERROR "runecl not defined")
+endif()
+if(NOT DEFINED ecompile)
+  message(FATAL_ERROR "ecompile not defined")
+endif()
+
+function (runperf scriptname option result)
+  execute_process( COMMAND ${runecl} -q -p ${option} "${scriptname}.ecl"
+    RESULT_VARIABLE runecl_res
+    OUTPUT_VARIABLE runecl_out
+    ERROR_VARIABLE runecl_out)
+  if(NOT "${runecl_res}" STREQUAL "0")
+    message(SEND_ERROR "${scriptname}.ecl did not run")
+    message(${runecl_out})
+  endif()
+  string(REGEX MATCH "Clocks: [^\n]*" clocks "${runecl_out}")
+  string(REGEX MATCH "Instruction cycles: [^\n]*" cycles "${runecl_out}")
+  set(${result} "${clocks}, ${cycles}" PARENT_SCOPE)
+endfunction()
+
+file(GLOB scripts RELATIVE ${testdir} ${testdir}/${subtest}/*.src)
+foreach(script ${scripts})
+  string(REPLACE ".src" "" scriptname "${script}")
+  if (NOT EXISTS "${testdir}/${scriptname}.out")
+    continue()
+  endif()
+  execute_process( COMMAND ${ecompile} -q -C ecompile.cfg ${script}
+    RESULT_VARIABLE ecompile_res
+    OUTPUT_VARIABLE ecompile_out
+    ERROR_VARIABLE ecompile_out)
+  if(NOT "${ecompile_res}" STREQUAL "0")
+    message(SEND_ERROR "${scriptname}.src did not compile")
+    message(${ecompile_out})
+    continue()
+  endif()
+  runperf(${scriptname} "-n" plain)
+  runperf(${scriptname} "" super)
+  message("${script}\n  plain: ${plain}\n  super: ${super}")
+  file(REMOVE "${scriptname}.ecl")
+endforeach()
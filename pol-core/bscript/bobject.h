@@ -591,6 +591,7 @@ public:
   virtual size_t sizeEstimate() const override;
 
   int value() const { return lval_; }
+  void setvalue( int lval ) { lval_ = lval; }
   int increment() { return ++lval_; }
 
 public:  // Class Machinery
@@ -715,6 +716,7 @@ public:
   virtual size_t sizeEstimate() const override;
 
   double value() const { return dval_; }
+  void setvalue( double dval ) { dval_ = dval; }
   void copyvalue( const Double& dbl ) { dval_ = dbl.dval_; }
   double increment() { return ++dval_; }
 
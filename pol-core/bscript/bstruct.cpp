@@ -10,8 +10,10 @@
 
 #include "bstruct.h"
 
+#include <algorithm>
 #include <stddef.h>
 
+#include "../clib/clib.h"
 #include "../clib/passert.h"
 #include "../clib/stlutil.h"
 #include "berror.h"
@@ -25,12 +27,124 @@ namespace Pol
 {
 namespace Bscript
 {
+bool StructContents::Less::operator()( const value_type& lhs, const value_type& rhs ) const
+{
+  return stricmp( lhs.first.c_str(), rhs.first.c_str() ) < 0;
+}
+
+StructContents::StructContents() : flat_(), tree_() {}
+
+StructContents::const_iterator StructContents::begin() const
+{
+  if ( tree_ )
+    return const_iterator( tree_->cbegin() );
+  return const_iterator( flat_.cbegin() );
+}
+
+StructContents::const_iterator StructContents::end() const
+{
+  if ( tree_ )
+    return const_iterator( tree_->cend() );
+  return const_iterator( flat_.cend() );
+}
+
+void StructContents::reserve( size_t n )
+{
+  if ( tree_ )
+    return;
+  if ( n > MAX_FLAT_SIZE )
+    make_tree();
+  else
+    flat_.reserve( n );
+}
+
+size_t StructContents::estimatedSize() const
+{
+  size_t size = sizeof( StructContents ) + flat_.capacity() * sizeof( value_type );
+  if ( tree_ )
+    size += sizeof( Tree ) + tree_->size() * ( sizeof( value_type ) + 4 * sizeof( void* ) );
+  return size;
+}
+
+std::vector<StructContents::value_type>::const_iterator StructContents::lower_bound(
+    const char* name ) const
+{
+  return std::lower_bound( flat_.begin(), flat_.end(), name,
+                           []( const value_type& member, const char* key ) {
+                             return stricmp( member.first.c_str(), key ) < 0;
+                           } );
+}
+
+StructContents::const_iterator StructContents::find( const char* name ) const
+{
+  if ( tree_ )
+    return const_iterator( tree_->find( value_type( name, BObjectRef() ) ) );
+  auto itr = lower_bound( name );
+  if ( itr == flat_.end() || stricmp( itr->first.c_str(), name ) != 0 )
+    return end();
+  return const_iterator( itr );
+}
+
+// the member with the given name, added with ref if it didn't exist yet
+std::pair<BObjectRef*, bool> StructContents::emplace( const char* name, const BObjectRef& ref )
+{
+  if ( !tree_ )
+  {
+    auto itr = lower_bound( name );
+    if ( itr != flat_.end() && stricmp( itr->first.c_str(), name ) == 0 )
+      return std::make_pair( &itr->second, false );
+    if ( flat_.size() < MAX_FLAT_SIZE )
+    {
+      if ( flat_.capacity() == 0 )
+      {
+        flat_.reserve( MAX_FLAT_SIZE );
+        itr = flat_.end();
+      }
+      return std::make_pair( &flat_.insert( itr, value_type( name, ref ) )->second, true );
+    }
+    make_tree();
+  }
+  auto result = tree_->insert( value_type( name, ref ) );
+  return std::make_pair( &result.first->second, result.second );
+}
+
+// moves the members into the tree, from now on every insert and erase is logarithmic
+void StructContents::make_tree()
+{
+  tree_.reset( new Tree );
+  for ( auto& member : flat_ )
+    tree_->insert( tree_->end(), std::move( member ) );
+  std::vector<value_type>().swap( flat_ );
+}
+
+BObjectRef& StructContents::operator[]( const std::string& name )
+{
+  return *emplace( name.c_str(), BObjectRef() ).first;
+}
+
+bool StructContents::insert( const char* name, const BObjectRef& ref )
+{
+  return emplace( name, ref ).second;
+}
+
+size_t StructContents::erase( const char* name )
+{
+  if ( tree_ )
+    return tree_->erase( value_type( name, BObjectRef() ) );
+  auto itr = lower_bound( name );
+  if ( itr == flat_.end() || stricmp( itr->first.c_str(), name ) != 0 )
+    return 0;
+  flat_.erase( itr );
+  return 1;
+}
+
 BStruct::BStruct() : BObjectImp( OTStruct ), contents_() {}
 
 BStruct::BStruct( BObjectType type ) : BObjectImp( type ), contents_() {}
 
 BStruct::BStruct( const BStruct& other, BObjectType type ) : BObjectImp( type ), contents_()
 {
+  contents_.reserve( other.contents_.size() );
   for ( const auto& elem : other.contents_ )
   {
     const std::string& key = elem.first;
@@ -43,6 +157,7 @@ BStruct::BStruct( const BStruct& other, BObjectType type ) : BObjectImp( type ),
 BStruct::BStruct( std::istream& is, unsigned size, BObjectType type )
     : BObjectImp( type ), contents_()
 {
+  contents_.reserve( size );
   for ( unsigned i = 0; i < size; ++i )
   {
     BObjectImp* keyimp = BObjectImp::unpack( is );
@@ -177,12 +292,12 @@ ContIterator* BStruct::createIterator( BObject* pIterVal )
 
 size_t BStruct::sizeEstimate() const
 {
-  size_t size = sizeof( BStruct );
+  size_t size = sizeof( BStruct ) - sizeof( StructContents ) + contents_.estimatedSize();
   for ( const auto& elem : contents_ )
   {
     const std::string& bkey = elem.first;
     const BObjectRef& bvalref = elem.second;
-    size += bkey.capacity() + bvalref.sizeEstimate() + ( sizeof( void* ) * 3 + 1 ) / 2;
+    size += bkey.capacity() + bvalref.sizeEstimate();
   }
   return size;
 }
@@ -195,9 +310,8 @@ size_t BStruct::mapcount() const
 
 BObjectRef BStruct::set_member( const char* membername, BObjectImp* value, bool copy )
 {
-  std::string key( membername );
   BObjectImp* target = copy ? value->copy() : value;
-  auto itr = contents_.find( key );
+  auto itr = contents_.find( membername );
   if ( itr != contents_.end() )
   {
     BObjectRef& oref = ( *itr ).second;
@@ -207,7 +321,7 @@ BObjectRef BStruct::set_member( const char* membername, BObjectImp* value, bool
   else
   {
     BObjectRef ref( new BObject( target ) );
-    contents_[key] = ref;
+    contents_[membername] = ref;
     return ref;
   }
 }
@@ -215,9 +329,7 @@ BObjectRef BStruct::set_member( const char* membername, BObjectImp* value, bool
 // used programmatically
 const BObjectImp* BStruct::FindMember( const char* name )
 {
-  std::string key( name );
-
-  auto itr = contents_.find( key );
+  auto itr = contents_.find( name );
   if ( itr != contents_.end() )
   {
     return ( *itr ).second->impptr();
@@ -230,9 +342,7 @@ const BObjectImp* BStruct::FindMember( const char* name )
 
 BObjectRef BStruct::get_member( const char* membername )
 {
-  std::string key( membername );
-
-  auto itr = contents_.find( key );
+  auto itr = contents_.find( membername );
   if ( itr != contents_.end() )
   {
     return ( *itr ).second;
@@ -436,30 +546,21 @@ std::string BStruct::getStringRep() const
 
 BObjectRef BStruct::operDotPlus( const char* name )
 {
-  std::string key( name );
-  if ( contents_.count( key ) == 0 )
-  {
-    auto pnewobj = new BObject( new UninitObject );
-    contents_[key] = BObjectRef( pnewobj );
-    return BObjectRef( pnewobj );
-  }
-  else
-  {
-    return BObjectRef( new BError( "Member already exists" ) );
-  }
+  BObjectRef ref( new BObject( new UninitObject ) );
+  if ( contents_.insert( name, ref ) )
+    return ref;
+  return BObjectRef( new BError( "Member already exists" ) );
 }
 
 BObjectRef BStruct::operDotMinus( const char* name )
 {
-  std::string key( name );
-  contents_.erase( key );
+  contents_.erase( name );
   return BObjectRef( new BLong( 1 ) );
 }
 
 BObjectRef BStruct::operDotQMark( const char* name )
 {
-  std::string key( name );
-  int count = static_cast<int>( contents_.count( key ) );
+  int count = static_cast<int>( contents_.count( name ) );
   return BObjectRef( new BLong( count ) );
 }
 
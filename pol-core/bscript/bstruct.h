@@ -14,10 +14,14 @@
 #endif
 
 #include <iosfwd>
-#include <map>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <stddef.h>
 #include <string>
+#include <utility>
+#include <vector>
 
-#include "../clib/maputil.h"
 #include "../clib/rawtypes.h"
 
 namespace Pol
@@ -33,6 +37,114 @@ namespace Pol
 {
 namespace Bscript
 {
+/**
+ * Members of a struct, sorted case insensitive by name like the map it replaced.
+ * Most structs have only a handful of members, up to MAX_FLAT_SIZE they are kept in a sorted
+ * vector with a single allocation. Scripts also use structs as string keyed maps with thousands
+ * of members, where every insert into the vector would shift the whole tail, so the members
+ * move into a tree once the vector is full and stay there.
+ * Inserting or erasing invalidates iterators, the member values are shared BObjectRefs and
+ * stay valid.
+ */
+class StructContents
+{
+public:
+  struct value_type
+  {
+    value_type( std::string name, BObjectRef ref ) : first( std::move( name ) ), second( ref ) {}
+    std::string first;
+    // the tree only hands out const members, the name is the key but the value may change
+    mutable BObjectRef second;
+  };
+
+private:
+  struct Less
+  {
+    bool operator()( const value_type& lhs, const value_type& rhs ) const;
+  };
+  typedef std::set<value_type, Less> Tree;
+
+public:
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef StructContents::value_type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+
+    const_iterator() : flat_(), tree_(), in_tree_( false ) {}
+    reference operator*() const { return in_tree_ ? *tree_ : *flat_; }
+    pointer operator->() const { return &**this; }
+    const_iterator& operator++()
+    {
+      if ( in_tree_ )
+        ++tree_;
+      else
+        ++flat_;
+      return *this;
+    }
+    const_iterator operator++( int )
+    {
+      const_iterator old( *this );
+      ++*this;
+      return old;
+    }
+    bool operator==( const const_iterator& other ) const
+    {
+      return in_tree_ ? tree_ == other.tree_ : flat_ == other.flat_;
+    }
+    bool operator!=( const const_iterator& other ) const { return !( *this == other ); }
+
+  private:
+    friend class StructContents;
+    typedef std::vector<value_type>::const_iterator FlatIterator;
+    typedef Tree::const_iterator TreeIterator;
+    explicit const_iterator( FlatIterator itr ) : flat_( itr ), tree_(), in_tree_( false ) {}
+    explicit const_iterator( TreeIterator itr ) : flat_(), tree_( itr ), in_tree_( true ) {}
+
+    FlatIterator flat_;
+    TreeIterator tree_;
+    bool in_tree_;
+  };
+  // the member values are reachable through const members
+  typedef const_iterator iterator;
+
+  StructContents();
+  StructContents( const StructContents& ) = delete;
+  StructContents& operator=( const StructContents& ) = delete;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  size_t size() const { return tree_ ? tree_->size() : flat_.size(); }
+  bool empty() const { return size() == 0; }
+  void reserve( size_t n );
+  // memory of the containers themselves, without the names and values
+  size_t estimatedSize() const;
+
+  const_iterator find( const char* name ) const;
+  const_iterator find( const std::string& name ) const { return find( name.c_str() ); }
+  size_t count( const char* name ) const { return find( name ) != end() ? 1 : 0; }
+  size_t count( const std::string& name ) const { return count( name.c_str() ); }
+  // existing member or a new one with an empty ref
+  BObjectRef& operator[]( const std::string& name );
+  // adds the member unless it already exists, returns false in that case
+  bool insert( const char* name, const BObjectRef& ref );
+  size_t erase( const char* name );
+  size_t erase( const std::string& name ) { return erase( name.c_str() ); }
+
+private:
+  std::vector<value_type>::const_iterator lower_bound( const char* name ) const;
+  std::pair<BObjectRef*, bool> emplace( const char* name, const BObjectRef& ref );
+  void make_tree();
+
+  static const size_t MAX_FLAT_SIZE = 8;
+
+  std::vector<value_type> flat_;
+  std::unique_ptr<Tree> tree_;  // nullptr while the members fit into flat_
+};
+
 class BStruct : public BObjectImp
 {
 public:
@@ -47,7 +159,7 @@ public:
 
   size_t mapcount() const;
 
-  typedef std::map<std::string, BObjectRef, Clib::ci_cmp_pred> Contents;
+  typedef StructContents Contents;
   const Contents& contents() const;
 
 protected:
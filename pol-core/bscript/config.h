@@ -13,6 +13,7 @@ namespace Bscript
 struct EScriptConfig
 {
   unsigned int max_call_depth;
+  bool disable_superinstructions;
 };
 
 extern EScriptConfig escript_config;
@@ -34,10 +34,16 @@ class FunctionalityModule;
 class Instruction
 {
 public:
-  Instruction( ExecInstrFunc f ) : token(), func( f ), cycles( 0 ) {}
-  Instruction() : token(), func( 0 ), cycles( 0 ) {}
+  Instruction( ExecInstrFunc f )
+      : token(), func( f ), superfunc( 0 ), superlength( 0 ), cycles( 0 )
+  {
+  }
+  Instruction() : token(), func( 0 ), superfunc( 0 ), superlength( 0 ), cycles( 0 ) {}
   Token token;
   ExecInstrFunc func;
+  // executes this and the following instructions in one step, see Executor::GetSuperInstrFunc
+  ExecInstrFunc superfunc;
+  unsigned int superlength;  // number of instructions superfunc executes
   mutable unsigned int cycles;
 };
 
@@ -11,6 +11,7 @@
 #include "../clib/logfacility.h"
 #include "../clib/rawtypes.h"
 #include "../clib/strutil.h"
+#include "config.h"
 #include "eprog.h"
 #include "executor.h"
 #include "filefmt.h"
@@ -154,6 +155,14 @@ int EScriptProgram::create_instructions()
     // executor only:
     ins.func = Executor::GetInstrFunc( ins.token );
   }
+  if ( !escript_config.disable_superinstructions )
+  {
+    // the single instructions stay untouched, jumps into a fused sequence and the debugger
+    // still execute them one by one
+    for ( int i = 0; i < nLines; i++ )
+      instr[i].superfunc =
+          Executor::GetSuperInstrFunc( &instr[i], nLines - i, instr[i].superlength );
+  }
   return 0;
 }
 
@@ -1662,6 +1662,49 @@ void Executor::ins_array_assign_consume( const Instruction& /*ins*/ )
   ValueStack.pop_back();
 }
 
+namespace
+{
+// An operand which is referenced only by the ValueStack (a constant or an intermediate result)
+// gets overwritten with the result of the operator, so long and double operators don't allocate.
+template <class T>
+T* stack_temporary( BObjectRef& ref, BObjectImp::BObjectType type )
+{
+  BObjectImp* imp = ref->impptr();
+  if ( ref->count() == 1 && imp->count() == 1 && imp->isa( type ) )
+    return static_cast<T*>( imp );
+  return nullptr;
+}
+
+template <class T, class V>
+void set_result( BObjectRef& leftref, BObjectRef& rightref, BObjectImp::BObjectType type,
+                 V value )
+{
+  if ( T* imp = stack_temporary<T>( leftref, type ) )
+  {
+    imp->setvalue( value );
+  }
+  else if ( T* imp = stack_temporary<T>( rightref, type ) )
+  {
+    imp->setvalue( value );
+    leftref = rightref;
+  }
+  else
+  {
+    leftref.set( new BObject( new T( value ) ) );
+  }
+}
+
+void set_long_result( BObjectRef& leftref, BObjectRef& rightref, int value )
+{
+  set_result<BLong>( leftref, rightref, BObjectImp::OTLong, value );
+}
+
+void set_double_result( BObjectRef& leftref, BObjectRef& rightref, double value )
+{
+  set_result<Double>( leftref, rightref, BObjectImp::OTDouble, value );
+}
+}  // namespace
+
 // TOK_ADD:
 void Executor::ins_add( const Instruction& /*ins*/ )
 {
@@ -1677,6 +1720,20 @@ void Executor::ins_add( const Instruction& /*ins*/ )
   BObject& right = *rightref;
   BObject& left = *leftref;
 
+  if ( left.isa( BObjectImp::OTLong ) && right.isa( BObjectImp::OTLong ) )
+  {
+    set_long_result( leftref, rightref,
+                     static_cast<BLong&>( left.impref() ).value() +
+                         static_cast<BLong&>( right.impref() ).value() );
+    return;
+  }
+  if ( left.isa( BObjectImp::OTDouble ) && right.isa( BObjectImp::OTDouble ) )
+  {
+    set_double_result( leftref, rightref,
+                       static_cast<Double&>( left.impref() ).value() +
+                           static_cast<Double&>( right.impref() ).value() );
+    return;
+  }
   leftref.set( new BObject( right.impref().selfPlusObjImp( left.impref() ) ) );
 }
 
@@ -1695,6 +1752,20 @@ void Executor::ins_subtract( const Instruction& /*ins*/ )
   BObject& right = *rightref;
   BObject& left = *leftref;
 
+  if ( left.isa( BObjectImp::OTLong ) && right.isa( BObjectImp::OTLong ) )
+  {
+    set_long_result( leftref, rightref,
+                     static_cast<BLong&>( left.impref() ).value() -
+                         static_cast<BLong&>( right.impref() ).value() );
+    return;
+  }
+  if ( left.isa( BObjectImp::OTDouble ) && right.isa( BObjectImp::OTDouble ) )
+  {
+    set_double_result( leftref, rightref,
+                       static_cast<Double&>( left.impref() ).value() -
+                           static_cast<Double&>( right.impref() ).value() );
+    return;
+  }
   leftref.set( new BObject( right.impref().selfMinusObjImp( left.impref() ) ) );
 }
 
@@ -1713,6 +1784,20 @@ void Executor::ins_mult( const Instruction& /*ins*/ )
   BObject& right = *rightref;
   BObject& left = *leftref;
 
+  if ( left.isa( BObjectImp::OTLong ) && right.isa( BObjectImp::OTLong ) )
+  {
+    set_long_result( leftref, rightref,
+                     static_cast<BLong&>( left.impref() ).value() *
+                         static_cast<BLong&>( right.impref() ).value() );
+    return;
+  }
+  if ( left.isa( BObjectImp::OTDouble ) && right.isa( BObjectImp::OTDouble ) )
+  {
+    set_double_result( leftref, rightref,
+                       static_cast<Double&>( left.impref() ).value() *
+                           static_cast<Double&>( right.impref() ).value() );
+    return;
+  }
   leftref.set( new BObject( right.impref().selfTimesObjImp( left.impref() ) ) );
 }
 // TOK_DIV:
@@ -1850,7 +1935,7 @@ void Executor::ins_logical_and( const Instruction& /*ins*/ )
   BObject& left = *leftref;
 
   int _true = ( left.isTrue() && right.isTrue() );
-  leftref.set( new BObject( new BLong( _true ) ) );
+  set_long_result( leftref, rightref, _true );
 }
 void Executor::ins_logical_or( const Instruction& /*ins*/ )
 {
@@ -1867,7 +1952,7 @@ void Executor::ins_logical_or( const Instruction& /*ins*/ )
   BObject& left = *leftref;
 
   int _true = ( left.isTrue() || right.isTrue() );
-  leftref.set( new BObject( new BLong( _true ) ) );
+  set_long_result( leftref, rightref, _true );
 }
 
 void Executor::ins_notequal( const Instruction& /*ins*/ )
@@ -1885,7 +1970,7 @@ void Executor::ins_notequal( const Instruction& /*ins*/ )
   BObject& left = *leftref;
 
   int _true = ( left != right );
-  leftref.set( new BObject( new BLong( _true ) ) );
+  set_long_result( leftref, rightref, _true );
 }
 
 void Executor::ins_equal( const Instruction& /*ins*/ )
@@ -1903,7 +1988,7 @@ void Executor::ins_equal( const Instruction& /*ins*/ )
   BObject& left = *leftref;
 
   int _true = ( left == right );
-  leftref.set( new BObject( new BLong( _true ) ) );
+  set_long_result( leftref, rightref, _true );
 }
 
 void Executor::ins_lessthan( const Instruction& /*ins*/ )
@@ -1921,7 +2006,7 @@ void Executor::ins_lessthan( const Instruction& /*ins*/ )
   BObject& left = *leftref;
 
   int _true = ( left < right );
-  leftref.set( new BObject( new BLong( _true ) ) );
+  set_long_result( leftref, rightref, _true );
 }
 
 void Executor::ins_lessequal( const Instruction& /*ins*/ )
@@ -1938,7 +2023,7 @@ void Executor::ins_lessequal( const Instruction& /*ins*/ )
   BObject& right = *rightref;
   BObject& left = *leftref;
   int _true = ( left <= right );
-  leftref.set( new BObject( new BLong( _true ) ) );
+  set_long_result( leftref, rightref, _true );
 }
 void Executor::ins_greaterthan( const Instruction& /*ins*/ )
 {
@@ -1955,7 +2040,7 @@ void Executor::ins_greaterthan( const Instruction& /*ins*/ )
   BObject& left = *leftref;
 
   int _true = ( left > right );
-  leftref.set( new BObject( new BLong( _true ) ) );
+  set_long_result( leftref, rightref, _true );
 }
 void Executor::ins_greaterequal( const Instruction& /*ins*/ )
 {
@@ -1972,7 +2057,7 @@ void Executor::ins_greaterequal( const Instruction& /*ins*/ )
   BObject& left = *leftref;
 
   int _true = ( left >= right );
-  leftref.set( new BObject( new BLong( _true ) ) );
+  set_long_result( leftref, rightref, _true );
 }
 
 // case TOK_ARRAY_SUBSCRIPT:
@@ -2679,6 +2764,77 @@ void Executor::ins_funcref( const Instruction& ins )
 
 void Executor::ins_nop( const Instruction& /*ins*/ ) {}
 
+namespace
+{
+template <BTokenId Op>
+inline bool compare_long( int left, int right )
+{
+  switch ( Op )
+  {
+  case TOK_LESSTHAN:
+    return left < right;
+  case TOK_LESSEQ:
+    return left <= right;
+  case TOK_GRTHAN:
+    return left > right;
+  case TOK_GREQ:
+    return left >= right;
+  case TOK_EQUAL:
+    return left == right;
+  default:
+    return left != right;
+  }
+}
+}  // namespace
+
+// local/global #n, long, compare, if false goto
+// PC points already to the second instruction of the sequence
+template <bool Global, BTokenId Op>
+void Executor::ins_super_var_long_compare_jmpiffalse( const Instruction& ins )
+{
+  const Instruction* seq = &ins;
+  BObjectImp* left = ( Global ? Globals2[ins.token.lval] : ( *Locals2 )[ins.token.lval] )->impptr();
+  if ( left->isa( BObjectImp::OTLong ) )
+  {
+    if ( compare_long<Op>( static_cast<BLong*>( left )->value(), seq[1].token.lval ) )
+      PC += 3;
+    else
+      PC = (unsigned)seq[3].token.lval;
+    return;
+  }
+  // other types keep the generic comparison
+  ( this->*( seq[0].func ) )( seq[0] );
+  ins_long( seq[1] );
+  ( this->*( seq[2].func ) )( seq[2] );
+  PC += 3;
+  ins_jmpiffalse( seq[3] );
+}
+
+// local/global #n, get member id, assign local/global
+// without pushing the object and the member onto the ValueStack
+template <bool GlobalSrc, bool GlobalDst>
+void Executor::ins_super_var_get_member_id_assign( const Instruction& ins )
+{
+  const Instruction* seq = &ins;
+  BObject& left = *( GlobalSrc ? Globals2[ins.token.lval] : ( *Locals2 )[ins.token.lval] );
+  BObjectRef rightref = left->get_member_id( seq[1].token.lval );
+  BObjectRef& var = GlobalDst ? Globals2[seq[2].token.lval] : ( *Locals2 )[seq[2].token.lval];
+
+  BObject& right = *rightref;
+
+  BObjectImp& rightimpref = right.impref();
+
+  if ( right.count() == 1 && rightimpref.count() == 1 )
+  {
+    var->setimp( &rightimpref );
+  }
+  else
+  {
+    var->setimp( rightimpref.copy() );
+  }
+  PC += 2;
+}
+
 ExecInstrFunc Executor::GetInstrFunc( const Token& token )
 {
   switch ( token.id )
@@ -2898,7 +3054,61 @@ ExecInstrFunc Executor::GetInstrFunc( const Token& token )
   }
 }
 
-void Executor::execInstr()
+namespace
+{
+template <BTokenId Op>
+ExecInstrFunc super_compare_jmpiffalse( bool global )
+{
+  return global ? &Executor::ins_super_var_long_compare_jmpiffalse<true, Op>
+                : &Executor::ins_super_var_long_compare_jmpiffalse<false, Op>;
+}
+}  // namespace
+
+ExecInstrFunc Executor::GetSuperInstrFunc( const Instruction* ins, size_t count,
+                                           unsigned int& length )
+{
+  if ( ins[0].token.id != TOK_LOCALVAR && ins[0].token.id != TOK_GLOBALVAR )
+    return nullptr;
+  const bool global = ins[0].token.id == TOK_GLOBALVAR;
+
+  if ( count >= 4 && ins[1].token.id == TOK_LONG && ins[3].token.id == RSV_JMPIFFALSE )
+  {
+    length = 4;
+    switch ( ins[2].token.id )
+    {
+    case TOK_LESSTHAN:
+      return super_compare_jmpiffalse<TOK_LESSTHAN>( global );
+    case TOK_LESSEQ:
+      return super_compare_jmpiffalse<TOK_LESSEQ>( global );
+    case TOK_GRTHAN:
+      return super_compare_jmpiffalse<TOK_GRTHAN>( global );
+    case TOK_GREQ:
+      return super_compare_jmpiffalse<TOK_GREQ>( global );
+    case TOK_EQUAL:
+      return super_compare_jmpiffalse<TOK_EQUAL>( global );
+    case TOK_NEQ:
+      return super_compare_jmpiffalse<TOK_NEQ>( global );
+    default:
+      break;
+    }
+  }
+#ifndef ESCRIPT_PROFILE
+  if ( count >= 3 && ins[1].token.id == INS_GET_MEMBER_ID )
+  {
+    length = 3;
+    if ( ins[2].token.id == INS_ASSIGN_LOCALVAR )
+      return global ? &Executor::ins_super_var_get_member_id_assign<true, false>
+                    : &Executor::ins_super_var_get_member_id_assign<false, false>;
+    if ( ins[2].token.id == INS_ASSIGN_GLOBALVAR )
+      return global ? &Executor::ins_super_var_get_member_id_assign<true, true>
+                    : &Executor::ins_super_var_get_member_id_assign<false, true>;
+  }
+#endif
+  length = 0;
+  return nullptr;
+}
+
+unsigned int Executor::execInstr()
 {
   unsigned onPC = PC;
   try
@@ -2922,7 +3132,7 @@ void Executor::execInstr()
       {
         debug_state_ = DEBUG_STATE_ATTACHED;
         sethalt( true );
-        return;
+        return 1;
       }
       else if ( debug_state_ == DEBUG_STATE_INS_TRACE )
       {
@@ -2969,7 +3179,7 @@ void Executor::execInstr()
       {
         debug_state_ = DEBUG_STATE_ATTACHED;
         sethalt( true );
-        return;
+        return 1;
       }
 
       // check for breakpoints on this instruction
@@ -2980,17 +3190,29 @@ void Executor::execInstr()
         bp_skip_ = PC;
         debug_state_ = DEBUG_STATE_ATTACHED;
         sethalt( true );
-        return;
+        return 1;
       }
       bp_skip_ = ~0u;
     }
 
+    ++PC;
+
+    // the debugger needs to see every single instruction
+    if ( ins.superfunc != nullptr && !debugging_ && debug_level < INSTRUCTIONS )
+    {
+      // a fused sequence counts as the instructions it replaces, for the profile as well as for
+      // the runaway and time slice limits of the scheduler
+      const unsigned int length = ins.superlength;
+      for ( unsigned int i = 0; i < length; ++i )
+        ++( &ins )[i].cycles;
+      prog_->instr_cycles += length;
+      escript_instr_cycles += length;
+      ( this->*( ins.superfunc ) )( ins );
+      return length;
+    }
     ++ins.cycles;
     ++prog_->instr_cycles;
     ++escript_instr_cycles;
-
-    ++PC;
-
     ( this->*( ins.func ) )( ins );
   }
   catch ( std::exception& ex )
@@ -3022,6 +3244,7 @@ void Executor::execInstr()
     show_context( onPC );
   }
 #endif
+  return 1;
 }
 
 std::string Executor::dbg_get_instruction( size_t atPC ) const
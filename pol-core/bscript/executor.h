@@ -120,6 +120,9 @@ public:
   ValueStackCont ValueStack;
 
   static ExecInstrFunc GetInstrFunc( const Token& token );
+  // fused handler for the instruction sequence starting at ins, nullptr if there is none
+  static ExecInstrFunc GetSuperInstrFunc( const Instruction* ins, size_t count,
+                                         unsigned int& length );
 
   /*
       These must both be deleted.  instr references _symbols, so it should be deleted first.
@@ -220,7 +223,8 @@ public:
   ModuleFunction* current_module_function;
   // NOTE: the debugger code expects these to be virtual..
   void execFunc( const Token& token );
-  void execInstr();
+  // returns the number of instructions it counted, more than one for a fused sequence
+  unsigned int execInstr();
 
   void ins_nop( const Instruction& ins );
   void ins_jmpiftrue( const Instruction& ins );
@@ -341,6 +345,14 @@ public:
 
   void ins_funcref( const Instruction& ins );
 
+  // superinstructions
+  // local/global, long, compare, if false goto
+  template <bool Global, BTokenId Op>
+  void ins_super_var_long_compare_jmpiffalse( const Instruction& ins );
+  // local/global, get member id, assign local/global
+  template <bool GlobalSrc, bool GlobalDst>
+  void ins_super_var_get_member_id_assign( const Instruction& ins );
+
   static int ins_casejmp_findlong( const Token& token, BLong* blong );
   static int ins_casejmp_findstring( const Token& token, String* bstringimp );
   static int ins_casejmp_finddefault( const Token& token );
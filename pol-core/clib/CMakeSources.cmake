@@ -11,6 +11,8 @@ set (clib_sources
   Program/ProgramMain.cpp
   Program/ProgramMain.h
   StdAfx.h
+  binarycfg.cpp
+  binarycfg.h
   binaryfile.cpp 
   binaryfile.h
   bitutil.h
@@ -48,6 +50,8 @@ set (clib_sources
   logfacility.cpp
   logfacility.h
   make_unique.hpp
+  mappedfile.cpp
+  mappedfile.h
   maputil.h
   message_queue.h
   mlog.cpp 
@@ -0,0 +1,674 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#include "binarycfg.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "cfgelem.h"
+#include "logfacility.h"
+#include "stlutil.h"
+#include "strutil.h"
+#include <format/format.h>
+
+namespace Pol
+{
+namespace Clib
+{
+namespace
+{
+const char MAGIC[] = "POLBCFG";  // including the terminating 0
+const unsigned char VERSION = 2;  // 2 added VAL_HEX_UPPER
+const size_t HEADER_SIZE = sizeof MAGIC + 1;
+
+enum RecordKind : unsigned char
+{
+  REC_NAME = 1,
+  REC_ELEM = 2
+};
+
+enum ValueTag : unsigned char
+{
+  VAL_STRING = 0,
+  VAL_DECIMAL = 1,  // zigzag varint
+  VAL_HEX = 2,      // varint, printed as 0x<lowercase digits>
+  VAL_CPROP_INT = 3,
+  VAL_CPROP_STRING = 4,
+  VAL_CPROP_PACKED = 5,
+  VAL_HEX_UPPER = 6  // varint, printed as 0x<uppercase digits>
+};
+
+void put_varint( std::string& out, u64 value )
+{
+  while ( value >= 0x80 )
+  {
+    out += static_cast<char>( ( value & 0x7F ) | 0x80 );
+    value >>= 7;
+  }
+  out += static_cast<char>( value );
+}
+
+void put_string( std::string& out, const char* str, size_t len )
+{
+  put_varint( out, len );
+  out.append( str, len );
+}
+
+u64 zigzag( s64 value )
+{
+  return ( static_cast<u64>( value ) << 1 ) ^ static_cast<u64>( value >> 63 );
+}
+
+s64 unzigzag( u64 value )
+{
+  return static_cast<s64>( value >> 1 ) ^ -static_cast<s64>( value & 1 );
+}
+
+// only numbers which print back to the same text are stored as numbers
+bool parse_decimal( const char* str, size_t len, s64& value )
+{
+  size_t i = 0;
+  bool negative = len > 0 && str[0] == '-';
+  if ( negative )
+    ++i;
+  size_t digits = len - i;
+  if ( digits == 0 || digits > 18 || ( str[i] == '0' && ( digits > 1 || negative ) ) )
+    return false;
+  s64 result = 0;
+  for ( ; i < len; ++i )
+  {
+    if ( str[i] < '0' || str[i] > '9' )
+      return false;
+    result = result * 10 + ( str[i] - '0' );
+  }
+  value = negative ? -result : result;
+  return true;
+}
+
+// digits only count as lowercase
+bool parse_hex( const char* str, size_t len, u64& value, bool& upper )
+{
+  if ( len < 3 || len > 2 + 15 || str[0] != '0' || str[1] != 'x' || ( str[2] == '0' && len > 3 ) )
+    return false;
+  u64 result = 0;
+  bool has_lower = false;
+  bool has_upper = false;
+  for ( size_t i = 2; i < len; ++i )
+  {
+    char c = str[i];
+    if ( c >= '0' && c <= '9' )
+      result = ( result << 4 ) | static_cast<u64>( c - '0' );
+    else if ( c >= 'a' && c <= 'f' )
+    {
+      result = ( result << 4 ) | static_cast<u64>( c - 'a' + 10 );
+      has_lower = true;
+    }
+    else if ( c >= 'A' && c <= 'F' )
+    {
+      result = ( result << 4 ) | static_cast<u64>( c - 'A' + 10 );
+      has_upper = true;
+    }
+    else
+      return false;
+  }
+  if ( has_lower && has_upper )
+    return false;  // would not print back identically
+  value = result;
+  upper = has_upper;
+  return true;
+}
+
+void append_decimal( std::string& out, s64 value )
+{
+  char buf[24];
+  char* p = buf + sizeof buf;
+  u64 abs = value < 0 ? 0 - static_cast<u64>( value ) : static_cast<u64>( value );
+  do
+  {
+    *--p = static_cast<char>( '0' + abs % 10 );
+    abs /= 10;
+  } while ( abs );
+  if ( value < 0 )
+    *--p = '-';
+  out.append( p, buf + sizeof buf - p );
+}
+
+void append_hex( std::string& out, u64 value, bool upper )
+{
+  static const char lower_digits[] = "0123456789abcdef";
+  static const char upper_digits[] = "0123456789ABCDEF";
+  const char* digits = upper ? upper_digits : lower_digits;
+  char buf[20];
+  char* p = buf + sizeof buf;
+  do
+  {
+    *--p = digits[value & 0xF];
+    value >>= 4;
+  } while ( value );
+  out += "0x";
+  out.append( p, buf + sizeof buf - p );
+}
+
+bool is_space( char c )
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// values which splitnamevalue would trim or decodequotedstring would change need quotes
+bool needs_quotes( const std::string& value )
+{
+  static const char* whitespace = " \t\r\n";
+  if ( value.empty() )
+    return false;
+  return value[0] == '\"' || strchr( whitespace, value[0] ) != nullptr ||
+         strchr( whitespace, value.back() ) != nullptr || value.find( '\n' ) != std::string::npos;
+}
+
+class Decoder
+{
+public:
+  Decoder( const char* pos, const char* end ) : _pos( pos ), _end( end ) {}
+
+  bool empty() const { return _pos == _end; }
+  const char* pos() const { return _pos; }
+
+  unsigned char byte()
+  {
+    if ( _pos == _end )
+      throw std::runtime_error( "Unexpected end of record" );
+    return static_cast<unsigned char>( *_pos++ );
+  }
+
+  u64 varint()
+  {
+    u64 value = 0;
+    for ( unsigned int shift = 0; shift < 64; shift += 7 )
+    {
+      unsigned char b = byte();
+      value |= static_cast<u64>( b & 0x7F ) << shift;
+      if ( ( b & 0x80 ) == 0 )
+        return value;
+    }
+    throw std::runtime_error( "Invalid varint" );
+  }
+
+  void string( std::string& out )
+  {
+    u64 len = varint();
+    if ( len > static_cast<u64>( _end - _pos ) )
+      throw std::runtime_error( "String exceeds record" );
+    out.assign( _pos, static_cast<size_t>( len ) );
+    _pos += len;
+  }
+
+  void append_string( std::string& out )
+  {
+    u64 len = varint();
+    if ( len > static_cast<u64>( _end - _pos ) )
+      throw std::runtime_error( "String exceeds record" );
+    out.append( _pos, static_cast<size_t>( len ) );
+    _pos += len;
+  }
+
+private:
+  const char* _pos;
+  const char* _end;
+};
+}  // namespace
+
+BinaryConfigWriter::BinaryConfigWriter()
+    : _names(),
+      _data( MAGIC, sizeof MAGIC ),
+      _record(),
+      _props(),
+      _prop_count( 0 ),
+      _name(),
+      _text_carry(),
+      _text_line_buf(),
+      _text_value(),
+      _text_state( TEXT_OUTSIDE ),
+      _text_line( 0 ),
+      _element_line( 0 )
+{
+  _data += static_cast<char>( VERSION );
+}
+
+std::string& BinaryConfigWriter::data()
+{
+  return _data;
+}
+
+unsigned int BinaryConfigWriter::intern( const std::string& name )
+{
+  auto itr = _names.find( name );
+  if ( itr != _names.end() )
+    return itr->second;
+  unsigned int id = static_cast<unsigned int>( _names.size() );
+  _names.emplace( name, id );
+  put_varint( _data, name.size() + 1 );
+  _data += static_cast<char>( REC_NAME );
+  _data += name;
+  return id;
+}
+
+unsigned int BinaryConfigWriter::intern( const char* name, size_t len )
+{
+  _name.assign( name, len );
+  return intern( _name );
+}
+
+void BinaryConfigWriter::put_value( std::string& out, bool cprop, const char* value, size_t len )
+{
+  s64 decimal;
+  u64 hex;
+  bool upper;
+  if ( parse_decimal( value, len, decimal ) )
+  {
+    out += static_cast<char>( VAL_DECIMAL );
+    put_varint( out, zigzag( decimal ) );
+    return;
+  }
+  if ( parse_hex( value, len, hex, upper ) )
+  {
+    out += static_cast<char>( upper ? VAL_HEX_UPPER : VAL_HEX );
+    put_varint( out, hex );
+    return;
+  }
+  if ( cprop )
+  {
+    // "<name> <packed>", see PropertyList::printProperties
+    size_t sep = 0;
+    while ( sep < len && !is_space( value[sep] ) )
+      ++sep;
+    if ( sep < len && sep > 0 && value[sep] == ' ' && sep + 1 < len )
+    {
+      unsigned int id = intern( value, sep );
+      const char* packed = value + sep + 1;
+      size_t packed_len = len - sep - 1;
+      if ( packed[0] == 'i' && parse_decimal( packed + 1, packed_len - 1, decimal ) )
+      {
+        out += static_cast<char>( VAL_CPROP_INT );
+        put_varint( out, id );
+        put_varint( out, zigzag( decimal ) );
+      }
+      else if ( packed[0] == 's' )
+      {
+        out += static_cast<char>( VAL_CPROP_STRING );
+        put_varint( out, id );
+        put_string( out, packed + 1, packed_len - 1 );
+      }
+      else
+      {
+        // reals would need the exact ostream formatting to print back, containers nest
+        // strings, they keep their packed text
+        out += static_cast<char>( VAL_CPROP_PACKED );
+        put_varint( out, id );
+        put_string( out, packed, packed_len );
+      }
+      return;
+    }
+  }
+  out += static_cast<char>( VAL_STRING );
+  put_string( out, value, len );
+}
+
+void BinaryConfigWriter::put_element( const std::string& props, u64 count )
+{
+  // _record holds type and rest, names were already defined by intern
+  put_varint( _record, count );
+  put_varint( _data, _record.size() + props.size() + 1 );
+  _data += static_cast<char>( REC_ELEM );
+  _data += _record;
+  _data += props;
+}
+
+void BinaryConfigWriter::write( const ConfigElem& elem )
+{
+  _record.clear();
+  put_varint( _record, intern( elem.type_ ) );
+  put_string( _record, elem.rest_.c_str(), elem.rest_.size() );
+  _props.clear();
+  for ( const auto& prop : elem.properties )
+  {
+    put_varint( _props, intern( prop.first ) );
+    put_value( _props, stricmp( prop.first.c_str(), "CProp" ) == 0, prop.second.c_str(),
+               prop.second.size() );
+  }
+  put_element( _props, elem.properties.size() );
+}
+
+void BinaryConfigWriter::write_text( const char* text, size_t len, const std::string& filename )
+{
+  const char* end = text + len;
+  const char* line = text;
+  if ( !_text_carry.empty() )
+  {
+    const char* nl = static_cast<const char*>( memchr( text, '\n', len ) );
+    if ( nl == nullptr )
+    {
+      _text_carry.append( text, len );
+      return;
+    }
+    _text_carry.append( text, nl );
+    std::string carry;
+    carry.swap( _text_carry );
+    text_line( carry.data(), carry.data() + carry.size(), filename );
+    line = nl + 1;
+  }
+  for ( ;; )
+  {
+    const char* nl = static_cast<const char*>( memchr( line, '\n', end - line ) );
+    if ( nl == nullptr )
+      break;
+    text_line( line, nl, filename );
+    line = nl + 1;
+  }
+  _text_carry.assign( line, end );
+}
+
+void BinaryConfigWriter::finish_text( const std::string& filename )
+{
+  if ( !_text_carry.empty() )
+  {
+    std::string carry;
+    carry.swap( _text_carry );
+    text_line( carry.data(), carry.data() + carry.size(), filename );
+  }
+  if ( _text_state == TEXT_OPEN )
+    text_error( "File ends after element type -- expected a '{'", filename );
+  if ( _text_state == TEXT_PROPERTIES )
+    text_error( "Expected '}' on a blank line after element properties", filename );
+}
+
+// same rules as ConfigFile::_read and read_properties, without building a ConfigElem
+void BinaryConfigWriter::text_line( const char* begin, const char* end,
+                                    const std::string& filename )
+{
+  if ( begin != end && end[-1] == '\r' )
+    --end;
+  if ( _text_line++ == 0 && end - begin >= 3 && memcmp( begin, "\xEF\xBB\xBF", 3 ) == 0 )
+    begin += 3;
+  if ( std::any_of( begin, end, []( char c ) { return ( c & 0x80 ) != 0; } ) )
+  {
+    _text_line_buf.assign( begin, end );
+    sanitizeUnicodeWithIso( &_text_line_buf );
+    begin = _text_line_buf.data();
+    end = begin + _text_line_buf.size();
+  }
+
+  if ( _text_state == TEXT_OPEN )
+  {
+    if ( begin == end || *begin != '{' )
+      text_error( "Expected '{' on a blank line after element type", filename );
+    _text_state = TEXT_PROPERTIES;
+    return;
+  }
+
+  // splitnamevalue
+  const char* name = begin;
+  while ( name != end && is_space( *name ) )
+    ++name;
+  if ( name == end || *name == '#' || ( end - name >= 2 && name[0] == '/' && name[1] == '/' ) )
+    return;  // empty or comment line
+  const char* name_end = name + 1;
+  while ( name_end != end && !is_space( *name_end ) && *name_end != '=' )
+    ++name_end;
+  const char* value = name_end == end ? end : name_end + 1;
+  while ( value != end && is_space( *value ) )
+    ++value;
+  const char* value_end = end;
+  while ( value_end != value && is_space( value_end[-1] ) )
+    --value_end;
+  size_t name_len = static_cast<size_t>( name_end - name );
+
+  if ( _text_state == TEXT_OUTSIDE )
+  {
+    _element_line = _text_line;
+    _record.clear();
+    put_varint( _record, intern( name, name_len ) );
+    put_string( _record, value, static_cast<size_t>( value_end - value ) );
+    _props.clear();
+    _prop_count = 0;
+    _text_state = TEXT_OPEN;
+    return;
+  }
+
+  if ( name_len == 1 && *name == '}' )
+  {
+    put_element( _props, _prop_count );
+    _text_state = TEXT_OUTSIDE;
+    return;
+  }
+  bool cprop = name_len == 5 && strnicmp( name, "CProp", 5 ) == 0;
+  put_varint( _props, intern( name, name_len ) );
+  if ( value != value_end && *value == '\"' )
+  {
+    _text_value.assign( value, value_end );
+    decodequotedstring( _text_value );
+    put_value( _props, cprop, _text_value.data(), _text_value.size() );
+  }
+  else
+    put_value( _props, cprop, value, static_cast<size_t>( value_end - value ) );
+  ++_prop_count;
+}
+
+void BinaryConfigWriter::text_error( const std::string& msg, const std::string& filename ) const
+{
+  ERROR_PRINT << "Error writing binary data file " << filename << ":\n"
+              << "\t" << msg << "\n"
+              << "\tElement started on line: " << _element_line << ", near line: " << _text_line
+              << "\n";
+  throw std::runtime_error( msg );
+}
+
+BinaryConfigFile::BinaryConfigFile( const std::string& filename, const char* allowed_types )
+    : _file(), _pos( nullptr ), _end( nullptr ), _element_start( 0 ), _names(), _allowed_types()
+{
+  _file.open( filename );
+  _pos = _file.data();
+  _end = _pos + _file.size();
+  if ( _file.size() < HEADER_SIZE || memcmp( _pos, MAGIC, sizeof MAGIC ) != 0 )
+    throw std::runtime_error( "BinaryConfigFile: " + filename + " is not a binary data file" );
+  if ( static_cast<unsigned char>( _pos[sizeof MAGIC] ) > VERSION )
+    throw std::runtime_error( "BinaryConfigFile: " + filename + " has an unknown version" );
+  _pos += HEADER_SIZE;
+
+  if ( allowed_types != nullptr )
+  {
+    ISTRINGSTREAM is( allowed_types );
+    std::string tag;
+    while ( is >> tag )
+      _allowed_types.insert( tag );
+  }
+}
+
+bool BinaryConfigFile::is_binary( const std::string& filename )
+{
+  std::ifstream ifs( filename, std::ios::in | std::ios::binary );
+  char buf[sizeof MAGIC];
+  if ( !ifs.read( buf, sizeof buf ) )
+    return false;
+  return memcmp( buf, MAGIC, sizeof MAGIC ) == 0;
+}
+
+const std::string& BinaryConfigFile::filename() const
+{
+  return _file.filename();
+}
+
+bool BinaryConfigFile::read( ConfigElem& elem )
+{
+  try
+  {
+    elem._source = this;
+    return _read( elem );
+  }
+  catch ( std::exception& ex )
+  {
+    display_error( ex.what(), false, &elem );
+    throw;
+  }
+}
+
+bool BinaryConfigFile::_read( ConfigElem& elem )
+{
+  elem.properties.clear();
+  elem.type_.clear();
+  elem.rest_.clear();
+
+  while ( _pos != _end )
+  {
+    _element_start = static_cast<size_t>( _pos - _file.data() );
+    Decoder header( _pos, _end );
+    u64 len = header.varint();
+    if ( len == 0 || len > static_cast<u64>( _end - header.pos() ) )
+      throw std::runtime_error( "Record exceeds the file" );
+    Decoder rec( header.pos(), header.pos() + len );
+    _pos = header.pos() + len;
+
+    unsigned char kind = rec.byte();
+    if ( kind == REC_NAME )
+    {
+      _names.emplace_back( rec.pos(), static_cast<size_t>( len - 1 ) );
+      continue;
+    }
+    if ( kind != REC_ELEM )
+      continue;
+
+    auto name = [this]( u64 id ) -> const std::string& {
+      if ( id >= _names.size() )
+        throw std::runtime_error( "Undefined name id" );
+      return _names[static_cast<size_t>( id )];
+    };
+
+    elem.type_ = name( rec.varint() );
+    if ( !_allowed_types.empty() && _allowed_types.find( elem.type_ ) == _allowed_types.end() )
+      throw std::runtime_error( "Unexpected type '" + elem.type_ + "'" );
+    rec.string( elem.rest_ );
+
+    u64 count = rec.varint();
+    std::string value;
+    for ( u64 i = 0; i < count; ++i )
+    {
+      const std::string& propname = name( rec.varint() );
+      value.clear();
+      switch ( rec.byte() )
+      {
+      case VAL_STRING:
+        rec.string( value );
+        break;
+      case VAL_DECIMAL:
+        append_decimal( value, unzigzag( rec.varint() ) );
+        break;
+      case VAL_HEX:
+        append_hex( value, rec.varint(), false );
+        break;
+      case VAL_HEX_UPPER:
+        append_hex( value, rec.varint(), true );
+        break;
+      case VAL_CPROP_INT:
+        value = name( rec.varint() );
+        value += " i";
+        append_decimal( value, unzigzag( rec.varint() ) );
+        break;
+      case VAL_CPROP_STRING:
+        value = name( rec.varint() );
+        value += " s";
+        rec.append_string( value );
+        break;
+      case VAL_CPROP_PACKED:
+        value = name( rec.varint() );
+        value += ' ';
+        rec.append_string( value );
+        break;
+      default:
+        throw std::runtime_error( "Unknown value type" );
+      }
+      // like emplace, equal names keep their order
+      elem.properties.emplace_hint( elem.properties.end(), propname, value );
+    }
+    return true;
+  }
+  return false;
+}
+
+void BinaryConfigFile::display_error( const std::string& msg, bool /*show_curline*/,
+                                      const ConfigElemBase* elem, bool error ) const
+{
+  fmt::Writer tmp;
+  tmp << ( error ? "Error" : "Warning" ) << " reading binary data file " << _file.filename()
+      << ":\n"
+      << "\t" << msg << "\n";
+  if ( elem != nullptr && strlen( elem->type() ) > 0 )
+    tmp << "\tElement: " << elem->type() << " " << elem->rest() << ", ";
+  else
+    tmp << "\t";
+  tmp << "record at offset " << _element_start << "\n";
+  ERROR_PRINT << tmp.str();
+}
+
+void convert_config_to_binary( const std::string& textfile, const std::string& binfile )
+{
+  ConfigFile cf( textfile );
+  std::ofstream ofs( binfile, std::ios::out | std::ios::trunc | std::ios::binary );
+  if ( !ofs.is_open() )
+    throw std::runtime_error( "Unable to open " + binfile );
+  BinaryConfigWriter writer;
+  ConfigElem elem;
+  while ( cf.read( elem ) )
+  {
+    writer.write( elem );
+    if ( writer.data().size() >= 64 * 1024 )
+    {
+      ofs.write( writer.data().data(), writer.data().size() );
+      writer.data().clear();
+    }
+  }
+  ofs.write( writer.data().data(), writer.data().size() );
+  if ( !ofs.flush() )
+    throw std::runtime_error( "Failed to write " + binfile );
+}
+
+void convert_config_to_text( const std::string& binfile, const std::string& textfile )
+{
+  BinaryConfigFile cf( binfile );
+  std::ofstream ofs( textfile, std::ios::out | std::ios::trunc );
+  if ( !ofs.is_open() )
+    throw std::runtime_error( "Unable to open " + textfile );
+  fmt::Writer out;
+  ConfigElem elem;
+  while ( cf.read( elem ) )
+  {
+    out << elem.type();
+    if ( strlen( elem.rest() ) > 0 )
+      out << " " << elem.rest();
+    out << "\n{\n";
+    std::string name, value;
+    while ( elem.remove_first_prop( &name, &value ) )
+    {
+      out << "\t" << name << "\t";
+      if ( needs_quotes( value ) )
+        out << getencodedquotedstring( value );
+      else
+        out << value;
+      out << "\n";
+    }
+    out << "}\n\n";
+    if ( out.size() >= 64 * 1024 )
+    {
+      ofs << out.str();
+      out.Clear();
+    }
+  }
+  ofs << out.str();
+  if ( !ofs.flush() )
+    throw std::runtime_error( "Failed to write " + textfile );
+}
+}  // namespace Clib
+}  // namespace Pol
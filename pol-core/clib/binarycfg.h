@@ -0,0 +1,118 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#ifndef CLIB_BINARYCFG_H
+#define CLIB_BINARYCFG_H
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cfgfile.h"
+#include "maputil.h"
+#include "mappedfile.h"
+#include "rawtypes.h"
+
+namespace Pol
+{
+namespace Clib
+{
+class ConfigElem;
+
+/**
+ * Compact binary encoding of data files like the world save.
+ *
+ * The file starts with a magic and version, followed by records. Every record starts with the
+ * varint length of its payload and a kind byte, readers skip kinds they don't know:
+ * - NAME: defines the next id of the string table (element types, property and cprop names)
+ * - ELEM: type id, rest, property count and the properties as name id and typed value
+ * Decimal and hex numbers (all lowercase or all uppercase digits) which print back identically
+ * are stored as varints, "CProp name i.." and "CProp name s.." as cprop name id plus the int or
+ * the string. Other packed cprops (reals, arrays, structs...) keep their packed text behind the
+ * cprop name id.
+ * Reading an element gives exactly the ConfigElem the text format would have given.
+ */
+class BinaryConfigWriter
+{
+public:
+  BinaryConfigWriter();
+  BinaryConfigWriter( const BinaryConfigWriter& ) = delete;
+  BinaryConfigWriter& operator=( const BinaryConfigWriter& ) = delete;
+
+  void write( const ConfigElem& elem );
+  // encodes the text format line by line as it gets formatted, an incomplete last line waits
+  // for the next call
+  void write_text( const char* text, size_t len, const std::string& filename );
+  // throws if write_text got an incomplete element
+  void finish_text( const std::string& filename );
+
+  // encoded data which was not taken yet, the caller clears it after writing it out
+  std::string& data();
+
+private:
+  enum TextState
+  {
+    TEXT_OUTSIDE,
+    TEXT_OPEN,  // type line read, expects the '{'
+    TEXT_PROPERTIES
+  };
+
+  unsigned int intern( const std::string& name );
+  unsigned int intern( const char* name, size_t len );
+  void put_value( std::string& out, bool cprop, const char* value, size_t len );
+  void put_element( const std::string& props, u64 count );
+  void text_line( const char* begin, const char* end, const std::string& filename );
+  void text_error( const std::string& msg, const std::string& filename ) const;
+
+  std::unordered_map<std::string, unsigned int> _names;
+  std::string _data;
+  std::string _record;
+  std::string _props;  // properties of the element, written behind the count
+  u64 _prop_count;
+  std::string _name;  // lookup buffer of intern
+  std::string _text_carry;  // incomplete last line
+  std::string _text_line_buf;  // line which had to be sanitized
+  std::string _text_value;  // decoded quoted value
+  TextState _text_state;
+  int _text_line;
+  int _element_line;
+};
+
+class BinaryConfigFile : public ConfigSource
+{
+public:
+  explicit BinaryConfigFile( const std::string& filename, const char* allowed_types = nullptr );
+  BinaryConfigFile( const BinaryConfigFile& ) = delete;
+  BinaryConfigFile& operator=( const BinaryConfigFile& ) = delete;
+
+  // checks the magic of the file
+  static bool is_binary( const std::string& filename );
+
+  bool read( ConfigElem& elem );  // true=got one, false=end of file
+  const std::string& filename() const;
+
+  virtual void display_error( const std::string& msg, bool show_curline = true,
+                              const ConfigElemBase* elem = nullptr,
+                              bool error = true ) const override;
+
+private:
+  bool _read( ConfigElem& elem );
+
+  MappedFile _file;
+  const char* _pos;
+  const char* _end;
+  size_t _element_start;  // file offset of the current element
+  std::vector<std::string> _names;
+  std::set<std::string, ci_cmp_pred> _allowed_types;
+};
+
+// converters between the text and binary format, throw on error
+void convert_config_to_binary( const std::string& textfile, const std::string& binfile );
+void convert_config_to_text( const std::string& binfile, const std::string& textfile );
+}  // namespace Clib
+}  // namespace Pol
+#endif
@@ -53,9 +53,15 @@ class ConfigElem : public ConfigElemBase
 {
 public:
   ConfigElem();
+  ConfigElem( const ConfigElem& ) = default;
+  ConfigElem( ConfigElem&& ) = default;
+  ConfigElem& operator=( const ConfigElem& ) = default;
+  ConfigElem& operator=( ConfigElem&& ) = default;
   virtual ~ConfigElem();
   virtual size_t estimateSize() const override;
   friend class ConfigFile;
+  friend class BinaryConfigFile;
+  friend class BinaryConfigWriter;
 
   bool has_prop( const char* propname ) const;
 
@@ -29,6 +29,14 @@ namespace Clib
 {
 namespace
 {
+bool closes_element( const char* begin, const char* end )
+{
+  while ( begin != end && isspace( static_cast<unsigned char>( *begin ) ) )
+    ++begin;
+  return begin != end && *begin == '}' &&
+         ( begin + 1 == end || isspace( static_cast<unsigned char>( begin[1] ) ) );
+}
+
 bool commentline( const std::string& str )
 {
 #ifdef __GNUC__
@@ -546,6 +554,8 @@ ConfigFile::ConfigFile( const char* i_filename, const char* allowed_types_str )
 #else
       fp( nullptr ),
 #endif
+      _content(),
+      _content_pos( 0 ),
       _element_line_start( 0 ),
       _cur_line( 0 )
 {
@@ -560,12 +570,31 @@ ConfigFile::ConfigFile( const std::string& i_filename, const char* allowed_types
 #else
       fp( nullptr ),
 #endif
+      _content(),
+      _content_pos( 0 ),
       _element_line_start( 0 ),
       _cur_line( 0 )
 {
   init( i_filename.c_str(), allowed_types_str );
 }
 
+ConfigFile::ConfigFile( const std::string& i_filename, std::string content, int first_line,
+                        const char* allowed_types_str )
+    : _filename( i_filename ),
+      _modified( 0 ),
+#if CFGFILE_USES_IOSTREAMS
+      ifs(),
+#else
+      fp( nullptr ),
+#endif
+      _content( std::move( content ) ),
+      _content_pos( 0 ),
+      _element_line_start( 0 ),
+      _cur_line( first_line )
+{
+  init( nullptr, allowed_types_str );
+}
+
 void ConfigFile::init( const char* i_filename, const char* allowed_types_str )
 {
   if ( i_filename )
@@ -633,10 +662,6 @@ ConfigFile::~ConfigFile()
 #endif
 }
 
-#if !CFGFILE_USES_IOSTREAMS
-char ConfigFile::buffer[1024];
-#endif
-
 #if CFGFILE_USES_IOSTREAMS
 // returns true if ended on a }, false if ended on EOF.
 bool ConfigFile::read_properties( ConfigElem& elem )
@@ -746,6 +771,20 @@ bool ConfigFile::_read( ConfigElem& elem )
 
 bool ConfigFile::readline( std::string& strbuf )
 {
+  if ( fp == nullptr )
+  {
+    if ( _content_pos >= _content.size() )
+      return false;
+    size_t end = _content.find( '\n', _content_pos );
+    if ( end == std::string::npos )
+      end = _content.size();
+    size_t len = end - _content_pos;
+    if ( len > 0 && _content[end - 1] == '\r' )
+      --len;
+    strbuf.assign( _content, _content_pos, len );
+    _content_pos = end + 1;
+    return true;
+  }
   if ( !fgets( buffer, sizeof buffer, fp ) )
     return false;
 
@@ -774,8 +813,8 @@ bool ConfigFile::readline( std::string& strbuf )
 // returns true if ended on a }, false if ended on EOF.
 bool ConfigFile::read_properties( ConfigElem& elem )
 {
-  static std::string strbuf;
-  static std::string propname, propvalue;
+  static thread_local std::string strbuf;
+  static thread_local std::string propname, propvalue;
   while ( readline( strbuf ) )
   {
     if ( !_cur_line )
@@ -809,8 +848,8 @@ bool ConfigFile::read_properties( ConfigElem& elem )
 }
 bool ConfigFile::read_properties( VectorConfigElem& elem )
 {
-  static std::string strbuf;
-  static std::string propname, propvalue;
+  static thread_local std::string strbuf;
+  static thread_local std::string propname, propvalue;
   while ( readline( strbuf ) )
   {
     if ( !_cur_line )
@@ -893,9 +932,8 @@ bool ConfigFile::_read( ConfigElem& elem )
 
     elem.rest_ = rest;
 
-    if ( !fgets( buffer, sizeof buffer, fp ) )
+    if ( !readline( strbuf ) )
       throw std::runtime_error( "File ends after element type -- expected a '{'" );
-    strbuf = buffer;
     ++_cur_line;
     sanitizeUnicodeWithIso( &strbuf );
 
@@ -962,9 +1000,8 @@ bool ConfigFile::_read( VectorConfigElem& elem )
 
     elem.rest_ = rest;
 
-    if ( !fgets( buffer, sizeof buffer, fp ) )
+    if ( !readline( strbuf ) )
       throw std::runtime_error( "File ends after element type -- expected a '{'" );
-    strbuf = buffer;
     ++_cur_line;
     sanitizeUnicodeWithIso( &strbuf );
 
@@ -1064,6 +1101,20 @@ void ConfigFile::readraw( ConfigElem& elem )
   }
 }
 
+size_t last_element_end( const std::string& content )
+{
+  size_t line_end = content.rfind( '\n' );
+  while ( line_end != std::string::npos )
+  {
+    size_t prev = line_end == 0 ? std::string::npos : content.rfind( '\n', line_end - 1 );
+    size_t line_begin = prev == std::string::npos ? 0 : prev + 1;
+    if ( closes_element( content.data() + line_begin, content.data() + line_end ) )
+      return line_end + 1;
+    line_end = prev;
+  }
+  return std::string::npos;
+}
+
 void StubConfigSource::display_error( const std::string& msg, bool /*show_curline*/,
                                       const ConfigElemBase* /*elem*/, bool error ) const
 {
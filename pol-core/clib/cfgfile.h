@@ -45,6 +45,9 @@ class ConfigFile : public ConfigSource
 public:
   explicit ConfigFile( const char* filename = nullptr, const char* allowed_types = nullptr );
   explicit ConfigFile( const std::string& filename, const char* allowed_types = nullptr );
+  // parses a part of filename which was already read into memory, starting at line first_line
+  ConfigFile( const std::string& filename, std::string content, int first_line,
+              const char* allowed_types = nullptr );
   virtual ~ConfigFile();
 
   void open( const char* i_filename );
@@ -79,8 +82,11 @@ private:
   std::ifstream ifs;
 #else
   FILE* fp;
-  static char buffer[1024];
+  char buffer[1024];
 #endif
+  // used instead of fp for in memory content
+  std::string _content;
+  size_t _content_pos;
   int _element_line_start;  // what line in the file did this elem start on?
   int _cur_line;
 
@@ -88,6 +94,10 @@ private:
   AllowedTypesCont allowed_types_;
 };
 
+// position after the last line which closes an element ("}" as first token), npos if there is
+// none; text up to there can be parsed without the rest of the file
+size_t last_element_end( const std::string& content );
+
 class StubConfigSource : public ConfigSource
 {
 public:
@@ -0,0 +1,145 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#include "mappedfile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include "Header_Windows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Pol
+{
+namespace Clib
+{
+MappedFile::MappedFile()
+    : _filename(),
+      _data( nullptr ),
+      _size( 0 ),
+#ifdef _WIN32
+      _file( INVALID_HANDLE_VALUE ),
+      _mapping( nullptr )
+#else
+      _fd( -1 )
+#endif
+{
+}
+
+MappedFile::MappedFile( const std::string& filename, Access access ) : MappedFile()
+{
+  open( filename, access );
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+void MappedFile::open( const std::string& filename, Access access )
+{
+  close();
+  _filename = filename;
+#ifdef _WIN32
+  _file = CreateFile( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                      access == SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS,
+                      nullptr );
+  if ( _file == INVALID_HANDLE_VALUE )
+    throw std::runtime_error( "MappedFile::open('" + filename + "') failed." );
+  LARGE_INTEGER size;
+  if ( !GetFileSizeEx( _file, &size ) )
+  {
+    close();
+    throw std::runtime_error( "MappedFile::open('" + filename + "') failed to get size." );
+  }
+  _size = static_cast<size_t>( size.QuadPart );
+  if ( _size == 0 )
+    return;
+  _mapping = CreateFileMapping( _file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+  if ( _mapping != nullptr )
+    _data = static_cast<const char*>( MapViewOfFile( _mapping, FILE_MAP_READ, 0, 0, 0 ) );
+#else
+  _fd = ::open( filename.c_str(), O_RDONLY );
+  if ( _fd < 0 )
+    throw std::runtime_error( "MappedFile::open('" + filename + "') failed: " +
+                              std::strerror( errno ) );
+  struct stat st;
+  if ( fstat( _fd, &st ) )
+  {
+    close();
+    throw std::runtime_error( "MappedFile::open('" + filename + "') failed to get size." );
+  }
+  _size = static_cast<size_t>( st.st_size );
+  if ( _size == 0 )
+    return;
+  void* mem = mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0 );
+  if ( mem != MAP_FAILED )
+  {
+    _data = static_cast<const char*>( mem );
+    madvise( mem, _size, access == SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM );
+  }
+#endif
+  if ( _data == nullptr )
+  {
+    close();
+    throw std::runtime_error( "MappedFile::open('" + filename + "') failed to map the file." );
+  }
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+  if ( _data != nullptr )
+    UnmapViewOfFile( _data );
+  if ( _mapping != nullptr )
+    CloseHandle( _mapping );
+  if ( _file != INVALID_HANDLE_VALUE )
+    CloseHandle( _file );
+  _mapping = nullptr;
+  _file = INVALID_HANDLE_VALUE;
+#else
+  if ( _data != nullptr )
+    munmap( const_cast<char*>( _data ), _size );
+  if ( _fd >= 0 )
+    ::close( _fd );
+  _fd = -1;
+#endif
+  _data = nullptr;
+  _size = 0;
+}
+
+bool MappedFile::is_open() const
+{
+#ifdef _WIN32
+  return _file != INVALID_HANDLE_VALUE;
+#else
+  return _fd >= 0;
+#endif
+}
+
+const char* MappedFile::data() const
+{
+  return _data;
+}
+
+size_t MappedFile::size() const
+{
+  return _size;
+}
+
+const std::string& MappedFile::filename() const
+{
+  return _filename;
+}
+}  // namespace Clib
+}  // namespace Pol
@@ -0,0 +1,58 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#ifndef CLIB_MAPPEDFILE_H
+#define CLIB_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace Pol
+{
+namespace Clib
+{
+/**
+ * Read only memory mapping of a whole file.
+ * Pages get loaded by the OS on first access, so reading the file does not need an extra copy.
+ */
+class MappedFile
+{
+public:
+  // access pattern hint for the OS read ahead
+  enum Access
+  {
+    SEQUENTIAL,
+    RANDOM
+  };
+
+  MappedFile();
+  explicit MappedFile( const std::string& filename, Access access = SEQUENTIAL );
+  ~MappedFile();
+  MappedFile( const MappedFile& ) = delete;
+  MappedFile& operator=( const MappedFile& ) = delete;
+
+  void open( const std::string& filename, Access access = SEQUENTIAL );  // throws on error
+  void close();
+
+  bool is_open() const;
+  const char* data() const;
+  size_t size() const;
+  const std::string& filename() const;
+
+private:
+  std::string _filename;
+  const char* _data;
+  size_t _size;
+#ifdef _WIN32
+  void* _file;
+  void* _mapping;
+#else
+  int _fd;
+#endif
+};
+}  // namespace Clib
+}  // namespace Pol
+#endif
@@ -5,6 +5,8 @@
 
 #include "streamsaver.h"
 
+#include "binarycfg.h"
+
 namespace Pol
 {
 namespace Clib
@@ -12,21 +14,33 @@ namespace Clib
 const std::size_t flush_limit = 10000;  // 500;
 
 /// BaseClass implements only writer operator logic
-StreamWriter::StreamWriter() : _writer( new fmt::Writer ) {}
+StreamWriter::StreamWriter() : _writer( new fmt::Writer ), _defer_flush( false ) {}
 
 fmt::Writer& StreamWriter::operator()()
 {
-  if ( _writer->size() >= flush_limit )  // guard against to big objects
+  if ( !_defer_flush && _writer->size() >= flush_limit )  // guard against to big objects
   {
     this->flush();
   }
   return *( _writer.get() );
 }
 
+void StreamWriter::defer_flush( bool defer )
+{
+  _defer_flush = defer;
+}
+
+void StreamWriter::write_shared( const std::shared_ptr<const std::string>& text )
+{
+  ( *this )() << *text;
+}
+
 /// ofstream implementation (simple non threaded)
 OFStreamWriter::OFStreamWriter()
     : StreamWriter(),
       _stream(),
+      _binary(),
+      _shared(),
 #if 0
       _fs_time( 0 ),
 #endif
@@ -37,6 +51,8 @@ OFStreamWriter::OFStreamWriter()
 OFStreamWriter::OFStreamWriter( std::ofstream* stream )
     : StreamWriter(),
       _stream( stream ),
+      _binary(),
+      _shared(),
 #if 0
       _fs_time( 0 ),
 #endif
@@ -55,8 +71,9 @@ OFStreamWriter::~OFStreamWriter()
       }
       ERROR_PRINT << "streamwriter " << _stream_name << " io time " << _fs_time.count( ) << "\n";
 #else
-  if ( _writer->size() )
-    *_stream << _writer->str();
+  // binary data is only complete after flush_file, which may throw
+  if ( !_binary )
+    flush();
 #endif
 }
 
@@ -67,24 +84,73 @@ void OFStreamWriter::init( const std::string& filepath )
   _stream_name = filepath;
 }
 
+void OFStreamWriter::init_binary( const std::string& filepath )
+{
+  _stream->exceptions( std::ios_base::failbit | std::ios_base::badbit );
+  _stream->open( filepath.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+  _stream_name = filepath;
+  _binary.reset( new BinaryConfigWriter );
+}
+
+void OFStreamWriter::write_shared( const std::shared_ptr<const std::string>& text )
+{
+  if ( _defer_flush )
+    _shared.emplace_back( _writer->size(), text );
+  else
+    StreamWriter::write_shared( text );
+}
+
 void OFStreamWriter::flush()
 {
 #if 0
       Tools::HighPerfTimer t;
 #endif
-  if ( _writer->size() )
+  size_t pos = 0;
+  for ( const auto& shared : _shared )
   {
-    *_stream << _writer->str();
-    _writer->Clear();
+    write_text( _writer->data() + pos, shared.first - pos );
+    write_text( shared.second->data(), shared.second->size() );
+    pos = shared.first;
+  }
+  _shared.clear();
+  write_text( _writer->data() + pos, _writer->size() - pos );
+  _writer->Clear();
+  if ( _binary )
+  {
+    std::string& data = _binary->data();
+    _stream->write( data.data(), data.size() );
+    data.clear();
   }
 #if 0
       _fs_time += t.ellapsed( );
 #endif
 }
 
+void OFStreamWriter::write_text( const char* text, size_t len )
+{
+  if ( len == 0 )
+    return;
+  if ( _binary )
+  {
+    _binary->write_text( text, len, _stream_name );
+    std::string& data = _binary->data();
+    _stream->write( data.data(), data.size() );
+    data.clear();
+  }
+  else
+    _stream->write( text, len );
+}
+
 void OFStreamWriter::flush_file()
 {
   flush();
+  if ( _binary )
+  {
+    _binary->finish_text( _stream_name );
+    std::string& data = _binary->data();
+    _stream->write( data.data(), data.size() );
+    data.clear();
+  }
   _stream->flush();
 }
 
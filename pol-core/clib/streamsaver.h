@@ -5,6 +5,8 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "message_queue.h"
 #include <format/format.h>
@@ -16,6 +18,8 @@ namespace Pol
 {
 namespace Clib
 {
+class BinaryConfigWriter;
+
 class StreamWriter
 {
 public:
@@ -24,12 +28,18 @@ public:
   StreamWriter( const StreamWriter& ) = delete;
   StreamWriter& operator=( const StreamWriter& ) = delete;
   fmt::Writer& operator()();
+  // keeps everything in memory until flush() or flush_file() gets called
+  void defer_flush( bool defer );
+  // appends text which never changes again, copied into the buffer unless the writer keeps
+  // a reference
+  virtual void write_shared( const std::shared_ptr<const std::string>& text );
   virtual void init( const std::string& filepath ) = 0;
   virtual void flush() = 0;
   virtual void flush_file() = 0;
 
 protected:
   std::unique_ptr<fmt::Writer> _writer;
+  bool _defer_flush;
 };
 
 class FMTStreamWriter final : public StreamWriter
@@ -49,11 +59,20 @@ public:
   OFStreamWriter( std::ofstream* stream );
   virtual ~OFStreamWriter();
   virtual void init( const std::string& filepath ) override;
+  // the formatted elements get written in the binary format, see BinaryConfigWriter
+  void init_binary( const std::string& filepath );
+  // while deferred only a reference to the text is kept, it gets written by the next flush
+  virtual void write_shared( const std::shared_ptr<const std::string>& text ) override;
   virtual void flush() override;
   virtual void flush_file() override;
 
 private:
+  void write_text( const char* text, size_t len );
+
   std::ofstream* _stream;
+  std::unique_ptr<BinaryConfigWriter> _binary;
+  // shared texts with the buffer size at the time they were appended
+  std::vector<std::pair<size_t, std::shared_ptr<const std::string>>> _shared;
 #if 0
       Tools::HighPerfTimer::time_mu _fs_time;
 #endif
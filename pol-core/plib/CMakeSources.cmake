@@ -12,6 +12,8 @@ set (plib_sources  # sorted !
   mapcell.h
   mapfunc.cpp 
   mapfunc.h
+  mappedmapserver.cpp
+  mappedmapserver.h
   mapserver.cpp 
   mapserver.h
   mapshape.h
@@ -0,0 +1,51 @@
+/** @file
+ *
+ * @par History
+ */
+
+#include "mappedmapserver.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "../clib/passert.h"
+#include "mapblock.h"
+
+namespace Pol
+{
+namespace Plib
+{
+MappedMapServer::MappedMapServer( const RealmDescriptor& descriptor )
+    : MapServer( descriptor ), _mapfile(), _mapblocks( nullptr )
+{
+  size_t n_blocks = static_cast<size_t>( _descriptor.width >> MAPBLOCK_SHIFT ) *
+                    ( _descriptor.height >> MAPBLOCK_SHIFT );
+
+  _mapfile.open( _descriptor.path( "base.dat" ), Clib::MappedFile::RANDOM );
+  if ( _mapfile.size() < n_blocks * sizeof( MAPBLOCK ) )
+    throw std::runtime_error( _mapfile.filename() + " is too small for the realm size." );
+
+  _mapblocks = reinterpret_cast<const MAPBLOCK*>( _mapfile.data() );
+}
+
+MAPCELL MappedMapServer::GetMapCell( unsigned short x, unsigned short y ) const
+{
+  passert( x < _descriptor.width && y < _descriptor.height );
+
+  unsigned short xblock = x >> MAPBLOCK_SHIFT;
+  unsigned short xcell = x & MAPBLOCK_CELLMASK;
+  unsigned short yblock = y >> MAPBLOCK_SHIFT;
+  unsigned short ycell = y & MAPBLOCK_CELLMASK;
+
+  int block_index = yblock * ( _descriptor.width >> MAPBLOCK_SHIFT ) + xblock;
+  const MAPBLOCK& mapblock = _mapblocks[block_index];
+  return mapblock.cell[xcell][ycell];
+}
+
+size_t MappedMapServer::sizeEstimate() const
+{
+  // the mapped pages belong to the page cache and are not counted
+  return sizeof( *this ) + MapServer::sizeEstimate() + _mapfile.filename().capacity();
+}
+}
+}
@@ -0,0 +1,51 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#ifndef PLIB_MAPPEDMAPSERVER_H
+#define PLIB_MAPPEDMAPSERVER_H
+
+#include "../clib/mappedfile.h"
+#include "mapblock.h"
+#include "mapcell.h"
+#include "mapserver.h"
+
+namespace Pol
+{
+namespace Plib
+{
+class RealmDescriptor;
+}  // namespace Plib
+}  // namespace Pol
+
+namespace Pol
+{
+namespace Plib
+{
+/**
+ * Maps base.dat read only into memory.
+ * Blocks get paged in on first access and the pages are shared with every other process
+ * mapping the same file, so startup does not read the whole map.
+ */
+class MappedMapServer : public MapServer
+{
+public:
+  explicit MappedMapServer( const RealmDescriptor& descriptor );
+  virtual ~MappedMapServer() = default;
+
+  virtual MAPCELL GetMapCell( unsigned short x, unsigned short y ) const override;
+  virtual size_t sizeEstimate() const override;
+
+private:
+  Clib::MappedFile _mapfile;
+  const MAPBLOCK* _mapblocks;
+
+  // not implemented:
+  MappedMapServer& operator=( const MappedMapServer& );
+  MappedMapServer( const MappedMapServer& );
+};
+}
+}
+#endif
@@ -16,6 +16,7 @@
 #include "filemapserver.h"
 #include "inmemorymapserver.h"
 #include "mapcell.h"
+#include "mappedmapserver.h"
 #include "mapshape.h"
 #include "mapsolid.h"
 
@@ -156,6 +157,10 @@ MapServer* MapServer::Create( const RealmDescriptor& descriptor )
   {
     return new FileMapServer( descriptor );
   }
+  else if ( descriptor.mapserver_type == "mapped" )
+  {
+    return new MappedMapServer( descriptor );
+  }
   else
   {
     throw std::runtime_error( "Undefined mapserver type: " + descriptor.mapserver_type );
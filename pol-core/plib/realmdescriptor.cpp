@@ -9,6 +9,7 @@
 #include "../clib/cfgelem.h"
 #include "../clib/cfgfile.h"
 #include "../clib/strutil.h"
+#include "systemstate.h"
 
 
 namespace Pol
@@ -59,6 +60,8 @@ RealmDescriptor::RealmDescriptor( const std::string& realm_name, const std::stri
       grid_width( calc_grid_size( width ) ),
       grid_height( calc_grid_size( height ) )
 {
+  if ( !systemstate.config.map_server.empty() )
+    mapserver_type = systemstate.config.map_server;
 }
 
 size_t RealmDescriptor::sizeEstimate() const
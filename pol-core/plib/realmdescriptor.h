@@ -35,7 +35,7 @@ public:
   unsigned num_map_patches;
   unsigned num_static_patches;
   unsigned season;
-  std::string mapserver_type;  // "memory" or "file"
+  std::string mapserver_type;  // "memory", "file" or "mapped"
   unsigned short grid_width;
   unsigned short grid_height;
 
@@ -21,19 +21,44 @@ namespace Pol
 namespace Plib
 {
 StaticServer::StaticServer( const RealmDescriptor& descriptor )
-    : _descriptor( descriptor ), _index(), _statics()
+    : _descriptor( descriptor ),
+      _index(),
+      _statics(),
+      _indexfile(),
+      _staticsfile(),
+      _index_data( nullptr ),
+      _index_count( 0 ),
+      _statics_data( nullptr ),
+      _statics_count( 0 )
 {
-  Clib::BinaryFile index_file( _descriptor.path( "statidx.dat" ), std::ios::in );
-  index_file.ReadVector( _index );
-  if ( _index.empty() )
+  if ( _descriptor.mapserver_type == "mapped" )
+  {
+    _indexfile.open( _descriptor.path( "statidx.dat" ), Clib::MappedFile::RANDOM );
+    _index_data = reinterpret_cast<const STATIC_INDEX*>( _indexfile.data() );
+    _index_count = _indexfile.size() / sizeof( STATIC_INDEX );
+
+    _staticsfile.open( _descriptor.path( "statics.dat" ), Clib::MappedFile::RANDOM );
+    _statics_data = reinterpret_cast<const STATIC_ENTRY*>( _staticsfile.data() );
+    _statics_count = _staticsfile.size() / sizeof( STATIC_ENTRY );
+  }
+  else
+  {
+    Clib::BinaryFile index_file( _descriptor.path( "statidx.dat" ), std::ios::in );
+    index_file.ReadVector( _index );
+    _index_data = _index.data();
+    _index_count = _index.size();
+
+    Clib::BinaryFile statics_file( _descriptor.path( "statics.dat" ), std::ios::in );
+    statics_file.ReadVector( _statics );
+    _statics_data = _statics.data();
+    _statics_count = _statics.size();
+  }
+  if ( _index_count == 0 )
   {
     std::string message = "Empty file: " + _descriptor.path( "statidx.dat" );
     throw std::runtime_error( message );
   }
-
-  Clib::BinaryFile statics_file( _descriptor.path( "statics.dat" ), std::ios::in );
-  statics_file.ReadVector( _statics );
-  if ( _statics.empty() )
+  if ( _statics_count == 0 )
   {
     std::string message = "Empty file: " + _descriptor.path( "statics.dat" );
     throw std::runtime_error( message );
@@ -63,15 +88,15 @@ void StaticServer::ValidateBlock( unsigned short x, unsigned short y ) const
 
   size_t block_index =
       static_cast<size_t>( y_block ) * ( _descriptor.width >> STATICBLOCK_SHIFT ) + x_block;
-  if ( block_index + 1 >= _index.size() )
+  if ( block_index + 1 >= _index_count )
   {
     std::string message =
         "statics integrity error(1): x=" + Clib::tostring( x ) + ", y=" + Clib::tostring( y );
     throw std::runtime_error( message );
   }
-  unsigned int first_entry_index = _index[block_index].index;
-  unsigned int num = _index[block_index + 1].index - first_entry_index;
-  if ( first_entry_index + num > _statics.size() )
+  unsigned int first_entry_index = _index_data[block_index].index;
+  unsigned int num = _index_data[block_index + 1].index - first_entry_index;
+  if ( first_entry_index + num > _statics_count )
   {
     std::string message =
         "statics integrity error(2): x=" + Clib::tostring( x ) + ", y=" + Clib::tostring( y );
@@ -88,12 +113,12 @@ bool StaticServer::findstatic( unsigned short x, unsigned short y, unsigned shor
   unsigned short xy = ( ( x & STATICCELL_MASK ) << 4 ) | ( y & STATICCELL_MASK );
 
   unsigned int block_index = x_block + y_block * ( _descriptor.width >> STATICBLOCK_SHIFT );
-  unsigned int first_entry_index = _index[block_index].index;
-  unsigned int num = _index[block_index + 1].index - first_entry_index;
+  unsigned int first_entry_index = _index_data[block_index].index;
+  unsigned int num = _index_data[block_index + 1].index - first_entry_index;
 
   if ( num )
   {
-    const STATIC_ENTRY* entry = &_statics[first_entry_index];
+    const STATIC_ENTRY* entry = &_statics_data[first_entry_index];
     while ( num-- )
     {
       if ( entry->xy == xy && entry->objtype == objtype )
@@ -115,12 +140,12 @@ void StaticServer::getstatics( StaticEntryList& statics, unsigned short x, unsig
   unsigned short xy = ( ( x & STATICCELL_MASK ) << 4 ) | ( y & STATICCELL_MASK );
 
   unsigned int block_index = x_block + y_block * ( _descriptor.width >> STATICBLOCK_SHIFT );
-  unsigned int first_entry_index = _index[block_index].index;
-  unsigned int num = _index[block_index + 1].index - first_entry_index;
+  unsigned int first_entry_index = _index_data[block_index].index;
+  unsigned int num = _index_data[block_index + 1].index - first_entry_index;
 
   if ( num )
   {
-    const STATIC_ENTRY* entry = &_statics[first_entry_index];
+    const STATIC_ENTRY* entry = &_statics_data[first_entry_index];
     while ( num-- )
     {
       if ( entry->xy == xy )
@@ -137,6 +162,8 @@ size_t StaticServer::sizeEstimate() const
   size_t size = sizeof( *this ) + _descriptor.sizeEstimate();
   size += 3 * sizeof( STATIC_INDEX* ) + _index.capacity() * sizeof( STATIC_INDEX );
   size += 3 * sizeof( STATIC_ENTRY* ) + _statics.capacity() * sizeof( STATIC_ENTRY );
+  // the mapped pages belong to the page cache and are not counted
+  size += _indexfile.filename().capacity() + _staticsfile.filename().capacity();
   return size;
 }
 }
@@ -10,6 +10,7 @@
 
 #include <vector>
 
+#include "../clib/mappedfile.h"
 #include "realmdescriptor.h"
 #include "staticblock.h"
 
@@ -44,6 +45,15 @@ private:
 
   std::vector<STATIC_INDEX> _index;
   std::vector<STATIC_ENTRY> _statics;
+  // used instead of the vectors with the "mapped" mapserver type
+  Clib::MappedFile _indexfile;
+  Clib::MappedFile _staticsfile;
+
+  // point either into the vectors or into the mapped files
+  const STATIC_INDEX* _index_data;
+  size_t _index_count;
+  const STATIC_ENTRY* _statics_data;
+  size_t _statics_count;
 };
 }
 }
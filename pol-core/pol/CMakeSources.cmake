@@ -238,12 +238,18 @@ set (pol_sources  # sorted !
   network/client.h
   network/clientio.cpp
   network/clientio.h
+  network/clientreactor.cpp
+  network/clientreactor.h
   network/clientthread.cpp
   network/clientthread.h
   network/clienttransmit.cpp
   network/clienttransmit.h
   network/cliface.cpp
   network/cliface.h
+  network/gumpcache.cpp
+  network/gumpcache.h
+  network/huffman.cpp
+  network/huffman.h
   network/iostats.cpp
   network/iostats.h
   network/msgfiltr.cpp
@@ -278,6 +284,8 @@ set (pol_sources  # sorted !
   objtype.h
   packetscrobj.cpp
   packetscrobj.h
+  parallelcfgread.cpp
+  parallelcfgread.h
   party.cpp
   party.h
   party_cfg.h
@@ -314,6 +322,7 @@ set (pol_sources  # sorted !
   realms/realm.h
   realms/realmfunc.cpp
   realms/realmlos.cpp
+  realms/walkcache.h
   reftypes.cpp
   reftypes.h
   region.cpp
@@ -333,6 +342,7 @@ set (pol_sources  # sorted !
   scrsched.h
   scrstore.cpp
   scrstore.h
+  serialindex.h
   servdesc.h
   sfx.h
   skilladv.cpp
@@ -371,14 +381,18 @@ set (pol_sources  # sorted !
   testing/testdrop.cpp
   testing/testenv.cpp
   testing/testenv.h
+  testing/testhuffman.cpp
   testing/testlos.cpp
   testing/testmisc.cpp
+  testing/testobjecthash.cpp
+  testing/testpathfind.cpp
   testing/testskill.cpp
   testing/testwalk.cpp
   textcmd.cpp
   textcmd.h
   tildecmd.cpp
   tildecmd.h
+  timerwheel.h
   tiplist.h
   tiplstwn.cpp
   tips.cpp
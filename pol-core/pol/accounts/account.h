@@ -62,6 +62,7 @@ public:
   void set_password( std::string newpass ) { password_ = newpass; };
   void set_passwordhash( std::string newpass ) { passwordhash_ = newpass; };
   friend class AccountObjImp;
+  friend bool rename_account( Account* acct, const std::string& newname );
 
 private:
   std::vector<Core::CharacterRef> characters_;
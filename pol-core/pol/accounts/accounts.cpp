@@ -10,7 +10,9 @@
 
 #include "accounts.h"
 
+#include <algorithm>
 #include <iosfwd>
+#include <stdexcept>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -19,9 +21,11 @@
 #include "../../clib/cfgelem.h"
 #include "../../clib/cfgfile.h"
 #include "../../clib/clib.h"
+#include "../../clib/fileutil.h"
 #include "../../clib/logfacility.h"
 #include "../../clib/passert.h"
 #include "../../clib/streamsaver.h"
+#include "../../clib/strutil.h"
 #include "../../clib/timer.h"
 #include "../../plib/systemstate.h"
 #include "../globals/state.h"
@@ -33,6 +37,116 @@ namespace Pol
 {
 namespace Accounts
 {
+namespace
+{
+std::string account_key( const char* acctname )
+{
+  return Clib::strlowerASCII( acctname );
+}
+
+void add_account( Account* acct )
+{
+  Core::gamestate.accounts.push_back( Core::AccountRef( acct ) );
+  Core::gamestate.accounts_by_name.emplace( account_key( acct->name() ), acct );
+}
+
+void remove_account( Account* acct )
+{
+  Core::gamestate.accounts_by_name.erase( account_key( acct->name() ) );
+  auto& accounts = Core::gamestate.accounts;
+  accounts.erase( std::find( accounts.begin(), accounts.end(), Core::AccountRef( acct ) ) );
+}
+
+std::string account_journal_file()
+{
+  return Plib::systemstate.config.world_data_path + "accounts.jnl";
+}
+
+void reread_account( Clib::ConfigElem& elem )
+{
+  std::string name = elem.remove_string( "NAME" );
+  Account* existing = find_account( name.c_str() );
+  if ( existing != nullptr )
+  {
+    existing->readfrom( elem );
+  }
+  else
+  {
+    elem.add_prop( "NAME", name );
+    add_account( new Account( elem ) );
+  }
+}
+
+// false if the journal could not be written completely
+bool write_account_journal()
+{
+  std::string journalfile = account_journal_file();
+  try
+  {
+    std::ofstream ofs( journalfile.c_str(), std::ios::app | std::ios::out );
+    if ( !ofs.is_open() )
+      throw std::runtime_error( "Unable to open " + journalfile );
+    Clib::OFStreamWriter sw( &ofs );
+    for ( const auto& name : Core::gamestate.changed_accounts )
+    {
+      Account* acct = find_account( name.c_str() );
+      if ( acct != nullptr )
+        acct->writeto( sw );
+      else
+        sw() << "DeleteAccount\n{\n\tName\t" << name << "\n}\n\n";
+    }
+    // the stream has no exceptions enabled, the state tells if everything got written
+    sw.flush_file();
+    if ( !ofs )
+      throw std::runtime_error( "Failed to write " + journalfile );
+  }
+  catch ( std::exception& ex )
+  {
+    POLLOG_ERROR << "failed to store accounts journal: " << ex.what() << "\n";
+    Clib::force_backtrace();
+    return false;
+  }
+  Core::gamestate.account_journal_records +=
+      static_cast<unsigned int>( Core::gamestate.changed_accounts.size() );
+  Core::gamestate.changed_accounts.clear();
+  Plib::systemstate.accounts_txt_dirty = false;
+  return true;
+}
+}  // namespace
+
+// applies the changes appended since accounts.txt was written, a crash can leave the last entry
+// incomplete so everything before a read error is kept
+void read_account_journal()
+{
+  std::string journalfile = account_journal_file();
+  if ( !Clib::FileExists( journalfile ) )
+    return;
+  unsigned int records = 0;
+  try
+  {
+    Clib::ConfigFile cf( journalfile, "Account DeleteAccount" );
+    Clib::ConfigElem elem;
+    while ( cf.read( elem ) )
+    {
+      if ( elem.type_is( "DeleteAccount" ) )
+      {
+        Account* acct = find_account( elem.remove_string( "Name" ).c_str() );
+        if ( acct != nullptr )
+          remove_account( acct );
+      }
+      else
+        reread_account( elem );
+      ++records;
+    }
+  }
+  catch ( ... )
+  {
+    POLLOG_ERROR << "Error reading " << journalfile << " after " << records << " entries.\n";
+  }
+  // merged by the next write of accounts.txt
+  Plib::systemstate.accounts_txt_dirty = true;
+}
+
 void read_account_data()
 {
   unsigned int naccounts = 0;
@@ -55,10 +169,11 @@ void read_account_data()
         INFO_PRINT << ".";
         num_until_dot = 1000;
       }
-      Core::gamestate.accounts.push_back( Core::AccountRef( new Account( elem ) ) );
+      add_account( new Account( elem ) );
       naccounts++;
     }
   }
+  read_account_journal();
 
   if ( Plib::systemstate.accounts_txt_dirty )
   {
@@ -90,6 +205,9 @@ void write_account_data()
       Account* acct = account.get();
       acct->writeto( sw );
     }
+    sw.flush_file();
+    if ( !ofs )
+      throw std::runtime_error( "Failed to write " + accountsndtfile );
   }
   catch ( ... )
   {
@@ -101,6 +219,9 @@ void write_account_data()
     return;
   rename( accountstxtfile_c, accountsbakfile_c );
   rename( accountsndtfile_c, accountstxtfile_c );
+  unlink( account_journal_file().c_str() );
+  Core::gamestate.account_journal_records = 0;
+  Core::gamestate.changed_accounts.clear();
 
   struct stat newst;
   stat( accountstxtfile_c, &newst );
@@ -120,11 +241,8 @@ Account* create_new_account( const std::string& acctname, const std::string& pas
 
   elem.add_prop( "enabled", ( (unsigned int)( enabled ? 1 : 0 ) ) );
   auto acct = new Account( elem );
-  Core::gamestate.accounts.push_back( Core::AccountRef( acct ) );
-  if ( Plib::systemstate.config.account_save == -1 )
-    write_account_data();
-  else
-    Plib::systemstate.accounts_txt_dirty = true;
+  add_account( acct );
+  account_changed( acct->name() );
   return acct;
 }
 
@@ -141,11 +259,8 @@ Account* duplicate_account( const std::string& oldacctname, const std::string& n
     elem.add_prop( "name", newacctname );
 
     auto acct = new Account( elem );
-    Core::gamestate.accounts.push_back( Core::AccountRef( acct ) );
-    if ( Plib::systemstate.config.account_save == -1 )
-      write_account_data();
-    else
-      Plib::systemstate.accounts_txt_dirty = true;
+    add_account( acct );
+    account_changed( acct->name() );
     return acct;
   }
   return nullptr;
@@ -153,53 +268,63 @@ Account* duplicate_account( const std::string& oldacctname, const std::string& n
 
 Account* find_account( const char* acctname )
 {
-  for ( auto& account : Core::gamestate.accounts )
-  {
-    if ( stricmp( account->name(), acctname ) == 0 )
-    {
-      return account.get();
-    }
-  }
+  auto itr = Core::gamestate.accounts_by_name.find( account_key( acctname ) );
+  if ( itr != Core::gamestate.accounts_by_name.end() )
+    return itr->second;
   return nullptr;
 }
 
 int delete_account( const char* acctname )
 {
-  for ( auto itr = Core::gamestate.accounts.begin(), end = Core::gamestate.accounts.end();
-        itr != end; ++itr )
-  {
-    Account* account = ( *itr ).get();
-    if ( stricmp( account->name(), acctname ) == 0 )
-    {
-      if ( account->numchars() == 0 )
-      {
-        Core::gamestate.accounts.erase( itr );
-        if ( Plib::systemstate.config.account_save == -1 )
-          write_account_data();
-        else
-          Plib::systemstate.accounts_txt_dirty = true;
-        return 1;
-      }
-      else
-        return -1;
-    }
-  }
-  return -2;
+  Account* account = find_account( acctname );
+  if ( account == nullptr )
+    return -2;
+  if ( account->numchars() != 0 )
+    return -1;
+  std::string name = account->name();
+  remove_account( account );
+  account_changed( name.c_str() );
+  return 1;
 }
 
-void reread_account( Clib::ConfigElem& elem )
+// the journal gets a delete of the old name and the account under the new name, written by the
+// account_changed call which follows the rename. false if another account has the name.
+bool rename_account( Account* acct, const std::string& newname )
 {
-  std::string name = elem.remove_string( "NAME" );
-  Account* existing = find_account( name.c_str() );
-  if ( existing != nullptr )
-  {
-    existing->readfrom( elem );
-  }
+  Account* existing = find_account( newname.c_str() );
+  if ( existing != nullptr && existing != acct )
+    return false;
+  std::string oldkey = account_key( acct->name() );
+  Core::gamestate.accounts_by_name.erase( oldkey );
+  acct->name_ = newname;
+  Core::gamestate.accounts_by_name.emplace( account_key( acct->name() ), acct );
+  if ( Plib::systemstate.config.account_journal )
+    Core::gamestate.changed_accounts.insert( oldkey );
+  return true;
+}
+
+// the account gets written with the next save, immediately for AccountDataSave -1
+void account_changed( const char* acctname )
+{
+  if ( Plib::systemstate.config.account_journal )
+    Core::gamestate.changed_accounts.insert( account_key( acctname ) );
+  if ( Plib::systemstate.config.account_save == -1 )
+    write_account_changes();
   else
-  {
-    elem.add_prop( "NAME", name );
-    Core::gamestate.accounts.push_back( Core::AccountRef( new Account( elem ) ) );
-  }
+    Plib::systemstate.accounts_txt_dirty = true;
+}
+
+// appends to the journal if possible, rewrites accounts.txt when the journal got too large or
+// the changes are not tracked in it
+void write_account_changes()
+{
+  const auto& changed = Core::gamestate.changed_accounts;
+  size_t journal_limit = std::max<size_t>( 1000, Core::gamestate.accounts.size() / 4 );
+  if ( Plib::systemstate.config.account_journal && !changed.empty() &&
+       Core::gamestate.account_journal_records + changed.size() <= journal_limit &&
+       write_account_journal() )
+    return;
+  write_account_data();
 }
 
 void reload_account_data( void )
@@ -227,6 +352,8 @@ void reload_account_data( void )
         }
         INFO_PRINT << "Done!\n";
       }
+      // the journal holds newer changes than the file
+      read_account_journal();
       if ( Plib::systemstate.accounts_txt_dirty )
       {
         write_account_data();
@@ -243,7 +370,7 @@ void reload_account_data( void )
 void write_account_data_task( void )
 {
   if ( Plib::systemstate.accounts_txt_dirty )
-    write_account_data();
+    write_account_changes();
 }
 }  // namespace Accounts
 }  // namespace Pol
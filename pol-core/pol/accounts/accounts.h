@@ -23,7 +23,11 @@ Account* create_new_account( const std::string& acctname, const std::string& pas
 Account* duplicate_account( const std::string& oldacctname, const std::string& newacctname );
 Account* find_account( const char* acctname );
 int delete_account( const char* acctname );
+bool rename_account( Account* acct, const std::string& newname );
+void account_changed( const char* acctname );
+void write_account_changes();
 void write_account_data();
+void read_account_journal();
 void reload_account_data();
 void write_account_data_task();
 }
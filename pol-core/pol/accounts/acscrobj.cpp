@@ -240,7 +240,8 @@ Bscript::BObjectImp* AccountObjImp::call_method_id( const int id, Bscript::Execu
           return new BError( "Account name must not be empty." );
         std::string temp;
         // passing the new name, and recalc name+pass hash (pass only hash is unchanged)
-        obj_->name_ = nmstr->value();
+        if ( !rename_account( obj_.Ptr(), nmstr->value() ) )
+          return new BError( "Account name already in use." );
         Clib::MD5_Encrypt( obj_->name_ + obj_->password_, temp );
         obj_->passwordhash_ = temp;  // MD5
       }
@@ -258,7 +259,8 @@ Bscript::BObjectImp* AccountObjImp::call_method_id( const int id, Bscript::Execu
       {
         if ( nmstr->value().empty() )
           return new BError( "Account name must not be empty." );
-        obj_->name_ = nmstr->value();
+        if ( !rename_account( obj_.Ptr(), nmstr->value() ) )
+          return new BError( "Account name already in use." );
         // this is the same as the "setpassword" code above
         if ( Plib::systemstate.config.retain_cleartext_passwords )
           obj_->password_ = pwstr->value();
@@ -536,10 +538,7 @@ Bscript::BObjectImp* AccountObjImp::call_method_id( const int id, Bscript::Execu
   }
 
   // if any of the methods hit & worked, we'll come here
-  if ( Plib::systemstate.config.account_save == -1 )
-    write_account_data();
-  else
-    Plib::systemstate.accounts_txt_dirty = true;
+  account_changed( obj_->name() );
   return result ? result : new BLong( 1 );
 }
 
@@ -112,6 +112,7 @@ void doubleclick( Network::Client* client, PKTIN_06* msg )
   }
   else
     client->chr->dblclick_wait( read_gameclock() + settingsManager.ssopt.dblclick_wait );
+    client->chr->queue_regen();
 
   if ( IsCharacter( serial ) )
   {
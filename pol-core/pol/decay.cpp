@@ -20,6 +20,7 @@
 #include "globals/uvars.h"
 #include "item/item.h"
 #include "item/itemdesc.h"
+#include "objtype.h"
 #include "polcfg.h"
 #include "polsem.h"
 #include "realms/realm.h"
@@ -52,121 +53,146 @@ namespace Core
 ///     before destroying the container.
 ///
 
-void decay_worldzone( unsigned wx, unsigned wy, Realms::Realm* realm )
+namespace
 {
-  Zone& zone = realm->zone[wx][wy];
+// items which may not decay yet are looked at again after this time
+const gameclock_t DECAY_RECHECK = 60 * 10;
+// limits the time the world stays locked if many items expire at once (e.g. after startup)
+const unsigned MAX_DECAY_PER_RUN = 500;
+
+bool decays_at_all( const Items::Item* item )
+{
+  return item->decayat_gameclock_ != 0 &&
+         ( item->movable() || ( item->objtype_ == UOBJ_CORPSE ) );
+}
+}  // namespace
+
+void add_item_to_decay( Items::Item* item )
+{
+  item->decay_entry.reset( new DecayEntry( item ) );
+  schedule_decay( item );
+}
+
+void remove_item_from_decay( Items::Item* item )
+{
+  item->decay_entry.reset();
+}
+
+// call after decayat, movable or the realm of an item changed
+void schedule_decay( Items::Item* item )
+{
+  DecayEntry* entry = item->decay_entry.get();
+  if ( entry == nullptr )  // not in the world
+    return;
+  if ( entry->node.linked() )
+    entry->queue->erase( &entry->node );
+  if ( !decays_at_all( item ) )
+    return;
+  entry->queue = &item->realm->decay_queue;
+  // should_decay needs the gameclock to be past decayat
+  entry->queue->insert( &entry->node, item->decayat_gameclock_ + 1 );
+}
+
+// looks at the item again later, scripts run by the checks may have rescheduled it already
+void recheck_decay( Items::Item* item, gameclock_t when )
+{
+  DecayEntry* entry = item->decay_entry.get();
+  if ( entry == nullptr || entry->node.linked() )
+    return;
+  entry->queue = &item->realm->decay_queue;
+  entry->queue->insert( &entry->node, when );
+}
+
+void decay_realm( Realms::Realm* realm )
+{
+  DecayQueue& queue = realm->decay_queue;
   gameclock_t now = read_gameclock();
   bool statistics = Plib::systemstate.config.thread_decay_statistics;
 
-  for ( ZoneItems::size_type idx = 0; idx < zone.items.size(); ++idx )
+  for ( unsigned count = 0; count < MAX_DECAY_PER_RUN; ++count )
   {
-    Items::Item* item = zone.items[idx];
-    if ( statistics )
+    Items::Item* item = queue.next_expired( now );
+    if ( item == nullptr )
+      break;
+    queue.erase( &item->decay_entry->node );
+
+    if ( !item->should_decay( now ) )
     {
-      if ( item->can_decay() )
-      {
-        const Items::ItemDesc& descriptor = item->itemdesc();
-        if ( !descriptor.decays_on_multis )
-        {
-          Multi::UMulti* multi = realm->find_supporting_multi( item->x, item->y, item->z );
-          if ( multi == nullptr )
-            stateManager.decay_statistics.temp_count_active++;
-        }
-        else
-          stateManager.decay_statistics.temp_count_active++;
-      }
+      // everything else reschedules the item when it changes
+      if ( item->inuse() )
+        recheck_decay( item, now + DECAY_RECHECK );
+      continue;
     }
-    if ( item->should_decay( now ) )
+    // check the CanDecay syshook first if it returns 1 go over to other checks
+    if ( gamestate.system_hooks.can_decay )
     {
-      // check the CanDecay syshook first if it returns 1 go over to other checks
-      if ( gamestate.system_hooks.can_decay )
+      if ( !gamestate.system_hooks.can_decay->call( new Module::EItemRefObjImp( item ) ) )
       {
-        if ( !gamestate.system_hooks.can_decay->call( new Module::EItemRefObjImp( item ) ) )
-          continue;
+        recheck_decay( item, now + DECAY_RECHECK );
+        continue;
       }
+    }
 
-      const Items::ItemDesc& descriptor = item->itemdesc();
-      Multi::UMulti* multi = realm->find_supporting_multi( item->x, item->y, item->z );
+    const Items::ItemDesc& descriptor = item->itemdesc();
+    Multi::UMulti* multi = realm->find_supporting_multi( item->x, item->y, item->z );
 
-      // some things don't decay on multis:
-      if ( multi != nullptr && !descriptor.decays_on_multis )
-        continue;
+    // some things don't decay on multis:
+    if ( multi != nullptr && !descriptor.decays_on_multis )
+    {
+      recheck_decay( item, now + DECAY_RECHECK );
+      continue;
+    }
 
-      if ( statistics )
-        stateManager.decay_statistics.temp_count_decayed++;
+    if ( statistics )
+      stateManager.decay_statistics.temp_count_decayed++;
 
-      if ( !descriptor.destroy_script.empty() && !item->inuse() )
+    if ( !descriptor.destroy_script.empty() && !item->inuse() )
+    {
+      bool decayok = call_script( descriptor.destroy_script, item->make_ref() );
+      if ( !decayok )
       {
-        bool decayok = call_script( descriptor.destroy_script, item->make_ref() );
-        if ( !decayok )
-          continue;
+        recheck_decay( item, now + DECAY_RECHECK );
+        continue;
       }
-
-      item->spill_contents( multi );
-      destroy_item( item );
-      --idx;
     }
+
+    item->spill_contents( multi );
+    destroy_item( item );
   }
 }
 
 
 ///
-/// [3] Decay Sweep
-///     Each 64x64 tile World Zone is checked for decay approximately
-///     once every 10 minutes
+/// [3] Decay Queue
+///     Every realm keeps the items lying in the world ordered by their decay time,
+///     the decay threads only look at the items which are due.
+///     Items which cannot decay yet (in use, on a multi, refused by CanDecay or the
+///     DestroyScript) are checked again after 10 minutes.
 ///
 
-void decay_single_zone( Realms::Realm* realm, unsigned gridx, unsigned gridy, unsigned& wx,
-                        unsigned& wy )
-{
-  if ( ++wx >= gridx )
-  {
-    wx = 0;
-    if ( ++wy >= gridy )
-    {
-      wy = 0;
-    }
-  }
-  decay_worldzone( wx, wy, realm );
-}
-
 void decay_thread( void* arg )  // Realm*
 {
-  unsigned wx = ~0u;
-  unsigned wy = 0;
   Realms::Realm* realm = static_cast<Realms::Realm*>( arg );
 
-  unsigned gridwidth = realm->grid_width();
-  unsigned gridheight = realm->grid_height();
-
-  unsigned sleeptime = ( 60 * 10L * 1000 ) / ( gridwidth * gridheight );
   while ( !Clib::exit_signalled )
   {
     {
       PolLock lck;
       polclock_checkin();
-      decay_single_zone( realm, gridwidth, gridheight, wx, wy );
+      decay_realm( realm );
       restart_all_clients();
     }
-    // sweep entire world every 10 minutes
-    // (60 * 10 * 1000) / (96 * 64) -> (600000 / 6144) -> 97 ms
-
-    pol_sleep_ms( sleeptime );
+    pol_sleep_ms( 1000 );
   }
 }
 
 void decay_thread_shadow( void* arg )  // Realm*
 {
-  unsigned wx = ~0u;
-  unsigned wy = 0;
   unsigned id = static_cast<Realms::Realm*>( arg )->shadowid;
 
   if ( gamestate.shadowrealms_by_id[id] == nullptr )
     return;
-  unsigned gridwidth = gamestate.shadowrealms_by_id[id]->grid_width();
-  unsigned gridheight = gamestate.shadowrealms_by_id[id]->grid_height();
 
-  unsigned sleeptime = ( 60 * 10L * 1000 ) / ( gridwidth * gridheight );
   while ( !Clib::exit_signalled )
   {
     {
@@ -174,110 +200,52 @@ void decay_thread_shadow( void* arg )  // Realm*
       polclock_checkin();
       if ( gamestate.shadowrealms_by_id[id] == nullptr )  // is realm still there?
         break;
-      decay_single_zone( gamestate.shadowrealms_by_id[id], gridwidth, gridheight, wx, wy );
+      decay_realm( gamestate.shadowrealms_by_id[id] );
       restart_all_clients();
     }
-    // sweep entire world every 10 minutes
-    // (60 * 10 * 1000) / (96 * 64) -> (600000 / 6144) -> 97 ms
-
-    pol_sleep_ms( sleeptime );
+    pol_sleep_ms( 1000 );
   }
 }
 
-bool should_switch_realm( size_t index, unsigned x, unsigned y, unsigned* gridx, unsigned* gridy )
-{
-  (void)x;
-  if ( index >= gamestate.Realms.size() )
-    return true;
-  Realms::Realm* realm = gamestate.Realms[index];
-  if ( realm == nullptr )
-    return true;
-
-  ( *gridx ) = realm->grid_width();
-  ( *gridy ) = realm->grid_height();
-
-  // check if ++y would result in reset
-  if ( y + 1 >= ( *gridy ) )
-    return true;
-  return false;
-}
-
 void decay_single_thread( void* arg )
 {
   (void)arg;
-  // calculate total grid count, based on current realms
-  unsigned total_grid_count = 0;
-  for ( const auto& realm : gamestate.Realms )
-  {
-    total_grid_count += ( realm->grid_width() * realm->grid_height() );
-  }
-  if ( !total_grid_count )
-  {
-    POLLOG_ERROR << "No realm grids?!\n";
-    return;
-  }
-  // sweep every realm ~10minutes -> 36ms for 6 realms
-  unsigned sleeptime = ( 60 * 10L * 1000 ) / total_grid_count;
-  sleeptime = std::max( sleeptime, 30u );  // limit to 30ms
-  bool init = true;
-  size_t realm_index = ~0u;
-  unsigned wx = 0;
-  unsigned wy = 0;
-  unsigned gridx = 0;
-  unsigned gridy = 0;
+  // statistics are reported every 10 minutes like the former sweep over all realms
+  const unsigned report_runs = 60 * 10;
+  unsigned runs = 0;
   while ( !Clib::exit_signalled )
   {
     {
       PolLock lck;
       polclock_checkin();
-      // check if realm_index is still valid and if y is still in valid range
-      if ( should_switch_realm( realm_index, wx, wy, &gridx, &gridy ) )
-      {
-        ++realm_index;
-        if ( realm_index >= gamestate.Realms.size() )
-        {
-          realm_index = 0;
-          if ( !init && Plib::systemstate.config.thread_decay_statistics )
-          {
-            stateManager.decay_statistics.decayed.update(
-                stateManager.decay_statistics.temp_count_decayed );
-            stateManager.decay_statistics.active_decay.update(
-                stateManager.decay_statistics.temp_count_active );
-            stateManager.decay_statistics.temp_count_decayed = 0;
-            stateManager.decay_statistics.temp_count_active = 0;
-            POLLOG_INFO.Format(
-                "DECAY STATISTICS: decayed: max {} mean {} variance {} runs {} active max {} mean "
-                "{} variance {} runs {}\n" )
-                << stateManager.decay_statistics.decayed.max()
-                << stateManager.decay_statistics.decayed.mean()
-                << stateManager.decay_statistics.decayed.variance()
-                << stateManager.decay_statistics.decayed.count()
-                << stateManager.decay_statistics.active_decay.max()
-                << stateManager.decay_statistics.active_decay.mean()
-                << stateManager.decay_statistics.active_decay.variance()
-                << stateManager.decay_statistics.active_decay.count();
-          }
-          init = false;
-        }
-        wx = 0;
-        wy = 0;
-      }
-      else
+      for ( const auto& realm : gamestate.Realms )
+        decay_realm( realm );
+      if ( ++runs >= report_runs && Plib::systemstate.config.thread_decay_statistics )
       {
-        if ( ++wx >= gridx )
-        {
-          wx = 0;
-          if ( ++wy >= gridy )
-          {
-            POLLOG_ERROR << "SHOULD NEVER HAPPEN\n";
-            wy = 0;
-          }
-        }
+        runs = 0;
+        for ( const auto& realm : gamestate.Realms )
+          stateManager.decay_statistics.temp_count_active += realm->decay_queue.size();
+        stateManager.decay_statistics.decayed.update(
+            stateManager.decay_statistics.temp_count_decayed );
+        stateManager.decay_statistics.active_decay.update(
+            stateManager.decay_statistics.temp_count_active );
+        stateManager.decay_statistics.temp_count_decayed = 0;
+        stateManager.decay_statistics.temp_count_active = 0;
+        POLLOG_INFO.Format(
+            "DECAY STATISTICS: decayed: max {} mean {} variance {} runs {} active max {} mean "
+            "{} variance {} runs {}\n" )
+            << stateManager.decay_statistics.decayed.max()
+            << stateManager.decay_statistics.decayed.mean()
+            << stateManager.decay_statistics.decayed.variance()
+            << stateManager.decay_statistics.decayed.count()
+            << stateManager.decay_statistics.active_decay.max()
+            << stateManager.decay_statistics.active_decay.mean()
+            << stateManager.decay_statistics.active_decay.variance()
+            << stateManager.decay_statistics.active_decay.count();
       }
-      decay_worldzone( wx, wy, gamestate.Realms[realm_index] );
       restart_all_clients();
     }
-    pol_sleep_ms( sleeptime );
+    pol_sleep_ms( 1000 );
   }
 }
 }  // namespace Core
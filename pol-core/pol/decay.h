@@ -6,10 +6,44 @@
 #ifndef __DECAY_H
 #define __DECAY_H
 
+#include "gameclck.h"
+#include "timerwheel.h"
+
 namespace Pol
 {
+namespace Items
+{
+class Item;
+}
 namespace Core
 {
+typedef TimerWheel<Items::Item, gameclock_t> DecayQueue;
+
+/**
+ * Decay state of an item lying in the world.
+ * Exists from add_item_to_world until remove_item_from_world, while the item can decay its node
+ * waits in the decay queue of its realm until the decay time.
+ */
+class DecayEntry
+{
+public:
+  explicit DecayEntry( Items::Item* item ) : node( item ), queue( nullptr ) {}
+  ~DecayEntry()
+  {
+    if ( node.linked() )
+      queue->erase( &node );
+  }
+  DecayEntry( const DecayEntry& ) = delete;
+  DecayEntry& operator=( const DecayEntry& ) = delete;
+
+  DecayQueue::Node node;
+  DecayQueue* queue;
+};
+
+void add_item_to_decay( Items::Item* item );
+void remove_item_from_decay( Items::Item* item );
+void schedule_decay( Items::Item* item );
+
 void decay_thread( void* );
 void decay_thread_shadow( void* );
 void decay_single_thread( void* );
@@ -4,6 +4,7 @@
 #include "../../clib/fileutil.h"
 #include "../../clib/logfacility.h"
 #include "../../plib/systemstate.h"
+#include "../uobject.h"
 #include "multidefs.h"
 #include "network.h"
 #include "object_storage.h"
@@ -77,6 +78,7 @@ void MemoryUsage::log()
   logs.push_back( std::make_pair( "ObjArmorSize", object_sizes.obj_armor_size ) );
   logs.push_back( std::make_pair( "ObjMultiCount", object_sizes.obj_multi_count ) );
   logs.push_back( std::make_pair( "ObjMultiSize", object_sizes.obj_multi_size ) );
+  logs.push_back( std::make_pair( "SnapshotTextSize", UObject::saved_text_bytes.load() ) );
   logs.push_back( std::make_pair( "BObjectAllocatorSize", Bscript::bobject_alloc.memsize ) );
   logs.push_back( std::make_pair( "UninitAllocatorSize", Bscript::uninit_alloc.memsize ) );
   logs.push_back( std::make_pair( "BLongAllocatorSize", Bscript::blong_alloc.memsize ) );
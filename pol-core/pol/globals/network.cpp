@@ -10,8 +10,10 @@
 #include "../accounts/account.h"
 #include "../mobile/charactr.h"
 #include "../network/auxclient.h"
+#include "../network/clientreactor.h"
 #include "../network/clienttransmit.h"
 #include "../network/cliface.h"
+#include "../network/gumpcache.h"
 #include "../network/msgfiltr.h"
 #include "../network/msghandl.h"
 #include "../network/packethooks.h"
@@ -51,10 +53,12 @@ NetworkManager::NetworkManager()
       ext_handler_table(),
       packetsSingleton( new Network::PacketsSingleton() ),
       clientTransmit( new Network::ClientTransmit() ),
+      clientReactor( nullptr ),
       auxthreadpool( new threadhelp::DynTaskThreadPool( "AuxPool" ) ),  // TODO: seems to work
                                                                         // activate by default?
                                                                         // maybe add a cfg entry for
                                                                         // max number of threads
+      gump_cache( new Network::GumpCache() ),
       banned_ips()
 {
   memset( ipaddr_str, 0, sizeof ipaddr_str );
@@ -99,6 +103,7 @@ void NetworkManager::kill_disconnected_clients()
 
 void NetworkManager::deinialize()
 {
+  clientReactor.reset();
   for ( auto& client : clients )
   {
     client->forceDisconnect();
@@ -115,6 +120,7 @@ void NetworkManager::deinialize()
   // unload_aux_service
   Clib::delete_all( auxservices );
   auxthreadpool.reset();
+  gump_cache->clear();
   banned_ips.clear();
 
   Network::deinit_sockets_library();
@@ -189,6 +195,7 @@ NetworkManager::Memory NetworkManager::estimateSize() const
   usage.misc += packetsSingleton->estimateSize();
   usage.misc += sizeof( Network::ClientTransmit );
   usage.misc += sizeof( threadhelp::DynTaskThreadPool );
+  usage.misc += gump_cache->estimateSize();
 
   usage.misc += 3 * sizeof( Network::IPRule* ) + banned_ips.capacity() * sizeof( Network::IPRule );
 
@@ -20,7 +20,9 @@ namespace Network
 {
 class AuxService;
 class Client;
+class ClientReactor;
 class ClientTransmit;
+class GumpCache;
 class PacketHookData;
 class PacketsSingleton;
 class UOClientInterface;
@@ -97,9 +99,14 @@ public:
   std::unique_ptr<Network::PacketsSingleton> packetsSingleton;
 
   std::unique_ptr<Network::ClientTransmit> clientTransmit;
+  // only set if pol.cfg NetworkReactorThreads is active
+  std::unique_ptr<Network::ClientReactor> clientReactor;
 
   std::unique_ptr<threadhelp::DynTaskThreadPool> auxthreadpool;
 
+  // compressed gump packets shared between all players
+  std::unique_ptr<Network::GumpCache> gump_cache;
+
   std::vector<Network::IPRule> banned_ips;
    
   struct Memory
@@ -40,58 +40,54 @@ void ObjectStorageManager::deinitialize()
 
 ObjectStorageManager::MemoryUsage ObjectStorageManager::estimateSize() const
 {
-  ObjectHash::OH_const_iterator hs_citr = objStorageManager.objecthash.begin(),
-                                hs_cend = objStorageManager.objecthash.end();
-
   MemoryUsage usage;
   memset( &usage, 0, sizeof( usage ) );
 
-  usage.objcount = std::distance( hs_citr, hs_cend );
+  usage.objcount = objStorageManager.objecthash.size();
 
-  for ( ; hs_citr != hs_cend; ++hs_citr )
-  {
-    size_t size = ( sizeof( void* ) * 3 + 1 ) / 2;
-    const UObjectRef& ref = ( *hs_citr ).second;
-    size += ref->estimatedSize();
+  objStorageManager.objecthash.ForEach( [&usage]( const UObject* obj ) {
+    // the table entry is counted with the index below
+    size_t size = obj->estimatedSize();
     usage.objsize += size;
-    if ( ref->isa( UOBJ_CLASS::CLASS_ITEM ) )
+    if ( obj->isa( UOBJ_CLASS::CLASS_ITEM ) )
     {
       usage.obj_item_size += size;
       usage.obj_item_count++;
     }
-    else if ( ref->isa( UOBJ_CLASS::CLASS_CONTAINER ) )
+    else if ( obj->isa( UOBJ_CLASS::CLASS_CONTAINER ) )
     {
       usage.obj_cont_size += size;
       usage.obj_cont_count++;
     }
-    else if ( ref->isa( UOBJ_CLASS::CLASS_CHARACTER ) )
+    else if ( obj->isa( UOBJ_CLASS::CLASS_CHARACTER ) )
     {
       usage.obj_char_size += size;
       usage.obj_char_count++;
     }
-    else if ( ref->isa( UOBJ_CLASS::CLASS_NPC ) )
+    else if ( obj->isa( UOBJ_CLASS::CLASS_NPC ) )
     {
       usage.obj_npc_size += size;
       usage.obj_npc_count++;
     }
-    else if ( ref->isa( UOBJ_CLASS::CLASS_WEAPON ) )
+    else if ( obj->isa( UOBJ_CLASS::CLASS_WEAPON ) )
     {
       usage.obj_weapon_size += size;
       usage.obj_weapon_count++;
     }
-    else if ( ref->isa( UOBJ_CLASS::CLASS_ARMOR ) )
+    else if ( obj->isa( UOBJ_CLASS::CLASS_ARMOR ) )
     {
       usage.obj_armor_size += size;
       usage.obj_armor_count++;
     }
-    else if ( ref->isa( UOBJ_CLASS::CLASS_MULTI ) )
+    else if ( obj->isa( UOBJ_CLASS::CLASS_MULTI ) )
     {
       usage.obj_multi_size += size;
       usage.obj_multi_count++;
     }
-  }
+  } );
 
   usage.misc = sizeof( ObjectStorageManager );
+  usage.misc += objecthash.estimatedIndexSize();
   usage.misc += 3 * sizeof( u32* ) + modified_serials.capacity() * sizeof( u32 );
   usage.misc += 3 * sizeof( u32* ) + deleted_serials.capacity() * sizeof( u32 );
 
@@ -47,8 +47,9 @@ void ScriptScheduler::deinitialize()
   Clib::delete_all( runlist );
   while ( !holdlist.empty() )
   {
-    delete ( ( *holdlist.begin() ).second );
-    holdlist.erase( holdlist.begin() );
+    UOExecutor* exec = *holdlist.begin();
+    holdlist.erase( exec->hold_itr() );
+    delete exec;
   }
   while ( !notimeoutholdlist.empty() )
   {
@@ -113,17 +114,17 @@ ScriptScheduler::Memory ScriptScheduler::estimateSize( bool verbose ) const
   }
   usage.script_count += ranlist.size();
 
+  usage.script_size += sizeof( HoldList );
   if ( verbose )
     verbose_w << "holdlist:\n";
   for ( const auto& hold : holdlist )
   {
-    if ( hold.second != nullptr )
+    if ( hold != nullptr )
     {
-      usage.script_size += hold.second->sizeEstimate();
+      usage.script_size += hold->sizeEstimate();
       if ( verbose )
-        verbose_w << hold.second->scriptname() << " " << hold.second->sizeEstimate() << "\n";
+        verbose_w << hold->scriptname() << " " << hold->sizeEstimate() << "\n";
     }
-    usage.script_size += sizeof( Core::polclock_t ) + ( sizeof( void* ) * 3 + 1 ) / 2;
   }
   usage.script_count += holdlist.size();
 
@@ -188,10 +189,11 @@ void ScriptScheduler::run_ready()
 
     while ( ex->runnable() )
     {
-      ++ex->instr_cycles;
       THREAD_CHECKPOINT( scripts, 112 );
       Clib::scripts_thread_scriptPC = ex->PC;
-      ex->execInstr();
+      // a fused instruction sequence counts as all of its instructions
+      const int executed = static_cast<int>( ex->execInstr() );
+      ex->instr_cycles += executed;
 
       THREAD_CHECKPOINT( scripts, 113 );
 
@@ -203,7 +205,7 @@ void ScriptScheduler::run_ready()
         break;
       }
 
-      if ( ex->instr_cycles == ex->warn_runaway_on_cycle )
+      if ( ex->instr_cycles >= ex->warn_runaway_on_cycle )
       {
         ex->runaway_cycles += Plib::systemstate.config.runaway_script_threshold;
         if ( ex->warn_on_runaway() )
@@ -219,8 +221,8 @@ void ScriptScheduler::run_ready()
 
       if ( ex->critical() )
       {
-        ++inscount;
-        ++totcount;
+        inscount += executed;
+        totcount += executed;
         if ( inscount > 1000 )
         {
           inscount = 0;
@@ -236,7 +238,8 @@ void ScriptScheduler::run_ready()
         continue;
       }
 
-      if ( !--insleft )
+      insleft -= executed;
+      if ( insleft <= 0 )
       {
         break;
       }
@@ -288,7 +291,7 @@ void ScriptScheduler::run_ready()
       if ( ex->sleep_until_clock() )
       {
         ex->in_hold_list( Core::HoldListType::TIMEOUT_LIST );
-        ex->hold_itr( holdlist.insert( HoldList::value_type( ex->sleep_until_clock(), ex ) ) );
+        ex->hold_itr( holdlist.insert( &ex->hold_node, ex->sleep_until_clock() ) );
       }
       else
       {
@@ -375,8 +378,8 @@ bool ScriptScheduler::logScriptVariables( const std::string& name ) const
   }
   for ( const auto& exec : holdlist )
   {
-    if ( exec.second != nullptr && stricmp( exec.second->scriptname().c_str(), name.c_str() ) == 0 )
-      scripts.push_back( exec.second );
+    if ( exec != nullptr && stricmp( exec->scriptname().c_str(), name.c_str() ) == 0 )
+      scripts.push_back( exec );
   }
   for ( const auto& exec : notimeoutholdlist )
   {
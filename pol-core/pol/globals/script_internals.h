@@ -9,6 +9,7 @@
 #include "../../clib/maputil.h"
 #include "../polclock.h"
 #include "../reftypes.h"
+#include "../timerwheel.h"
 
 namespace Pol
 {
@@ -18,10 +19,11 @@ class UOExecutor;
 
 typedef std::deque<UOExecutor*> ExecList;
 typedef std::set<UOExecutor*> NoTimeoutHoldList;
-typedef std::multimap<Core::polclock_t, Core::UOExecutor*> HoldList;
+// sleeping scripts with timeout, the node is part of the UOExecutor
+typedef TimerWheel<UOExecutor, polclock_t> HoldList;
 typedef std::map<std::string, ref_ptr<Bscript::EScriptProgram>, Clib::ci_cmp_pred> ScriptStorage;
 typedef std::map<unsigned int, UOExecutor*> PidList;
-typedef HoldList::iterator TimeoutHandle;
+typedef HoldList::Node* TimeoutHandle;
 
 
 enum HoldListType
@@ -84,6 +86,8 @@ public:
   void revive_timeout( UOExecutor* exec, TimeoutHandle hold_itr );
   void revive_notimeout( UOExecutor* exec );
   void revive_debugged( UOExecutor* exec );
+  // next sleeping script whose timeout is reached, stays in the holdlist until revived
+  UOExecutor* next_expired( polclock_t now );
 
   // Adds a new executor to the queue directly
   void enqueue( UOExecutor* exec );
@@ -148,6 +152,11 @@ inline void ScriptScheduler::revive_timeout( UOExecutor* exec, TimeoutHandle hol
   enqueue( exec );
 }
 
+inline UOExecutor* ScriptScheduler::next_expired( polclock_t now )
+{
+  return holdlist.next_expired( now );
+}
+
 inline void ScriptScheduler::revive_notimeout( UOExecutor* exec )
 {
   notimeoutholdlist.erase( exec );
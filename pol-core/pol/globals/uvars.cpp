@@ -27,6 +27,7 @@
 #include "../accounts/accounts.h"
 #include "../checkpnt.h"
 #include "../console.h"
+#include "../decay.h"
 #include "../guardrgn.h"
 #include "../guilds.h"
 #include "../item/equipmnt.h"
@@ -84,8 +85,12 @@ GameState::GameState()
       // Using force allocate because this is inited before reading global CProp setting
       global_properties( new Core::PropertyList( CPropProfiler::Type::GLOBAL, true ) ),
       accounts(),
+      accounts_by_name(),
+      changed_accounts(),
+      account_journal_records( 0 ),
       startlocations(),
       wrestling_weapon( nullptr ),
+      region_index(),
       justicedef( nullptr ),
       nocastdef( nullptr ),
       lightdef( nullptr ),
@@ -145,6 +150,7 @@ GameState::GameState()
       pVitalStamina( nullptr ),
       pVitalMana( nullptr ),
       vitals_byname(),
+      regen_characters(),
       desctable(),
       old_objtype_conversions(),
       dynamic_item_descriptors(),
@@ -164,6 +170,7 @@ GameState::GameState()
       landtiles(),
       landtiles_loaded( false ),
       listen_points(),
+      listen_point_index(),
       wwwroot_pkg( nullptr ),
       mime_types(),
       task_queue(),
@@ -270,6 +277,7 @@ void GameState::cleanup_vars()
     for ( int i = 0; i < Plib::systemstate.config.character_slots; i++ )
       account->clear_character( i );
   }
+  regen_characters.clear();
 
   for ( auto& realm : Realms )
   {
@@ -282,9 +290,11 @@ void GameState::cleanup_vars()
       {
         for ( auto& item : realm->zone[wx][wy].items )
         {
+          Core::remove_item_from_decay( item );
           item->destroy();
         }
         realm->zone[wx][wy].items.clear();
+        realm->zone[wx][wy].item_blocks.clear();
       }
     }
 
@@ -325,6 +335,8 @@ void GameState::cleanup_vars()
   // and Nando placed it outside the Realms' loop in 2009-01-18.
   objStorageManager.objecthash.ClearCharacterAccountReferences();
 
+  accounts_by_name.clear();
+  changed_accounts.clear();
   accounts.clear();
   Clib::delete_all( startlocations );
 
@@ -371,6 +383,7 @@ void GameState::clear_listen_points()
     lp_pair.second = nullptr;
   }
   listen_points.clear();
+  listen_point_index.clear();
 }
 
 void GameState::unload_intrinsic_weapons()
@@ -437,6 +450,9 @@ GameState::Memory GameState::estimateSize() const
 
   usage.account_count = accounts.size();
   usage.account_size += 3 * sizeof( AccountRef* ) + accounts.capacity() * sizeof( AccountRef );
+  usage.account_size +=
+      accounts_by_name.bucket_count() * sizeof( void* ) +
+      accounts_by_name.size() * ( sizeof( AccountsIndex::value_type ) + 2 * sizeof( void* ) );
   for ( const auto& acc : accounts )
   {
     if ( acc.get() != nullptr )
@@ -449,6 +465,7 @@ GameState::Memory GameState::estimateSize() const
       usage.misc += loc->estimateSize();
   }
 
+  usage.misc += region_index.estimateSize();
   if ( justicedef != nullptr )
     usage.misc += justicedef->estimateSize();
   if ( nocastdef != nullptr )
@@ -530,6 +547,8 @@ GameState::Memory GameState::estimateSize() const
   }
   for ( const auto& vital : vitals_byname )
     usage.misc += vital.first.capacity() + sizeof( Vital* ) + ( sizeof( void* ) * 3 + 1 ) / 2;
+  usage.misc +=
+      3 * sizeof( CharacterRef* ) + regen_characters.capacity() * sizeof( CharacterRef );
 
 
   usage.misc += ( sizeof( u32 ) + sizeof( Items::ItemDesc* ) + ( sizeof( void* ) * 3 + 1 ) / 2 ) *
@@ -582,6 +601,7 @@ GameState::Memory GameState::estimateSize() const
   usage.misc += ( sizeof( UOExecutor* ) + sizeof( ListenPoint* ) + sizeof( ListenPoint ) +
                   ( sizeof( void* ) * 3 + 1 ) / 2 ) *
                 listen_points.size();
+  usage.misc += listen_point_index.estimateSize();
   for ( const auto& elem : mime_types )
   {
     usage.misc += elem.first.capacity() + elem.second.capacity() + ( sizeof( void* ) * 3 + 1 ) / 2;
@@ -13,6 +13,7 @@
 #include <queue>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -24,6 +25,7 @@
 #include "../action.h"
 #include "../cmdlevel.h"
 #include "../layers.h"
+#include "../listenpt.h"
 #include "../menu.h"
 #include "../reftypes.h"
 #include "../region.h"
@@ -68,7 +70,6 @@ class ConsoleCommand;
 class Guild;
 class JusticeRegion;
 class LightRegion;
-class ListenPoint;
 class MusicRegion;
 class NoCastRegion;
 class NpcTemplate;
@@ -86,6 +87,7 @@ class WeatherDef;
 typedef std::vector<Core::CmdLevel> CmdLevels;
 
 typedef std::vector<AccountRef> AccountsVector;
+typedef std::unordered_map<std::string, Accounts::Account*> AccountsIndex;
 class ItemsVector : public std::vector<Items::Item*>
 {
 };
@@ -145,9 +147,13 @@ public:
   std::unique_ptr<Core::PropertyList> global_properties;
 
   AccountsVector accounts;
+  AccountsIndex accounts_by_name;          // lowercase name, kept in sync with accounts
+  std::set<std::string> changed_accounts;  // lowercase names not yet in the account journal
+  unsigned int account_journal_records;
   StartingLocations startlocations;
   Items::UWeapon* wrestling_weapon;
 
+  RegionIndex region_index;
   JusticeDef* justicedef;
   NoCastDef* nocastdef;
   LightDef* lightdef;
@@ -205,6 +211,8 @@ public:
   const Vital* pVitalStamina;
   const Vital* pVitalMana;
   VitalsByName vitals_byname;
+  // the characters regen_stats visits, see Mobile::Character::queue_regen
+  std::vector<CharacterRef> regen_characters;
 
   std::map<u32, Items::ItemDesc*> desctable;
   OldObjtypeConversions old_objtype_conversions;
@@ -228,6 +236,7 @@ public:
   bool landtiles_loaded;
 
   ListenPoints listen_points;
+  ListenPointIndex listen_point_index;
 
   Plib::Package* wwwroot_pkg;
   std::map<std::string, std::string> mime_types;
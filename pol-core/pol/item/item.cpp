@@ -25,6 +25,7 @@
 #include "../../plib/mapcell.h"
 #include "../../plib/systemstate.h"
 #include "../containr.h"
+#include "../decay.h"
 #include "../gameclck.h"
 #include "../globals/uvars.h"
 #include "../mobile/charactr.h"
@@ -968,6 +969,7 @@ void Item::on_color_changed()
 void Item::on_movable_changed()
 {
   update_item_to_inrange( this );
+  Core::schedule_decay( this );
 }
 
 void Item::on_invisible_changed()
@@ -1048,6 +1050,7 @@ void Item::set_decay_after( unsigned int seconds )
   if ( decayat_gameclock_ != 0 )
   {
     decayat_gameclock_ = Core::read_gameclock() + seconds;
+    Core::schedule_decay( this );
   }
 }
 
@@ -1078,6 +1081,7 @@ void Item::disable_decay()
 {
   set_dirty();
   decayat_gameclock_ = 0;
+  Core::schedule_decay( this );
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -11,6 +11,7 @@
 
 #include "pol_global_config.h"
 
+#include <memory>
 #include <stddef.h>
 #include <string>
 
@@ -48,6 +49,7 @@ class UOExecutorModule;
 }
 namespace Core
 {
+class DecayEntry;
 class UContainer;
 class UOExecutor;
 
@@ -262,6 +264,7 @@ public:
   Core::UContainer* container;
 
   unsigned int decayat_gameclock_;
+  std::unique_ptr<Core::DecayEntry> decay_entry;  // only while the item lies in the world
   double getItemdescQuality() const;
   boost_utils::script_name_flystring on_use_script_;
   boost_utils::script_name_flystring equip_script_;
@@ -10,6 +10,7 @@
 #include <stddef.h>
 
 #include "../baseobject.h"
+#include "../decay.h"
 #include "../gameclck.h"
 #include "../globals/state.h"
 #include "../resource.h"
@@ -26,6 +27,7 @@ Item::Item( const ItemDesc& id, Core::UOBJ_CLASS uobj_class )
     : UObject( id.objtype, uobj_class ),
       container( nullptr ),
       decayat_gameclock_( 0 ),
+      decay_entry(),
       amount_( 1 ),
       slot_index_( 0 ),
       _itemdesc( nullptr ),
@@ -59,6 +61,7 @@ size_t Item::estimatedSize() const
 {
   return base::estimatedSize() + sizeof( Core::UContainer* ) /* container*/
          + sizeof( int )                                     /* decayat_gameclock_*/
+         + sizeof( std::unique_ptr<Core::DecayEntry> )       /* decay_entry*/
          + sizeof( u16 )                                     /* amount_*/
          + sizeof( u8 )                                      /* slot_index_*/
          + sizeof( const ItemDesc* )                         /* _itemdesc*/
@@ -7,6 +7,7 @@
 
 #include "listenpt.h"
 
+#include <algorithm>
 #include <stddef.h>
 
 #include "../bscript/bobject.h"
@@ -17,6 +18,7 @@
 #include "ufunc.h"
 #include "uoexec.h"
 #include "uoscrobj.h"
+#include "uworld.h"
 
 namespace Pol
 {
@@ -44,73 +46,153 @@ const char* TextTypeToString( u8 texttype )
   }
 }
 
-void sayto_listening_points( Mobile::Character* speaker, const std::string& text, u8 texttype,
-                             const char* p_lang, Bscript::ObjArray* speechtokens )
+bool ListenPointIndex::in_zones( const ListenPoint* lp )
 {
-  for ( ListenPoints::iterator itr = gamestate.listen_points.begin(),
-                               end = gamestate.listen_points.end();
-        itr != end; )
+  return lp->object->isa( UOBJ_CLASS::CLASS_NPC ) && lp->range <= MAX_ZONE_RANGE;
+}
+
+void ListenPointIndex::add( ListenPoint* lp )
+{
+  if ( in_zones( lp ) )
   {
-    ListenPoint* lp = ( *itr ).second;
-    if ( lp->object->orphan() )
-    {
-      ListenPoints::iterator next = itr;
-      ++next;
-      gamestate.listen_points.erase( itr );
-      delete lp;
-      itr = next;
-      end = gamestate.listen_points.end();
-    }
-    else
+    _npcs.emplace( lp->object.get(), lp );
+    ++_npc_ranges[lp->range];
+  }
+  else
+    _others.push_back( lp );
+}
+
+void ListenPointIndex::remove( ListenPoint* lp )
+{
+  if ( in_zones( lp ) )
+  {
+    auto range = _npcs.equal_range( lp->object.get() );
+    for ( auto itr = range.first; itr != range.second; ++itr )
     {
-      if ( !speaker->dead() || ( lp->flags & LISTENPT_HEAR_GHOSTS ) )
+      if ( itr->second == lp )
       {
-        if ( settingsManager.ssopt.seperate_speechtoken )
-        {
-          if ( speechtokens != nullptr && ( ( lp->flags & LISTENPT_HEAR_TOKENS ) == 0 ) )
-          {
-            ++itr;
-            continue;
-          }
-          else if ( speechtokens == nullptr && ( lp->flags & LISTENPT_NO_SPEECH ) )
-          {
-            ++itr;
-            continue;
-          }
-        }
-        const UObject* toplevel = lp->object->toplevel_owner();
-        if ( ( speaker->realm == toplevel->realm ) &&
-             ( inrangex( speaker, toplevel->x, toplevel->y, lp->range ) ) )
-        {
-          if ( p_lang )
-            lp->uoexec->signal_event( new Module::SpeechEvent(
-                speaker, text, TextTypeToString( texttype ), p_lang, speechtokens ) );
-          else
-            lp->uoexec->signal_event(
-                new Module::SpeechEvent( speaker, text, TextTypeToString( texttype ) ) );
-        }
+        _npcs.erase( itr );
+        auto count = _npc_ranges.find( lp->range );
+        if ( count != _npc_ranges.end() && --count->second == 0 )
+          _npc_ranges.erase( count );
+        return;
       }
-      ++itr;
+    }
+  }
+  else
+  {
+    auto itr = std::find( _others.begin(), _others.end(), lp );
+    if ( itr != _others.end() )
+    {
+      *itr = _others.back();
+      _others.pop_back();
     }
   }
 }
 
-void deregister_from_speech_events( UOExecutor* uoexec )
+void ListenPointIndex::clear()
+{
+  _npcs.clear();
+  _npc_ranges.clear();
+  _others.clear();
+}
+
+size_t ListenPointIndex::estimateSize() const
+{
+  return sizeof( ListenPointIndex ) +
+         _npcs.size() * ( sizeof( void* ) + sizeof( UObject* ) + sizeof( ListenPoint* ) ) +
+         _npcs.bucket_count() * sizeof( void* ) +
+         _npc_ranges.size() * ( sizeof( int ) + sizeof( unsigned ) + 3 * sizeof( void* ) ) +
+         _others.capacity() * sizeof( ListenPoint* );
+}
+
+int ListenPointIndex::max_npc_range() const
+{
+  if ( _npc_ranges.empty() )
+    return -1;
+  return _npc_ranges.rbegin()->first;
+}
+
+namespace
+{
+void erase_listen_point( UOExecutor* uoexec )
 {
-  // ListenPoint lp( nullptr, uoexec, 0, 0 );
   ListenPoints::iterator itr = gamestate.listen_points.find( uoexec );
-  if ( itr !=
-       gamestate.listen_points.end() )  // could have been cleaned up in sayto_listening_points
+  if ( itr != gamestate.listen_points.end() )
   {
     ListenPoint* lp = ( *itr ).second;
-    gamestate.listen_points.erase( uoexec );
+    gamestate.listen_points.erase( itr );
+    if ( lp != nullptr )
+      gamestate.listen_point_index.remove( lp );
     delete lp;
   }
 }
+}  // namespace
+
+void sayto_listening_points( Mobile::Character* speaker, const std::string& text, u8 texttype,
+                             const char* p_lang, Bscript::ObjArray* speechtokens )
+{
+  auto hear = [&]( ListenPoint* lp ) {
+    if ( speaker->dead() && !( lp->flags & LISTENPT_HEAR_GHOSTS ) )
+      return;
+    if ( settingsManager.ssopt.seperate_speechtoken )
+    {
+      if ( speechtokens != nullptr && ( ( lp->flags & LISTENPT_HEAR_TOKENS ) == 0 ) )
+        return;
+      else if ( speechtokens == nullptr && ( lp->flags & LISTENPT_NO_SPEECH ) )
+        return;
+    }
+    if ( p_lang )
+      lp->uoexec->signal_event( new Module::SpeechEvent(
+          speaker, text, TextTypeToString( texttype ), p_lang, speechtokens ) );
+    else
+      lp->uoexec->signal_event(
+          new Module::SpeechEvent( speaker, text, TextTypeToString( texttype ) ) );
+  };
+
+  // npcs are in the world zones, orphans are not
+  const ListenPointIndex& index = gamestate.listen_point_index;
+  int max_range = index.max_npc_range();
+  if ( max_range >= 0 )
+  {
+    WorldIterator<NPCFilter>::InRange(
+        speaker->x, speaker->y, speaker->realm, max_range, [&]( Mobile::Character* chr ) {
+          index.forEachOfNpc( chr, [&]( ListenPoint* lp ) {
+            if ( inrangex( speaker, chr->x, chr->y, lp->range ) )
+              hear( lp );
+          } );
+        } );
+  }
+
+  std::vector<UOExecutor*> orphans;
+  for ( ListenPoint* lp : index.others() )
+  {
+    if ( lp->object->orphan() )
+    {
+      orphans.push_back( lp->uoexec );
+      continue;
+    }
+    const UObject* toplevel = lp->object->toplevel_owner();
+    if ( ( speaker->realm == toplevel->realm ) &&
+         ( inrangex( speaker, toplevel->x, toplevel->y, lp->range ) ) )
+      hear( lp );
+  }
+  for ( UOExecutor* uoexec : orphans )
+    erase_listen_point( uoexec );
+}
+
+void deregister_from_speech_events( UOExecutor* uoexec )
+{
+  // could have been cleaned up in sayto_listening_points
+  erase_listen_point( uoexec );
+}
 
 void register_for_speech_events( UObject* obj, UOExecutor* uoexec, int range, int flags )
 {
-  gamestate.listen_points[uoexec] = new ListenPoint( obj, uoexec, range, flags );
+  erase_listen_point( uoexec );
+  ListenPoint* lp = new ListenPoint( obj, uoexec, range, flags );
+  gamestate.listen_points[uoexec] = lp;
+  gamestate.listen_point_index.add( lp );
 }
 
 Bscript::BObjectImp* GetListenPoints()
@@ -126,6 +208,8 @@ Bscript::BObjectImp* GetListenPoints()
       ListenPoints::iterator next = itr;
       ++next;
       gamestate.listen_points.erase( itr );
+      if ( lp != nullptr )
+        gamestate.listen_point_index.remove( lp );
       delete lp;
       itr = next;
       end = gamestate.listen_points.end();
@@ -7,9 +7,15 @@
 #ifndef LISTENPT_H
 #define LISTENPT_H
 
+#include <map>
+#include <stddef.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "../clib/rawtypes.h"
+#include "../plib/uconst.h"
 #include "reftypes.h"
-#include <string>
 
 namespace Pol
 {
@@ -39,6 +45,43 @@ public:
   int flags;
 };
 
+/**
+ * Spatial lookup of the listen points, owned by gamestate.listen_points.
+ * Listen points of npcs are found through the world zones around the speaker, so speech only
+ * visits the npcs within the largest registered range. Npcs are always in the zones, player
+ * characters are not while logged out, so they are checked one by one like the items, which
+ * can be inside of containers. So are npcs listening further than MAX_ZONE_RANGE, the zones
+ * around the speaker would cost more than the list.
+ */
+class ListenPointIndex
+{
+public:
+  static const int MAX_ZONE_RANGE = 4 * RANGE_VISUAL;
+
+  void add( ListenPoint* lp );
+  void remove( ListenPoint* lp );
+  void clear();
+  size_t estimateSize() const;
+
+  // largest range of the npc listen points in the zones, -1 if there are none
+  int max_npc_range() const;
+  template <typename F>
+  void forEachOfNpc( const UObject* npc, F&& f ) const
+  {
+    auto range = _npcs.equal_range( npc );
+    for ( auto itr = range.first; itr != range.second; ++itr )
+      f( itr->second );
+  }
+  const std::vector<ListenPoint*>& others() const { return _others; }
+
+private:
+  static bool in_zones( const ListenPoint* lp );
+
+  std::unordered_multimap<const UObject*, ListenPoint*> _npcs;
+  std::map<int, unsigned> _npc_ranges;  // range -> number of npc listen points
+  std::vector<ListenPoint*> _others;
+};
+
 const char* TextTypeToString( u8 texttype );
 
 void sayto_listening_points( Mobile::Character* speaker, const std::string& text, u8 texttype,
@@ -72,38 +72,9 @@ size_t WeatherRegion::estimateSize() const
          + sizeof( int );                                   /*lightoverride*/
 }
 
-WeatherDef::WeatherDef( const char* name ) : RegionGroup<WeatherRegion>( name )
-{
-  for ( auto const& realm : gamestate.Realms )
-  {
-    unsigned int gridwidth = realm->width() / ZONE_SIZE;
-    unsigned int gridheight = realm->height() / ZONE_SIZE;
-
-    RegionId** zone = new RegionId*[gridwidth];
-
-    for ( unsigned int i = 0; i < gridwidth; i++ )
-    {
-      zone[i] = new RegionId[gridheight];
-      for ( unsigned int j = 0; j < gridheight; j++ )
-      {
-        zone[i][j] = 0;
-      }
-    }
-    default_regionrealms.insert( std::make_pair( realm, zone ) );
-  }
-}
-
-WeatherDef::~WeatherDef()
-{
-  for ( auto& realmregion : default_regionrealms )
-  {
-    unsigned int gridwidth = realmregion.first->width() / ZONE_SIZE;
+WeatherDef::WeatherDef( const char* name ) : RegionGroup<WeatherRegion>( name ) {}
 
-    for ( unsigned int i = 0; i < gridwidth; i++ )
-      delete[] realmregion.second[i];
-    delete[] realmregion.second;
-  }
-}
+WeatherDef::~WeatherDef() {}
 
 size_t WeatherDef::estimateSize() const
 {
@@ -111,28 +82,22 @@ size_t WeatherDef::estimateSize() const
 
   for ( const auto& realm : default_regionrealms )
   {
-    unsigned int gridwidth = realm.first->width() / ZONE_SIZE;
-    size +=
-        gridwidth * sizeof( RegionId ) + sizeof( Realms::Realm* ) + ( sizeof( void* ) * 3 + 1 ) / 2;
+    size += realm.second.estimateSize() + sizeof( Realms::Realm* ) +
+            ( sizeof( void* ) * 3 + 1 ) / 2;
   }
   return size;
 }
 
 void WeatherDef::copy_default_regions()
 {
-  for ( auto& realmregion : regionrealms )
+  for ( const auto& realmregion : regionrealms )
   {
     Realms::Realm* realm = realmregion.first;
     unsigned int gridwidth = realm->width() / ZONE_SIZE;
     unsigned int gridheight = realm->height() / ZONE_SIZE;
 
-    for ( unsigned int i = 0; i < gridwidth; i++ )
-    {
-      for ( unsigned int j = 0; j < gridheight; j++ )
-      {
-        default_regionrealms[realm][i][j] = regionrealms[realm][i][j];
-      }
-    }
+    auto itr = default_regionrealms.emplace( realm, RegionRaster( gridwidth, gridheight ) ).first;
+    itr->second.copy( realmregion.second, 0, 0, gridwidth - 1, gridheight - 1 );
   }
 }
 
@@ -161,13 +126,9 @@ bool WeatherDef::assign_zones_to_region( const char* regionname, unsigned short
     std::tie( zone_xwest, zone_ynorth ) = XyToZone( xwest, ynorth );
     std::tie( zone_xeast, zone_ysouth ) = XyToZone( xeast, ysouth );
 
-    for ( auto zx = zone_xwest; zx <= zone_xeast; ++zx )
-    {
-      for ( auto zy = zone_ynorth; zy <= zone_ysouth; ++zy )
-      {
-        regionrealms[realm][zx][zy] = rgn->regionid();
-      }
-    }
+    regionrealms.at( realm ).paint( zone_xwest, zone_ynorth, zone_xeast, zone_ysouth,
+                                    rgn->regionid() );
+    gamestate.region_index.painted( realm, zone_xwest, zone_ynorth, zone_xeast, zone_ysouth );
   }
   else  // move 'em back to the default
   {
@@ -175,13 +136,9 @@ bool WeatherDef::assign_zones_to_region( const char* regionname, unsigned short
     std::tie( zone_xwest, zone_ynorth ) = XyToZone( xwest, ynorth );
     std::tie( zone_xeast, zone_ysouth ) = XyToZone( xeast, ysouth );
 
-    for ( auto zx = zone_xwest; zx <= zone_xeast; ++zx )
-    {
-      for ( auto zy = zone_ynorth; zy <= zone_ysouth; ++zy )
-      {
-        regionrealms[realm][zx][zy] = default_regionrealms[realm][zx][zy];
-      }
-    }
+    regionrealms.at( realm ).copy( default_regionrealms.at( realm ), zone_xwest, zone_ynorth,
+                                   zone_xeast, zone_ysouth );
+    gamestate.region_index.painted( realm, zone_xwest, zone_ynorth, zone_xeast, zone_ysouth );
   }
   update_all_weatherregions();
   return true;
@@ -1007,6 +1007,7 @@ void Character::readAttributesAndVitals( Clib::ConfigElem& elem )
           elem.throw_error( "Character " + Clib::hexint( serial ) + " vital " + _i +
                             " is out of range" );
         vv.current_ones( temp );
+        queue_regen();
         break;
       }
     }
@@ -1464,6 +1465,7 @@ void Character::produce( const Core::Vital* pVital, VitalValue& vv, unsigned int
 {
   int start_ones = vv.current_ones();
   set_dirty();
+  queue_regen();
   vv.produce( amt );
   if ( start_ones != vv.current_ones() )
     Network::ClientInterface::tell_vital_changed( this, pVital );
@@ -1474,6 +1476,7 @@ bool Character::consume( const Core::Vital* pVital, VitalValue& vv, unsigned int
 {
   int start_ones = vv.current_ones();
   set_dirty();
+  queue_regen();
   bool res = vv.consume( amt );
   if ( start_ones != vv.current_ones() )
   {
@@ -1490,6 +1493,7 @@ void Character::set_current_ones( const Core::Vital* pVital, VitalValue& vv, uns
 {
   int start_ones = vv.current_ones();
   set_dirty();
+  queue_regen();
   vv.current_ones( ones );
   Network::ClientInterface::tell_vital_changed( this, pVital );
   if ( start_ones != 0 && vv.current_ones() == 0 && pVital->depleted_func != nullptr )
@@ -1502,6 +1506,7 @@ void Character::set_current( const Core::Vital* pVital, VitalValue& vv, unsigned
 {
   int start_ones = vv.current_ones();
   set_dirty();
+  queue_regen();
   vv.current( ones );
   Network::ClientInterface::tell_vital_changed( this, pVital );
   if ( start_ones != 0 && vv.current_ones() == 0 && pVital->depleted_func != nullptr )
@@ -1512,6 +1517,9 @@ void Character::set_current( const Core::Vital* pVital, VitalValue& vv, unsigned
 void Character::regen_vital( const Core::Vital* pVital )
 {
   VitalValue& vv = vital( pVital->vitalid );
+  // full (or empty) vitals would only mark the character dirty
+  if ( vv.regen_idle() )
+    return;
   int rr = vv.regenrate();
   if ( rr > 0 )
     produce( pVital, vv, rr / 12 );
@@ -1519,6 +1527,34 @@ void Character::regen_vital( const Core::Vital* pVital )
     consume( pVital, vv, -rr / 12, VitalDepletedReason::REGENERATE );
 }
 
+void Character::queue_regen()
+{
+  if ( mob_flags_.get( MOB_FLAGS::REGEN_QUEUED ) )
+    return;
+  mob_flags_.set( MOB_FLAGS::REGEN_QUEUED );
+  Core::gamestate.regen_characters.push_back( Core::CharacterRef( this ) );
+}
+
+bool Character::regen_pending() const
+{
+  for ( unsigned vi = 0; vi < Core::gamestate.numVitals; ++vi )
+  {
+    if ( !vital( vi ).regen_idle() )
+      return true;
+  }
+  if ( has_lightoverride() && lightoverride_until() != ~0u )
+    return true;
+  if ( has_dblclick_wait() || has_disable_skills_until() )
+    return true;
+  // check_undamaged still has to clear them
+  return !to_be_reportable_.empty();
+}
+
+void Character::dequeue_regen()
+{
+  mob_flags_.remove( MOB_FLAGS::REGEN_QUEUED );
+}
+
 void Character::calc_vital_stuff( bool i_mod, bool v_mod )
 {
   if ( i_mod )
@@ -1563,6 +1599,7 @@ void Character::calc_single_vital( const Core::Vital* pVital )
     rr = Core::VITAL_HIGHEST_REGENRATE;
 
   vv.regenrate( rr );
+  queue_regen();
 
   if ( ( start_ones != vv.current_ones() ) || ( start_max != vv.maximum_ones() ) )
     Network::ClientInterface::tell_vital_changed( this, pVital );
@@ -1588,6 +1625,7 @@ void Character::calc_single_attribute( const Attribute* pAttr )
 void Character::set_vitals_to_maximum()  // throw()
 {
   set_dirty();
+  queue_regen();
   for ( unsigned vi = 0; vi < Core::gamestate.numVitals; ++vi )
   {
     VitalValue& vv = vital( vi );
@@ -1706,6 +1744,7 @@ void Character::on_aos_ext_stat_changed()
 
 void Character::setfacing( u8 newfacing )
 {
+  set_dirty();
   facing = newfacing & 7;
 }
 
@@ -4445,6 +4484,15 @@ int VitalValue::regenrate() const
 {
   return _regenrate;
 }
+bool VitalValue::regen_idle() const
+{
+  int amt = _regenrate / 12;
+  if ( amt > 0 )
+    return _current >= _maximum;
+  if ( amt < 0 )
+    return _current == 0;
+  return true;
+}
 void VitalValue::current( int cur )
 {
   _current = cur;
@@ -179,6 +179,8 @@ public:
   int maximum_ones() const;
   bool is_at_maximum() const;
   int regenrate() const;
+  // true if a regeneration tick would leave the value untouched
+  bool regen_idle() const;
   // mutators:
 protected:
   friend class Character;
@@ -262,6 +264,7 @@ enum class MOB_FLAGS : u16
   LOGGED_IN = 1 << 10,  // for NPCs, this is always true.
   CONNECTED = 1 << 11,
   USE_ADJUSTMENTS = 1 << 12,  // NPCs
+  REGEN_QUEUED = 1 << 13,     // in gamestate.regen_characters
 };
 
 // NOTES:
@@ -497,6 +500,12 @@ public:
   const VitalValue& vital( unsigned vitalid ) const;
   VitalValue& vital( unsigned vitalid );
   void regen_vital( const Core::Vital* );                         // throw()
+  // adds the character to gamestate.regen_characters, needed whenever a vital or one of the
+  // timed properties regen_stats clears changes
+  void queue_regen();
+  // true while regen_stats has something left to do for the character
+  bool regen_pending() const;
+  void dequeue_regen();
   void calc_vital_stuff( bool i_mod = true, bool v_mod = true );  // throw()
   void calc_single_vital( const Core::Vital* pVital );
   void calc_single_attribute( const Attribute* pAttr );
@@ -255,12 +255,13 @@ bool NPC::npc_path_blocked( Plib::UFACING fdir ) const
 
 void NPC::printOn( Clib::StreamWriter& sw ) const
 {
-  sw() << classname() << " " << template_name.get() << pf_endl;
-  sw() << "{" << pf_endl;
-  printProperties( sw );
-  sw() << "}" << pf_endl;
-  sw() << pf_endl;
-  // sw.flush();
+  printCached( sw, [this]( Clib::StreamWriter& out ) {
+    out() << classname() << " " << template_name.get() << pf_endl;
+    out() << "{" << pf_endl;
+    printProperties( out );
+    out() << "}" << pf_endl;
+    out() << pf_endl;
+  } );
 }
 
 void NPC::printSelfOn( Clib::StreamWriter& sw ) const
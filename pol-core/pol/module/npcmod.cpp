@@ -707,9 +707,10 @@ BObjectImp* NPCExecutorModule::mf_Say()
                                                             if ( !chr->is_visible_to_me( &npc ) )
                                                               return;
                                                             if ( !uclen )
-                                                              msg.Send( chr->client, len );
+                                                              msg.SendShared( chr->client, len );
                                                             else
-                                                              ucmsg.Send( chr->client, uclen );
+                                                              ucmsg.SendShared( chr->client,
+                                                                                uclen );
                                                           } );
 
   if ( doevent >= 1 )
@@ -787,7 +788,8 @@ BObjectImp* NPCExecutorModule::mf_SayUC()
                                                             [&]( Mobile::Character* chr ) {
                                                               if ( !chr->is_visible_to_me( &npc ) )
                                                                 return;
-                                                              talkmsg.Send( chr->client, len );
+                                                              talkmsg.SendShared( chr->client,
+                                                                                  len );
                                                             } );
 
     if ( doevent >= 1 )
@@ -828,10 +830,10 @@ BObjectImp* NPCExecutorModule::mf_GetProperty()
   const String* propname_str;
   if ( exec.getStringParam( 0, propname_str ) )
   {
-    std::string val;
-    if ( npc.getprop( propname_str->value(), val ) )
+    BObjectImp* val = npc.getpropimp( propname_str->value() );
+    if ( val != nullptr )
     {
-      return BObjectImp::unpack( val.c_str() );
+      return val;
     }
     else
     {
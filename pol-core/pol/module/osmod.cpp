@@ -74,7 +74,7 @@ OSExecutorModule::OSExecutorModule( Bscript::Executor& exec )
       warn_on_runaway_( true ),
       blocked_( false ),
       sleep_until_clock_( 0 ),
-      hold_itr_(),
+      hold_itr_( nullptr ),
       in_hold_list_( Core::HoldListType::NO_LIST ),
       wait_type( Core::WAIT_TYPE::WAIT_UNKNOWN ),
       pid_( getnewpid( static_cast<Core::UOExecutor*>( &exec ) ) ),
@@ -199,7 +199,12 @@ BObjectImp* OSExecutorModule::mf_Wait_For_Event()
 
 BObjectImp* OSExecutorModule::mf_Events_Waiting()
 {
-  return new BLong( static_cast<int>( events_.size() ) );
+  return new BLong( static_cast<int>( events_waiting() ) );
+}
+
+size_t OSExecutorModule::events_waiting() const
+{
+  return events_.size();
 }
 
 BObjectImp* OSExecutorModule::mf_Start_Script()
@@ -286,7 +291,10 @@ BObjectImp* OSExecutorModule::mf_Start_Skill_Script()
             if ( chr->hidden() && attr->unhides )
               chr->unhide();
             if ( attr->delay_seconds )
+            {
               chr->disable_skills_until( Core::poltime() + attr->delay_seconds );
+              chr->queue_regen();
+            }
           }
         }
         else
@@ -296,7 +304,10 @@ BObjectImp* OSExecutorModule::mf_Start_Skill_Script()
             if ( chr->hidden() && attr->unhides )
               chr->unhide();
             if ( attr->delay_seconds )
+            {
               chr->disable_skills_until( Core::poltime() + attr->delay_seconds );
+              chr->queue_regen();
+            }
           }
         }
       }
@@ -1026,7 +1037,7 @@ struct PerfData
     for ( const auto& scr : ranlist )
       collect( scr );
     for ( const auto& scr : holdlist )
-      collect( scr.second );
+      collect( scr );
     for ( const auto& scr : notimeoutholdlist )
       collect( scr );
     std::sort( res.begin(), res.end(), std::greater<ScriptDiffData>() );
@@ -1081,7 +1092,7 @@ BObjectImp* OSExecutorModule::mf_PerformanceMeasure()
   for ( const auto& scr : ranlist )
     perf->data.insert( std::make_pair( scr->pid(), ScriptDiffData( scr ) ) );
   for ( const auto& scr : holdlist )
-    perf->data.insert( std::make_pair( scr.second->pid(), ScriptDiffData( scr.second ) ) );
+    perf->data.insert( std::make_pair( scr->pid(), ScriptDiffData( scr ) ) );
   for ( const auto& scr : notimeoutholdlist )
     perf->data.insert( std::make_pair( scr->pid(), ScriptDiffData( scr ) ) );
 
@@ -68,6 +68,7 @@ public:
   bool in_debugger_holdlist() const;
   void revive_debugged();
   Bscript::BObjectImp* clear_event_queue();  // DAVE
+  size_t events_waiting() const;
 
   virtual size_t sizeEstimate() const override;
 
@@ -1780,10 +1780,10 @@ BObjectImp* UOExecutorModule::mf_GetObjProperty()
   const String* propname_str;
   if ( getUObjectParam( exec, 0, uobj ) && getStringParam( 1, propname_str ) )
   {
-    std::string val;
-    if ( uobj->getprop( propname_str->value(), val ) )
+    BObjectImp* val = uobj->getpropimp( propname_str->value() );
+    if ( val != nullptr )
     {
-      return BObjectImp::unpack( val.c_str() );
+      return val;
     }
     else
     {
@@ -1852,10 +1852,10 @@ BObjectImp* UOExecutorModule::mf_GetGlobalProperty()
   const String* propname_str;
   if ( getStringParam( 0, propname_str ) )
   {
-    std::string val;
-    if ( gamestate.global_properties->getprop( propname_str->value(), val ) )
+    BObjectImp* val = gamestate.global_properties->getpropimp( propname_str->value() );
+    if ( val != nullptr )
     {
-      return BObjectImp::unpack( val.c_str() );
+      return val;
     }
     else
     {
@@ -5174,9 +5174,9 @@ BObjectImp* UOExecutorModule::mf_FindPath()
       return new BError( "Start Coordinates Invalid for Realm" );
     if ( !realm->valid( x2, y2, z2 ) )
       return new BError( "End Coordinates Invalid for Realm" );
-    UOSearch* astarsearch;
+    // the node arena is kept for the next search
+    static thread_local UOSearch astarsearch;
     unsigned int SearchState;
-    astarsearch = new UOSearch;
     short xL, xH, yL, yH;
 
     if ( x1 < x2 )
@@ -5245,19 +5245,19 @@ BObjectImp* UOExecutorModule::mf_FindPath()
     // Define the goal state
     UOPathState nodeEnd( x2, y2, z2, realm, &theBlockers );
     // Set Start and goal states
-    astarsearch->SetStartAndGoalStates( nodeStart, nodeEnd );
+    astarsearch.SetStartAndGoalStates( nodeStart, nodeEnd );
     do
     {
-      SearchState = astarsearch->SearchStep( doors_block );
+      SearchState = astarsearch.SearchStep( doors_block );
     } while ( SearchState == UOSearch::SEARCH_STATE_SEARCHING );
     if ( SearchState == UOSearch::SEARCH_STATE_SUCCEEDED )
     {
-      UOPathState* node = astarsearch->GetSolutionStart();
+      UOPathState* node = astarsearch.GetSolutionStart();
       ObjArray* nodeArray = nullptr;
       BStruct* nextStep = nullptr;
 
       nodeArray = new ObjArray();
-      while ( ( node = astarsearch->GetSolutionNext() ) != nullptr )
+      while ( ( node = astarsearch.GetSolutionNext() ) != nullptr )
       {
         nextStep = new BStruct;
         nextStep->addMember( "x", new BLong( node->x ) );
@@ -5265,27 +5265,22 @@ BObjectImp* UOExecutorModule::mf_FindPath()
         nextStep->addMember( "z", new BLong( node->z ) );
         nodeArray->addElement( nextStep );
       }
-      astarsearch->FreeSolutionNodes();
-      delete astarsearch;
+      astarsearch.FreeSolutionNodes();
       return nodeArray;
     }
     else if ( SearchState == UOSearch::SEARCH_STATE_FAILED )
     {
-      delete astarsearch;
       return new BError( "Failed to find a path." );
     }
     else if ( SearchState == UOSearch::SEARCH_STATE_OUT_OF_MEMORY )
     {
-      delete astarsearch;
       return new BError( "Out of memory." );
     }
     else if ( SearchState == UOSearch::SEARCH_STATE_SOLUTION_CORRUPTED )
     {
-      delete astarsearch;
       return new BError( "Solution Corrupted!" );
     }
 
-    delete astarsearch;
     return new BError( "Pathfind Error." );
   }
   else
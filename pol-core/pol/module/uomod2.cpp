@@ -75,6 +75,7 @@
 #include "../multi/multidef.h"
 #include "../network/cgdata.h"
 #include "../network/client.h"
+#include "../network/gumpcache.h"
 #include "../network/packethelper.h"
 #include "../network/packetinterface.h"
 #include "../network/packets.h"
@@ -1129,14 +1130,10 @@ BObjectImp* UOExecutorModule::internal_SendCompressedGumpMenu( Character* chr, O
                                                                u32 gumpid )
 {
   PktHelper::PacketOut<PktOut_DD> msg;
-  PktHelper::PacketOut<PktOut_DD> bfr;  // compress buffer
-  bfr->offset = 0;
-  msg->offset += 2;
-  msg->Write<u32>( chr->serial_ext );
-  msg->WriteFlipped<u32>( gumpid );
-  msg->WriteFlipped<u32>( static_cast<u16>( x ) );
-  msg->WriteFlipped<u32>( static_cast<u16>( y ) );
-  msg->offset += 8;  // u32 layout_clen,layout_dlen
+  PktHelper::PacketOut<PktOut_DD> layoutbfr;  // uncompressed layout
+  PktHelper::PacketOut<PktOut_DD> textbfr;    // uncompressed text lines
+  layoutbfr->offset = 0;
+  textbfr->offset = 0;
 
   u32 layoutdlen = 0;
 
@@ -1149,41 +1146,21 @@ BObjectImp* UOExecutorModule::internal_SendCompressedGumpMenu( Character* chr, O
     std::string s = imp->getStringRep();
 
     size_t addlen = 4 + s.length();
-    if ( layoutdlen + addlen > sizeof bfr->buffer )
+    if ( layoutdlen + addlen > sizeof layoutbfr->buffer )
     {
       return new BError( "Buffer length exceeded" );
     }
     layoutdlen += static_cast<u32>( addlen );
-    bfr->Write( "{ ", 2, false );
-    bfr->Write( s.c_str(), static_cast<u16>( s.length() ), false );
-    bfr->Write( " }", 2, false );
+    layoutbfr->Write( "{ ", 2, false );
+    layoutbfr->Write( s.c_str(), static_cast<u16>( s.length() ), false );
+    layoutbfr->Write( " }", 2, false );
   }
-  if ( layoutdlen + 1 > static_cast<u32>( sizeof bfr->buffer ) )
+  if ( layoutdlen + 1 > static_cast<u32>( sizeof layoutbfr->buffer ) )
   {
     return new BError( "Buffer length exceeded" );
   }
   layoutdlen++;
-  bfr->offset++;  // nullterm
-
-  unsigned long cbuflen =
-      ( ( (unsigned long)( ( (float)( layoutdlen ) ) * 1.001f ) ) + 12 );  // as per zlib spec
-  if ( cbuflen > ( (unsigned long)( 0xFFFF - msg->offset ) ) )
-  {
-    return new BError( "Compression error" );
-  }
-
-  if ( compress2( reinterpret_cast<unsigned char*>( msg->getBuffer() ), &cbuflen,
-                  reinterpret_cast<unsigned char*>( &bfr->buffer ), layoutdlen,
-                  Z_DEFAULT_COMPRESSION ) != Z_OK )
-  {
-    return new BError( "Compression error" );
-  }
-  msg->offset -= 8;
-  msg->WriteFlipped<u32>( cbuflen + 4 );
-  msg->WriteFlipped<u32>( layoutdlen );
-  msg->offset += static_cast<u16>( cbuflen );
-
-  bfr->offset = 0;
+  layoutbfr->offset++;  // nullterm
 
   u32 numlines = 0;
   u32 datadlen = 0;
@@ -1199,35 +1176,45 @@ BObjectImp* UOExecutorModule::internal_SendCompressedGumpMenu( Character* chr, O
     auto utf16 = Bscript::String::toUTF16( s );
     ++numlines;
     size_t addlen = ( utf16.size() + 1 ) * 2;
-    if ( datadlen + addlen > sizeof bfr->buffer )
+    if ( datadlen + addlen > sizeof textbfr->buffer )
     {
       return new BError( "Buffer length exceeded" );
     }
     datadlen += static_cast<u32>( addlen );
-    bfr->WriteFlipped<u16>( utf16.size() );
-    bfr->WriteFlipped( utf16, false );
+    textbfr->WriteFlipped<u16>( utf16.size() );
+    textbfr->WriteFlipped( utf16, false );
   }
-  msg->WriteFlipped<u32>( numlines );
-  if ( numlines != 0 )
+
+  // identical gumps share the compressed blocks, only the header differs per send
+  auto gump = networkManager.gump_cache->get(
+      reinterpret_cast<const u8*>( &layoutbfr->buffer ), layoutdlen,
+      reinterpret_cast<const u8*>( &textbfr->buffer ), datadlen, numlines );
+  if ( gump == nullptr )
+  {
+    return new BError( "Compression error" );
+  }
+  // header, layout block, numlines and text block
+  size_t pktlen = 19 + 8 + gump->layout.data.size() + 4 + 8 + gump->text.data.size();
+  if ( pktlen > 0xFFFF )
   {
-    msg->offset += 8;  // u32 text_clen, text_dlen
+    return new BError( "Compression error" );
+  }
 
-    cbuflen = ( ( (unsigned long)( ( (float)( datadlen ) ) * 1.001f ) ) + 12 );  // as per zlib spec
-    if ( cbuflen > ( (unsigned long)( 0xFFFF - msg->offset ) ) )
-    {
-      return new BError( "Compression error" );
-    }
-    if ( compress2( reinterpret_cast<unsigned char*>( msg->getBuffer() ), &cbuflen,
-                    reinterpret_cast<unsigned char*>( &bfr->buffer ), datadlen,
-                    Z_DEFAULT_COMPRESSION ) != Z_OK )
-    {
-      return new BError( "Compression error" );
-    }
+  msg->offset += 2;
+  msg->Write<u32>( chr->serial_ext );
+  msg->WriteFlipped<u32>( gumpid );
+  msg->WriteFlipped<u32>( static_cast<u16>( x ) );
+  msg->WriteFlipped<u32>( static_cast<u16>( y ) );
+  msg->WriteFlipped<u32>( static_cast<u32>( gump->layout.data.size() + 4 ) );
+  msg->WriteFlipped<u32>( gump->layout.dlen );
+  msg->Write( gump->layout.data.data(), static_cast<u16>( gump->layout.data.size() ), false );
 
-    msg->offset -= 8;
-    msg->WriteFlipped<u32>( cbuflen + 4 );
-    msg->WriteFlipped<u32>( datadlen );
-    msg->offset += static_cast<u16>( cbuflen );
+  msg->WriteFlipped<u32>( numlines );
+  if ( numlines != 0 )
+  {
+    msg->WriteFlipped<u32>( static_cast<u32>( gump->text.data.size() + 4 ) );
+    msg->WriteFlipped<u32>( gump->text.dlen );
+    msg->Write( gump->text.data.data(), static_cast<u16>( gump->text.data.size() ), false );
   }
   else
     msg->Write<u32>( 0u );
@@ -1757,7 +1744,7 @@ BObjectImp* GetAllScriptList()
   }
   for ( const auto& script : holdlist )
   {
-    add_script( arr, ( script ).second, "Sleeping" );
+    add_script( arr, script, "Sleeping" );
   }
   for ( const auto& script : notimeoutholdlist )
   {
@@ -1864,6 +1851,18 @@ BObjectImp* GetPktStatusObj()
   return pkts.release();
 }
 
+BObjectImp* GetGumpCacheStats()
+{
+  Network::GumpCache::Stats stats = networkManager.gump_cache->stats();
+  std::unique_ptr<BStruct> res( new BStruct );
+  res->addMember( "hits", new Double( static_cast<double>( stats.hits ) ) );
+  res->addMember( "misses", new Double( static_cast<double>( stats.misses ) ) );
+  res->addMember( "evictions", new Double( static_cast<double>( stats.evictions ) ) );
+  res->addMember( "entries", new BLong( static_cast<int>( stats.entries ) ) );
+  res->addMember( "bytes", new BLong( static_cast<int>( stats.bytes ) ) );
+  return res.release();
+}
+
 BObjectImp* GetCoreVariable( const char* corevar )
 {
 #define LONG_COREVAR( name, expr )      \
@@ -1919,6 +1918,8 @@ BObjectImp* GetCoreVariable( const char* corevar )
     return GetQueuedIoStats();
   if ( stricmp( corevar, "pkt_status" ) == 0 )
     return GetPktStatusObj();
+  if ( stricmp( corevar, "gump_cache" ) == 0 )
+    return GetGumpCacheStats();
   if ( stricmp( corevar, "memory_usage" ) == 0 )
     return new BLong( static_cast<int>( Clib::getCurrentMemoryUsage() / 1024 ) );
 
@@ -6,10 +6,18 @@
  */
 
 
+#include "pol_global_config.h"
+
 #include "../../clib/rawtypes.h"
 #include "../../plib/systemstate.h"
 #include "customhouses.h"
 
+#ifdef USE_SYSTEM_ZLIB
+#include <zlib.h>
+#else
+#include "../../../lib/zlib/zlib.h"
+#endif
+
 namespace Pol
 {
 namespace Multi
@@ -107,14 +115,12 @@ bool CustomHouseDesign::DeleteStairs( u16 id, s32 x, s32 y, s8 z )
 
   if ( IsStairBlock( id ) )
   {
-    for ( HouseFloorZColumn::iterator itr = Elements[floor_num].data.at( xidx ).at( yidx ).begin(),
-                                      itrend = Elements[floor_num].data.at( xidx ).at( yidx ).end();
-          itr != itrend; ++itr )
+    for ( const auto& elem : Elements[floor_num].Column( xidx, yidx ) )
     {
-      if ( itr->z == ( z + 5 ) )
+      if ( elem.z == ( z + 5 ) )
       {
-        id = itr->graphic;
-        z = itr->z;
+        id = elem.graphic;
+        z = elem.z;
         if ( !IsStairBlock( id ) )
           break;
       }
@@ -184,59 +190,126 @@ bool CustomHouseDesign::DeleteStairs( u16 id, s32 x, s32 y, s8 z )
   return true;
 }
 
-CustomHouseElements::CustomHouseElements() : data(), height( 0 ), width( 0 ), xoff( 0 ), yoff( 0 )
+CustomHouseElements::CustomHouseElements()
+    : data(),
+      height( 0 ),
+      width( 0 ),
+      xoff( 0 ),
+      yoff( 0 ),
+      compressed(),
+      compressed_ulen( 0 ),
+      compressed_valid( false )
 {
 }
 
 CustomHouseElements::CustomHouseElements( u32 _height, u32 _width, s32 xoffset, s32 yoffset )
-    : height( _height ), width( _width ), xoff( xoffset ), yoff( yoffset )
+    : data(),
+      height( 0 ),
+      width( 0 ),
+      xoff( xoffset ),
+      yoff( yoffset ),
+      compressed(),
+      compressed_ulen( 0 ),
+      compressed_valid( false )
 {
-  SetWidth( _width );
-  SetHeight( _height );
+  Resize( _width, _height );
 }
 CustomHouseElements::~CustomHouseElements() {}
 
 void CustomHouseElements::SetHeight( u32 _height )
 {
-  height = _height;
-  for ( size_t i = 0; i < width; i++ )
-    data.at( i ).resize( height );
+  Resize( width, _height );
 }
 
 void CustomHouseElements::SetWidth( u32 _width )
 {
+  Resize( _width, height );
+}
+
+// keeps the columns at their x,y index
+void CustomHouseElements::Resize( u32 _width, u32 _height )
+{
+  if ( _width == width && _height == height )
+    return;
+  HouseFloor newdata( _width * _height );
+  for ( u32 x = 0; x < width && x < _width; ++x )
+  {
+    for ( u32 y = 0; y < height && y < _height; ++y )
+      newdata[x * _height + y].swap( data[x * height + y] );
+  }
+  data.swap( newdata );
   width = _width;
-  data.resize( width );
+  height = _height;
+  Modified();
 }
 
 size_t CustomHouseElements::estimatedSize() const
 {
   size_t size = sizeof( CustomHouseElements );
-  size += 3 * sizeof( HouseFloor* ) + data.capacity() * sizeof( HouseFloor );
-  for ( const auto& floor : data )
-  {
-    size += 3 * sizeof( std::list<CUSTOM_HOUSE_ELEMENT>* ) +
-            floor.capacity() * sizeof( std::list<CUSTOM_HOUSE_ELEMENT> );
-    for ( const auto& l : floor )
-    {
-      size += 3 * sizeof( CUSTOM_HOUSE_ELEMENT* ) + l.size() * sizeof( CUSTOM_HOUSE_ELEMENT );
-    }
-  }
+  size += 3 * sizeof( HouseFloorZColumn* ) + data.capacity() * sizeof( HouseFloorZColumn );
+  for ( const auto& column : data )
+    size += column.capacity() * sizeof( CUSTOM_HOUSE_ELEMENT );
+  size += compressed.capacity();
   return size;
 }
 
-HouseFloorZColumn* CustomHouseElements::GetElementsAt( s32 xoffset, s32 yoffset )
+const HouseFloorZColumn* CustomHouseElements::GetElementsAt( s32 xoffset, s32 yoffset ) const
 {
   u32 x = xoffset + xoff;
   u32 y = yoffset + yoff;
-  return &( data.at( x ).at( y ) );
+  return &Column( x, y );
 }
-void CustomHouseElements::AddElement( CUSTOM_HOUSE_ELEMENT& elem )
+void CustomHouseElements::AddElement( const CUSTOM_HOUSE_ELEMENT& elem )
 {
   u32 x = elem.xoffset + xoff;
   u32 y = elem.yoffset + yoff;
 
-  data.at( x ).at( y ).push_back( elem );
+  Column( x, y ).push_back( elem );
+  Modified();
+}
+
+void CustomHouseElements::Clear()
+{
+  for ( auto& column : data )
+    column.clear();
+  Modified();
+}
+
+// assume type 0
+const std::vector<u8>* CustomHouseElements::Compress( u32* uncompr_length ) const
+{
+  if ( !compressed_valid )
+  {
+    std::vector<u8> uncompressed;
+    for ( const auto& column : data )
+    {
+      for ( const auto& elem : column )
+      {
+        // assume type 0, I don't know how to deal with stair pieces at odd Z values for mode 1,
+        // and mode 2 is just wacky. (position implied from list position, needs alot of null tiles
+        // to make that work (but they compress very well)
+        uncompressed.push_back( static_cast<u8>( ( elem.graphic >> 8 ) & 0xFF ) );
+        uncompressed.push_back( static_cast<u8>( elem.graphic & 0xFF ) );
+        uncompressed.push_back( static_cast<u8>( elem.xoffset ) );
+        uncompressed.push_back( static_cast<u8>( elem.yoffset ) );
+        uncompressed.push_back( elem.z );
+      }
+    }
+    uLongf cbuflen = compressBound( static_cast<uLong>( uncompressed.size() ) );
+    compressed.resize( cbuflen );
+    if ( compress2( &compressed[0], &cbuflen, uncompressed.data(),
+                    static_cast<uLong>( uncompressed.size() ), Z_DEFAULT_COMPRESSION ) != Z_OK )
+    {
+      compressed.clear();
+      return nullptr;
+    }
+    compressed.resize( cbuflen );
+    compressed.shrink_to_fit();
+    compressed_ulen = static_cast<u32>( uncompressed.size() );
+    compressed_valid = true;
+  }
+  *uncompr_length = compressed_ulen;
+  return &compressed;
 }
 }
 }
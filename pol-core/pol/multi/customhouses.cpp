@@ -164,7 +164,7 @@ void CustomHouseDesign::AddOrReplace( CUSTOM_HOUSE_ELEMENT& elem )
   u32 yidx = elem.yoffset + yoff;
   if ( !ValidLocation( xidx, yidx ) )
     return;
-  HouseFloorZColumn* column = &Elements[floor_num].data.at( xidx ).at( yidx );
+  HouseFloorZColumn* column = &Elements[floor_num].Column( xidx, yidx );
   for ( HouseFloorZColumn::iterator itr = column->begin(), itrend = column->end(); itr != itrend;
         ++itr )
   {
@@ -175,6 +175,7 @@ void CustomHouseDesign::AddOrReplace( CUSTOM_HOUSE_ELEMENT& elem )
 
     {
       column->erase( itr );
+      Elements[floor_num].Modified();
       floor_sizes[floor_num]--;
       Add( elem );
       return;
@@ -195,7 +196,7 @@ bool CustomHouseDesign::Erase( u32 xoffset, u32 yoffset, u8 z, int minheight )
   if ( !ValidLocation( xidx, yidx ) )
     return false;
 
-  HouseFloorZColumn* column = &Elements[floor_num].data.at( xidx ).at( yidx );
+  HouseFloorZColumn* column = &Elements[floor_num].Column( xidx, yidx );
   for ( HouseFloorZColumn::iterator itr = column->begin(), itrend = column->end(); itr != itrend;
         ++itr )
   {
@@ -203,6 +204,7 @@ bool CustomHouseDesign::Erase( u32 xoffset, u32 yoffset, u8 z, int minheight )
     if ( ( itr->z == z ) && ( t_height >= minheight ) )
     {
       column->erase( itr );
+      Elements[floor_num].Modified();
       floor_sizes[floor_num]--;
       return true;
     }
@@ -221,13 +223,14 @@ bool CustomHouseDesign::EraseGraphicAt( u16 graphic, u32 xoffset, u32 yoffset, u
   u32 yidx = yoffset + yoff;
   if ( !ValidLocation( xidx, yidx ) )
     return false;
-  HouseFloorZColumn* column = &Elements[floor_num].data.at( xidx ).at( yidx );
+  HouseFloorZColumn* column = &Elements[floor_num].Column( xidx, yidx );
   for ( HouseFloorZColumn::iterator itr = column->begin(), itrend = column->end(); itr != itrend;
         ++itr )
   {
     if ( itr->graphic == graphic )
     {
       column->erase( itr );
+      Elements[floor_num].Modified();
       floor_sizes[floor_num]--;
       return true;
     }
@@ -250,11 +253,9 @@ void CustomHouseDesign::ReplaceDirtFloor( u32 x, u32 y )
   u32 yidx = y + yoff;
   if ( !ValidLocation( xidx, yidx ) )
     return;
-  HouseFloorZColumn* column = &Elements[floor_num].data.at( xidx ).at( yidx );
-  for ( HouseFloorZColumn::iterator itr = column->begin(), itrend = column->end(); itr != itrend;
-        ++itr )
+  for ( const auto& elem : Elements[floor_num].Column( xidx, yidx ) )
   {
-    if ( Plib::tileheight( itr->graphic ) == 0 )  // a floor tile exists
+    if ( Plib::tileheight( elem.graphic ) == 0 )  // a floor tile exists
     {
       floor_exists = true;
       break;
@@ -275,80 +276,18 @@ void CustomHouseDesign::ReplaceDirtFloor( u32 x, u32 y )
 
 void CustomHouseDesign::Clear()
 {
-  // delete contents of all z column lists
+  // delete contents of all z columns
   for ( int i = 0; i < CUSTOM_HOUSE_NUM_PLANES; i++ )
   {
-    for ( HouseFloor::iterator xitr = Elements[i].data.begin(), xitrend = Elements[i].data.end();
-          xitr != xitrend; ++xitr )
-    {
-      for ( HouseFloorRow::iterator yitr = xitr->begin(), yitrend = xitr->end(); yitr != yitrend;
-            ++yitr )
-      {
-        yitr->clear();
-      }
-    }
+    Elements[i].Clear();
     floor_sizes[i] = 0;
   }
 }
 
-// caller must delete, assume type 0
-unsigned char* CustomHouseDesign::Compress( int floor, u32* uncompr_length, u32* compr_length )
+// compressed plane of the floor, owned by the design
+const std::vector<u8>* CustomHouseDesign::Compress( int floor, u32* uncompr_length ) const
 {
-  int numtiles = floor_sizes[floor];
-  int nextindex = 0;
-  unsigned int ubuflen = numtiles * BYTES_PER_TILE;
-  unsigned long cbuflen =
-      ( ( (unsigned long)( ( (float)( ubuflen ) ) * 1.001f ) ) + 12 );  // as per zlib spec
-  unsigned char* uncompressed = new unsigned char[ubuflen];
-  memset( uncompressed, 0, ubuflen );
-  unsigned char* compressed = new unsigned char[cbuflen];
-  memset( compressed, 0, cbuflen );
-
-  int i = 0;
-  for ( HouseFloor::const_iterator xitr = Elements[floor].data.begin(),
-                                   xitrend = Elements[floor].data.end();
-        xitr != xitrend; ++xitr )
-  {
-    i = 0;
-    for ( HouseFloorRow::const_iterator yitr = xitr->begin(), yitrend = xitr->end();
-          yitr != yitrend; ++yitr )
-    {
-      for ( HouseFloorZColumn::const_iterator zitr = yitr->begin(), zitrend = yitr->end();
-            zitr != zitrend; ++zitr, ++i )
-      {
-        // assume type 0, I don't know how to deal with stair pieces at odd Z values for mode 1,
-        // and mode 2 is just wacky. (position implied from list position, needs alot of null tiles
-        // to make that work (but they compress very well)
-        if ( i < numtiles )
-        {
-          uncompressed[nextindex++] = ( u8 )( ( zitr->graphic >> 8 ) & 0xFF );
-          uncompressed[nextindex++] = ( u8 )( zitr->graphic & 0xFF );
-
-          uncompressed[nextindex++] = (u8)zitr->xoffset;
-          uncompressed[nextindex++] = (u8)zitr->yoffset;
-          uncompressed[nextindex++] = (u8)zitr->z;
-        }
-      }
-    }
-  }
-  *uncompr_length = nextindex;
-
-  int ret = compress2( compressed, &cbuflen, uncompressed, nextindex, Z_DEFAULT_COMPRESSION );
-  if ( ret == Z_OK )
-  {
-    delete[] uncompressed;
-    *compr_length = cbuflen;
-    return compressed;
-  }
-  else
-  {
-    *uncompr_length = 0;
-    *compr_length = 0;
-    delete[] compressed;
-    if ( ubuflen > 0 )
-      delete[] uncompressed;
-    return nullptr;
-  }
+  return Elements[floor].Compress( uncompr_length );
 }
 
 bool CustomHouseDesign::IsEmpty() const
@@ -444,19 +383,15 @@ void CustomHouseDesign::printProperties( Clib::StreamWriter& sw, const std::stri
   {
     for ( int i = 0; i < CUSTOM_HOUSE_NUM_PLANES; i++ )
     {
-      for ( HouseFloor::const_iterator xitr = Elements[i].data.begin(),
-                                       xitrend = Elements[i].data.end();
-            xitr != xitrend; ++xitr )
+      for ( HouseFloor::const_iterator citr = Elements[i].data.begin(),
+                                       citrend = Elements[i].data.end();
+            citr != citrend; ++citr )
       {
-        for ( HouseFloorRow::const_iterator yitr = xitr->begin(), yitrend = xitr->end();
-              yitr != yitrend; ++yitr )
+        for ( HouseFloorZColumn::const_iterator zitr = citr->begin(), zitrend = citr->end();
+              zitr != zitrend; ++zitr )
         {
-          for ( HouseFloorZColumn::const_iterator zitr = yitr->begin(), zitrend = yitr->end();
-                zitr != zitrend; ++zitr )
-          {
-            sw() << "\t" << prefix << "\t " << zitr->graphic << " " << zitr->xoffset << " "
-                 << zitr->yoffset << " " << (u16)zitr->z << '\n';
-          }
+          sw() << "\t" << prefix << "\t " << zitr->graphic << " " << zitr->xoffset << " "
+               << zitr->yoffset << " " << (u16)zitr->z << '\n';
         }
       }
     }
@@ -470,17 +405,15 @@ void CustomHouseDesign::testprint( std::ostream& os ) const
   {
     for ( int i = 0; i < CUSTOM_HOUSE_NUM_PLANES; i++ )
     {
-      int x = 0, y = 0;
-      for ( HouseFloor::const_iterator xitr = Elements[i].data.begin(),
-                                       xitrend = Elements[i].data.end();
-            xitr != xitrend; ++xitr, x++ )
+      int y = 0;
+      for ( u32 x = 0; x < Elements[i].width; x++ )
       {
         os << "X: " << x << std::endl;
-        for ( HouseFloorRow::const_iterator yitr = xitr->begin(), yitrend = xitr->end();
-              yitr != yitrend; ++yitr, y++ )
+        for ( u32 yidx = 0; yidx < Elements[i].height; ++yidx, y++ )
         {
           os << "\tY: " << y << std::endl;
-          for ( HouseFloorZColumn::const_iterator zitr = yitr->begin(), zitrend = yitr->end();
+          const HouseFloorZColumn& column = Elements[i].Column( x, yidx );
+          for ( HouseFloorZColumn::const_iterator zitr = column.begin(), zitrend = column.end();
                 zitr != zitrend; ++zitr )
           {
             os << "\t\t" << zitr->graphic << " " << zitr->xoffset << " " << zitr->yoffset << " "
@@ -561,102 +494,100 @@ void CustomHouseDesign::FillComponents( UHouse* house, bool add_as_component )
   UHouse::Components* comp = house->get_components();
   for ( int i = 0; i < CUSTOM_HOUSE_NUM_PLANES; i++ )
   {
-    for ( HouseFloor::iterator xitr = Elements[i].data.begin(), xitrend = Elements[i].data.end();
-          xitr != xitrend; ++xitr )
+    for ( HouseFloor::iterator yitr = Elements[i].data.begin(), yitrend = Elements[i].data.end();
+          yitr != yitrend; ++yitr )
     {
-      for ( HouseFloorRow::iterator yitr = xitr->begin(), yitrend = xitr->end(); yitr != yitrend;
-            ++yitr )
+      HouseFloorZColumn::iterator zitr = yitr->begin();
+      while ( zitr != yitr->end() )
       {
-        HouseFloorZColumn::iterator zitr = yitr->begin();
-        while ( zitr != yitr->end() )
+        const Items::ItemDesc& id = Items::find_itemdesc( zitr->graphic );
+        if ( id.type == Items::ItemDesc::DOORDESC )
         {
-          const Items::ItemDesc& id = Items::find_itemdesc( zitr->graphic );
-          if ( id.type == Items::ItemDesc::DOORDESC )
+          if ( add_as_component )
           {
-            if ( add_as_component )
+            Items::Item* component = Items::Item::create( id.objtype );
+            if ( component != nullptr )
             {
-              Items::Item* component = Items::Item::create( id.objtype );
-              if ( component != nullptr )
-              {
-                bool res = house->add_component( component, zitr->xoffset, zitr->yoffset, zitr->z );
-                passert_always_r( res,
-                                  "Couldn't add newly created door as house component. Please "
-                                  "report this bug on the forums." );
-              }
+              bool res = house->add_component( component, zitr->xoffset, zitr->yoffset, zitr->z );
+              passert_always_r( res,
+                                "Couldn't add newly created door as house component. Please "
+                                "report this bug on the forums." );
             }
-            else
+          }
+          else
+          {
+            u16 c_x = static_cast<u16>( house->x + zitr->xoffset );
+            u16 c_y = static_cast<u16>( house->y + zitr->yoffset );
+            s8 c_z = static_cast<s8>( house->z + zitr->z );
+            // if component already exists erase from design, otherwise keep it
+            bool exists = false;
+            for ( const auto& c : *comp )
             {
-              u16 c_x = static_cast<u16>( house->x + zitr->xoffset );
-              u16 c_y = static_cast<u16>( house->y + zitr->yoffset );
-              s8 c_z = static_cast<s8>( house->z + zitr->z );
-              // if component already exists erase from design, otherwise keep it
-              bool exists = false;
-              for ( const auto& c : *comp )
-              {
-                Items::Item* item = c.get();
-                if ( item == nullptr || item->orphan() )
-                  continue;
-                if ( c_x == item->x && c_y == item->y && c_z == item->z &&
-                     zitr->graphic == item->graphic )
-                {
-                  exists = true;
-                  break;
-                }
-              }
-              if ( !exists )
-              {
-                ++zitr;
+              Items::Item* item = c.get();
+              if ( item == nullptr || item->orphan() )
                 continue;
+              if ( c_x == item->x && c_y == item->y && c_z == item->z &&
+                   zitr->graphic == item->graphic )
+              {
+                exists = true;
+                break;
               }
             }
-            zitr = yitr->erase( zitr );
-            floor_sizes[i]--;
+            if ( !exists )
+            {
+              ++zitr;
+              continue;
+            }
           }
-          else if ( zitr->graphic >= TELEPORTER_START &&
-                    zitr->graphic <= TELEPORTER_END )  // teleporters
+          zitr = yitr->erase( zitr );
+          Elements[i].Modified();
+          floor_sizes[i]--;
+        }
+        else if ( zitr->graphic >= TELEPORTER_START &&
+                  zitr->graphic <= TELEPORTER_END )  // teleporters
+        {
+          if ( add_as_component )
           {
-            if ( add_as_component )
+            Items::Item* component = Items::Item::create( zitr->graphic );
+            if ( component != nullptr )
             {
-              Items::Item* component = Items::Item::create( zitr->graphic );
-              if ( component != nullptr )
-              {
-                bool res = house->add_component( component, zitr->xoffset, zitr->yoffset, zitr->z );
-                passert_always_r( res,
-                                  "Couldn't add newly created teleporter as house component. "
-                                  "Please report this bug on the forums." );
-              }
+              bool res = house->add_component( component, zitr->xoffset, zitr->yoffset, zitr->z );
+              passert_always_r( res,
+                                "Couldn't add newly created teleporter as house component. "
+                                "Please report this bug on the forums." );
             }
-            else
+          }
+          else
+          {
+            u16 c_x = static_cast<u16>( house->x + zitr->xoffset );
+            u16 c_y = static_cast<u16>( house->y + zitr->yoffset );
+            s8 c_z = static_cast<s8>( house->z + zitr->z );
+            // if component already exists erase from design, otherwise keep it
+            bool exists = false;
+            for ( const auto& c : *comp )
             {
-              u16 c_x = static_cast<u16>( house->x + zitr->xoffset );
-              u16 c_y = static_cast<u16>( house->y + zitr->yoffset );
-              s8 c_z = static_cast<s8>( house->z + zitr->z );
-              // if component already exists erase from design, otherwise keep it
-              bool exists = false;
-              for ( const auto& c : *comp )
-              {
-                Items::Item* item = c.get();
-                if ( item == nullptr || item->orphan() )
-                  continue;
-                if ( c_x == item->x && c_y == item->y && c_z == item->z &&
-                     zitr->graphic == item->graphic )
-                {
-                  exists = true;
-                  break;
-                }
-              }
-              if ( !exists )
-              {
-                ++zitr;
+              Items::Item* item = c.get();
+              if ( item == nullptr || item->orphan() )
                 continue;
+              if ( c_x == item->x && c_y == item->y && c_z == item->z &&
+                   zitr->graphic == item->graphic )
+              {
+                exists = true;
+                break;
               }
             }
-            zitr = yitr->erase( zitr );
-            floor_sizes[i]--;
+            if ( !exists )
+            {
+              ++zitr;
+              continue;
+            }
           }
-          else
-            ++zitr;
+          zitr = yitr->erase( zitr );
+          Elements[i].Modified();
+          floor_sizes[i]--;
         }
+        else
+          ++zitr;
       }
     }
   }
@@ -667,23 +598,19 @@ Bscript::ObjArray* CustomHouseDesign::list_parts() const
   std::unique_ptr<Bscript::ObjArray> arr( new Bscript::ObjArray );
   for ( int i = 0; i < CUSTOM_HOUSE_NUM_PLANES; i++ )
   {
-    for ( HouseFloor::const_iterator xitr = Elements[i].data.begin(),
-                                     xitrend = Elements[i].data.end();
-          xitr != xitrend; ++xitr )
+    for ( HouseFloor::const_iterator yitr = Elements[i].data.begin(),
+                                     yitrend = Elements[i].data.end();
+          yitr != yitrend; ++yitr )
     {
-      for ( HouseFloorRow::const_iterator yitr = xitr->begin(), yitrend = xitr->end();
-            yitr != yitrend; ++yitr )
+      for ( HouseFloorZColumn::const_iterator zitr = yitr->begin(), zitrend = yitr->end();
+            zitr != zitrend; ++zitr )
       {
-        for ( HouseFloorZColumn::const_iterator zitr = yitr->begin(), zitrend = yitr->end();
-              zitr != zitrend; ++zitr )
-        {
-          std::unique_ptr<Bscript::BStruct> itemstruct( new Bscript::BStruct );
-          itemstruct->addMember( "graphic", new Bscript::BLong( zitr->graphic ) );
-          itemstruct->addMember( "xoffset", new Bscript::BLong( zitr->xoffset ) );
-          itemstruct->addMember( "yoffset", new Bscript::BLong( zitr->yoffset ) );
-          itemstruct->addMember( "z", new Bscript::BLong( zitr->z ) );
-          arr->addElement( itemstruct.release() );
-        }
+        std::unique_ptr<Bscript::BStruct> itemstruct( new Bscript::BStruct );
+        itemstruct->addMember( "graphic", new Bscript::BLong( zitr->graphic ) );
+        itemstruct->addMember( "xoffset", new Bscript::BLong( zitr->xoffset ) );
+        itemstruct->addMember( "yoffset", new Bscript::BLong( zitr->yoffset ) );
+        itemstruct->addMember( "z", new Bscript::BLong( zitr->z ) );
+        arr->addElement( itemstruct.release() );
       }
     }
   }
@@ -1025,7 +952,6 @@ void CustomHousesSendFull( UHouse* house, Network::Client* client, int design )
 {
   u32 clen;
   u32 ulen;
-  unsigned char* data;
   // unsigned char** stored_packet;
   std::vector<u8>* stored_packet;
 
@@ -1072,11 +998,19 @@ void CustomHousesSendFull( UHouse* house, Network::Client* client, int design )
 
   // create compressed house message
 
+  // the floors keep their compressed plane until they get edited, so only changed floors are
+  // compressed again
   unsigned char planes = pdesign->NumUsedPlanes();
-  unsigned long sbuflen =
-      ( (unsigned long)( ( (float)( pdesign->TotalSize() * BYTES_PER_TILE ) ) * 1.001f ) + 12 );
-  sbuflen += planes * BYTES_PER_TILE;  // for plane header dword
-  sbuflen += 17;                       // for packet header
+  const std::vector<u8>* plane_data[CUSTOM_HOUSE_NUM_PLANES];
+  u32 plane_ulen[CUSTOM_HOUSE_NUM_PLANES];
+  size_t sbuflen = data_offset + 1;  // packet header and planecount
+  for ( int i = 0; i < planes; i++ )
+  {
+    plane_data[i] = pdesign->Compress( i, &plane_ulen[i] );
+    if ( plane_data[i] == nullptr )  // compression error
+      return;
+    sbuflen += 4 + plane_data[i]->size();  // plane header dword and data
+  }
 
   std::vector<u8> packet( sbuflen );
 
@@ -1094,11 +1028,8 @@ void CustomHousesSendFull( UHouse* house, Network::Client* client, int design )
   for ( int i = 0; i < planes; i++ )
   {
     planeheader = 0;
-    data = pdesign->Compress( i, &ulen, &clen );
-    if ( data == nullptr )  // compression error
-    {
-      return;
-    }
+    ulen = plane_ulen[i];
+    clen = static_cast<u32>( plane_data[i]->size() );
     if ( ulen == 0 )
       clen = 0;
     planeheader |= ( ( mode << 4 ) << 24 );
@@ -1109,9 +1040,9 @@ void CustomHousesSendFull( UHouse* house, Network::Client* client, int design )
     u32* p_planeheader = reinterpret_cast<u32*>( &( packet[buffer_len + data_offset] ) );
     *p_planeheader = ctBEu32( planeheader );
     buffer_len += 4;
-    memcpy( &( packet[buffer_len + data_offset] ), data, clen );
+    if ( clen != 0 )
+      memcpy( &( packet[buffer_len + data_offset] ), plane_data[i]->data(), clen );
     buffer_len += clen;
-    delete[] data;
   }
   msg->msglen = ctBEu16( static_cast<u16>( buffer_len ) + data_offset );
   msg->planebuffer_len = ctBEu16( static_cast<u16>( buffer_len ) );
@@ -10,7 +10,6 @@
 
 #include <cstddef>  // for size_t
 #include <iosfwd>   // for testprint()
-#include <list>
 #include <string>
 #include <vector>
 
@@ -72,14 +71,9 @@ struct CUSTOM_HOUSE_ELEMENT
   s32 yoffset;
 };
 
-typedef std::vector<std::vector<std::list<CUSTOM_HOUSE_ELEMENT>>> HouseFloor;  // vector of N-S rows
-typedef std::vector<std::list<CUSTOM_HOUSE_ELEMENT>> HouseFloorRow;  // vector of Z columns
-typedef std::list<CUSTOM_HOUSE_ELEMENT> HouseFloorZColumn;
-// [][][][][][] - Xoffset vector
-// | | | | | |  - vec of yoffsets
-// v v v v v v
-// [][][][][][] - lists of zoffsets
-// [][][][][][]
+typedef std::vector<CUSTOM_HOUSE_ELEMENT> HouseFloorZColumn;  // elements of one tile
+typedef std::vector<HouseFloorZColumn> HouseFloor;             // width * height tiles
+// [x0,y0][x0,y1]...[x0,yh][x1,y0]... - one z column per tile, N-S rows one after another
 
 class CustomHouseElements
 {
@@ -91,13 +85,31 @@ public:
   void SetHeight( u32 _height );
   void SetWidth( u32 _width );
   size_t estimatedSize() const;
-  HouseFloorZColumn* GetElementsAt( s32 xoffset, s32 yoffset );
-
-  void AddElement( CUSTOM_HOUSE_ELEMENT& elem );
+  const HouseFloorZColumn* GetElementsAt( s32 xoffset, s32 yoffset ) const;
+  // index is the offset plus xoff/yoff
+  HouseFloorZColumn& Column( u32 xidx, u32 yidx ) { return data.at( xidx * height + yidx ); }
+  const HouseFloorZColumn& Column( u32 xidx, u32 yidx ) const
+  {
+    return data.at( xidx * height + yidx );
+  }
+
+  void AddElement( const CUSTOM_HOUSE_ELEMENT& elem );
+  void Clear();
+  // has to be called after data was changed directly, drops the compressed plane
+  void Modified() { compressed_valid = false; }
+  // zlib compressed plane of packet 0xD8, kept until the next change
+  const std::vector<u8>* Compress( u32* uncompr_length ) const;
 
   HouseFloor data;
   u32 height, width;
   s32 xoff, yoff;
+
+private:
+  void Resize( u32 _width, u32 _height );
+
+  mutable std::vector<u8> compressed;
+  mutable u32 compressed_ulen;
+  mutable bool compressed_valid;
 };
 
 class CustomHouseDesign
@@ -121,7 +133,7 @@ public:
   void Clear();
   bool IsEmpty() const;
 
-  unsigned char* Compress( int floor, u32* uncompr_length, u32* compr_length );
+  const std::vector<u8>* Compress( int floor, u32* uncompr_length ) const;
 
   unsigned int TotalSize() const;
   unsigned char NumUsedPlanes() const;
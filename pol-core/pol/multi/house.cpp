@@ -578,8 +578,8 @@ bool UHouse::readshapes( Plib::MapShapeList& vec, short shape_x, short shape_y,
     return false;
 
   bool result = false;
-  HouseFloorZColumn* elems;
-  HouseFloorZColumn::iterator itr;
+  const HouseFloorZColumn* elems;
+  HouseFloorZColumn::const_iterator itr;
   CustomHouseDesign* design;
   design =
       editing
@@ -637,8 +637,8 @@ bool UHouse::readobjects( Plib::StaticList& vec, short obj_x, short obj_y, short
     return false;
 
   bool result = false;
-  HouseFloorZColumn* elems;
-  HouseFloorZColumn::iterator itr;
+  const HouseFloorZColumn* elems;
+  HouseFloorZColumn::const_iterator itr;
   CustomHouseDesign* design;
   design =
       editing
@@ -0,0 +1,440 @@
+#include "clientreactor.h"
+
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "../../clib/esignal.h"
+#include "../../clib/logfacility.h"
+#include "../../clib/network/sockets.h"
+#include "../../clib/rawtypes.h"
+#include "../../clib/strutil.h"
+#include "../../clib/threadhelp.h"
+#include "../../plib/systemstate.h"
+#include "../mobile/charactr.h"
+#include "../polcfg.h"
+#include "../polclock.h"
+#include "../polsem.h"
+#include "client.h"
+#include "clientthread.h"
+#include <format/format.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace Pol
+{
+namespace Network
+{
+#ifdef __linux__
+namespace
+{
+void client_logoff_thread( void* arg )
+{
+  Core::handle_client_disconnect( static_cast<Client*>( arg ) );
+}
+
+int reactor_timeout_ms()
+{
+  // same conversion as Clib::PollingWithPoll
+  int timeout_ms = Plib::systemstate.config.select_timeout_usecs / 1000;
+  if ( Plib::systemstate.config.select_timeout_usecs != 0 && timeout_ms == 0 )
+    timeout_ms = 1;
+  return timeout_ms;
+}
+}  // namespace
+
+class ClientReactor::EventLoop
+{
+public:
+  explicit EventLoop( unsigned int index );
+  ~EventLoop();
+  EventLoop( const EventLoop& ) = delete;
+  EventLoop& operator=( const EventLoop& ) = delete;
+
+  void adopt( Client* client );
+  size_t size() const { return _count; }
+  void run();
+
+private:
+  struct Connection
+  {
+    Client* client;
+    SOCKET sck;
+    size_t slot;
+    bool want_write;
+    bool writable;
+    bool idle_warned;
+  };
+
+  void accept_pending();
+  void dispatch( Connection* conn, unsigned int events );
+  void flush( std::vector<Connection*>& writable );
+  void service( Connection* conn, Core::polclock_t now, bool check_timeouts );
+  void update_interest( Connection* conn );
+  void release( Connection* conn, bool detach );
+
+  unsigned int _index;
+  int _epollfd;
+  int _wakefd;
+  std::mutex _pending_mutex;
+  std::vector<Client*> _pending;
+  std::vector<std::unique_ptr<Connection>> _connections;
+  std::atomic<size_t> _count;
+};
+
+ClientReactor::EventLoop::EventLoop( unsigned int index )
+    : _index( index ),
+      _epollfd( epoll_create1( EPOLL_CLOEXEC ) ),
+      _wakefd( eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC ) ),
+      _pending_mutex(),
+      _pending(),
+      _connections(),
+      _count( 0 )
+{
+  if ( _epollfd < 0 || _wakefd < 0 )
+    throw std::runtime_error( "Unable to create network reactor, errno=" +
+                              Clib::tostring( errno ) );
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.ptr = nullptr;  // marks the wakeup descriptor
+  epoll_ctl( _epollfd, EPOLL_CTL_ADD, _wakefd, &ev );
+}
+
+ClientReactor::EventLoop::~EventLoop()
+{
+  close( _wakefd );
+  close( _epollfd );
+}
+
+void ClientReactor::EventLoop::adopt( Client* client )
+{
+  {
+    std::lock_guard<std::mutex> lock( _pending_mutex );
+    _pending.push_back( client );
+  }
+  ++_count;
+  u64 one = 1;
+  if ( write( _wakefd, &one, sizeof one ) < 0 )
+  {
+    // counter overflow is the only possible error, the loop wakes up anyway
+  }
+}
+
+void ClientReactor::EventLoop::accept_pending()
+{
+  std::vector<Client*> pending;
+  {
+    std::lock_guard<std::mutex> lock( _pending_mutex );
+    pending.swap( _pending );
+  }
+  for ( auto& client : pending )
+  {
+    std::unique_ptr<Connection> conn( new Connection() );
+    conn->client = client;
+    conn->sck = client->csocket;
+    conn->slot = _connections.size();
+    conn->want_write = false;
+    conn->writable = false;
+    conn->idle_warned = false;
+
+    client->thread_pid = threadhelp::thread_pid();
+    client->last_packet_at = Core::polclock();
+    client->last_activity_at = Core::polclock();
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = conn.get();
+    if ( conn->sck == INVALID_SOCKET || fcntl( conn->sck, F_SETFL, O_NONBLOCK ) < 0 ||
+         epoll_ctl( _epollfd, EPOLL_CTL_ADD, conn->sck, &ev ) < 0 )
+    {
+      POLLOG_INFO.Format( "Client#{}: ERROR - couldn't poll socket={}\n" )
+          << client->instance_ << conn->sck;
+      if ( client->csocket != INVALID_SOCKET )
+        client->forceDisconnect();
+      --_count;
+      threadhelp::start_thread( client_logoff_thread, "Client Logoff", client );
+      continue;
+    }
+    _connections.push_back( std::move( conn ) );
+  }
+}
+
+void ClientReactor::EventLoop::update_interest( Connection* conn )
+{
+  bool want_write = conn->client->have_queued_data();
+  if ( want_write == conn->want_write || conn->client->csocket != conn->sck )
+    return;
+  epoll_event ev{};
+  ev.events = want_write ? ( EPOLLIN | EPOLLOUT ) : EPOLLIN;
+  ev.data.ptr = conn;
+  if ( epoll_ctl( _epollfd, EPOLL_CTL_MOD, conn->sck, &ev ) == 0 )
+    conn->want_write = want_write;
+}
+
+void ClientReactor::EventLoop::dispatch( Connection* conn, unsigned int events )
+{
+  Client* client = conn->client;
+  if ( !client->isReallyConnected() )
+    return;
+  if ( events & ( EPOLLERR | EPOLLHUP ) )
+  {
+    client->forceDisconnect();
+    return;
+  }
+  if ( events & EPOLLOUT )
+    conn->writable = true;
+  if ( events & EPOLLIN )
+  {
+    try
+    {
+      if ( Core::process_incoming_data( client ) )
+        conn->idle_warned = false;
+    }
+    catch ( std::string& str )
+    {
+      POLLOG_ERROR.Format( "Client#{}: Exception in network reactor: {}!\n" )
+          << client->instance_ << str;
+      client->forceDisconnect();
+    }
+    catch ( const char* msg )
+    {
+      POLLOG_ERROR.Format( "Client#{}: Exception in network reactor: {}!\n" )
+          << client->instance_ << msg;
+      client->forceDisconnect();
+    }
+    catch ( std::exception& ex )
+    {
+      POLLOG_ERROR.Format( "Client#{}: Exception in network reactor: {}!\n" )
+          << client->instance_ << ex.what();
+      client->forceDisconnect();
+    }
+  }
+}
+
+void ClientReactor::EventLoop::flush( std::vector<Connection*>& writable )
+{
+  if ( writable.empty() )
+    return;
+  {
+    // one lock for every client of this loop which is able to send
+    Core::PolLock lck;
+    for ( auto& conn : writable )
+    {
+      if ( conn->client->isReallyConnected() && conn->client->have_queued_data() )
+        conn->client->send_queued_data();
+    }
+  }
+  for ( auto& conn : writable )
+    conn->writable = false;
+  writable.clear();
+}
+
+void ClientReactor::EventLoop::service( Connection* conn, Core::polclock_t now,
+                                        bool check_timeouts )
+{
+  Client* client = conn->client;
+  if ( !client->isReallyConnected() )
+    return;
+  try
+  {
+    Core::process_movement_queue( client );
+  }
+  catch ( std::exception& ex )
+  {
+    POLLOG_ERROR.Format( "Client#{}: Exception in network reactor: {}!\n" )
+        << client->instance_ << ex.what();
+    client->forceDisconnect();
+    return;
+  }
+
+  if ( check_timeouts )
+  {
+    const auto& config = Plib::systemstate.config;
+    if ( ( !client->chr || client->chr->cmdlevel() < config.min_cmdlvl_ignore_inactivity ) &&
+         config.inactivity_warning_timeout && config.inactivity_disconnect_timeout )
+    {
+      Core::polclock_t idle = ( now - client->last_activity_at ) / Core::POLCLOCKS_PER_SEC;
+      if ( idle >= 60 * config.inactivity_disconnect_timeout )
+      {
+        client->forceDisconnect();
+        return;
+      }
+      else if ( !conn->idle_warned && idle >= 60 * config.inactivity_warning_timeout )
+      {
+        conn->idle_warned = true;
+        Core::send_inactivity_warning( client );
+      }
+    }
+    if ( ( ( now - client->last_packet_at ) / Core::POLCLOCKS_PER_SEC ) >= 120 )  // 2 mins
+    {
+      client->forceDisconnect();
+      return;
+    }
+  }
+  update_interest( conn );
+}
+
+void ClientReactor::EventLoop::release( Connection* conn, bool detach )
+{
+  Client* client = conn->client;
+  // if the socket got already closed (forceDisconnect from another thread) the kernel removed it
+  // already from the set, and the descriptor could already belong to someone else
+  if ( client->csocket != INVALID_SOCKET && client->csocket == conn->sck )
+    epoll_ctl( _epollfd, EPOLL_CTL_DEL, conn->sck, nullptr );
+
+  size_t slot = conn->slot;
+  if ( slot + 1 != _connections.size() )
+  {
+    _connections[slot] = std::move( _connections.back() );
+    _connections[slot]->slot = slot;
+  }
+  _connections.pop_back();  // conn is invalid from here on
+  --_count;
+
+  // the logoff handling sleeps until the logoff delay is over, never do that inside of the loop
+  if ( detach )
+    threadhelp::start_thread( client_logoff_thread, "Client Logoff", client );
+  else
+    Core::handle_client_disconnect( client );
+}
+
+void ClientReactor::EventLoop::run()
+{
+  const int max_events = 256;
+  epoll_event events[max_events];
+  std::vector<Connection*> writable;
+  Core::polclock_t last_timeout_check = Core::polclock();
+
+  if ( Plib::systemstate.config.loglevel >= 11 )
+    POLLOG.Format( "Network reactor #{} starting\n" ) << _index;
+
+  while ( !Clib::exit_signalled )
+  {
+    accept_pending();
+
+    int res = epoll_wait( _epollfd, events, max_events, reactor_timeout_ms() );
+    if ( res < 0 )
+    {
+      if ( errno == EINTR )
+        continue;
+      POLLOG_ERROR.Format( "Network reactor #{}: epoll_wait res={}, errno={}\n" )
+          << _index << res << errno;
+      break;
+    }
+
+    for ( int i = 0; i < res; ++i )
+    {
+      auto conn = static_cast<Connection*>( events[i].data.ptr );
+      if ( conn == nullptr )
+      {
+        u64 counter;
+        while ( read( _wakefd, &counter, sizeof counter ) > 0 )
+        {
+        }
+        continue;
+      }
+      dispatch( conn, events[i].events );
+      if ( conn->writable )
+        writable.push_back( conn );
+    }
+    flush( writable );
+
+    Core::polclock_t now = Core::polclock();
+    bool check_timeouts = ( now - last_timeout_check ) >= Core::POLCLOCKS_PER_SEC;
+    if ( check_timeouts )
+      last_timeout_check = now;
+    for ( size_t i = 0; i < _connections.size(); )
+    {
+      Connection* conn = _connections[i].get();
+      service( conn, now, check_timeouts );
+      if ( !conn->client->isReallyConnected() )
+        release( conn, true );  // the last connection moved into slot i
+      else
+        ++i;
+    }
+  }
+
+  // shutdown: the logoff handling does not wait anymore, so finish it directly
+  accept_pending();
+  while ( !_connections.empty() )
+    release( _connections.back().get(), false );
+}
+
+namespace
+{
+void reactor_thread( void* arg )
+{
+  static_cast<ClientReactor::EventLoop*>( arg )->run();
+}
+}  // namespace
+
+ClientReactor::ClientReactor( unsigned int loop_count ) : _loops()
+{
+  for ( unsigned int i = 0; i < loop_count; ++i )
+  {
+    _loops.emplace_back( new EventLoop( i ) );
+    std::string threadname = "Network Reactor " + Clib::tostring( i );
+    threadhelp::start_thread( reactor_thread, threadname.c_str(), _loops.back().get() );
+  }
+  INFO_PRINT << "Network reactor started with " << loop_count << " event loops\n";
+}
+
+ClientReactor::~ClientReactor() {}
+
+bool ClientReactor::supported()
+{
+  return true;
+}
+
+void ClientReactor::add( Client* client )
+{
+  EventLoop* target = _loops.front().get();
+  for ( const auto& loop : _loops )
+  {
+    if ( loop->size() < target->size() )
+      target = loop.get();
+  }
+  target->adopt( client );
+}
+
+size_t ClientReactor::client_count() const
+{
+  size_t count = 0;
+  for ( const auto& loop : _loops )
+    count += loop->size();
+  return count;
+}
+
+#else
+
+class ClientReactor::EventLoop
+{
+};
+
+ClientReactor::ClientReactor( unsigned int ) : _loops() {}
+ClientReactor::~ClientReactor() {}
+
+bool ClientReactor::supported()
+{
+  return false;
+}
+
+void ClientReactor::add( Client* )
+{
+  throw std::runtime_error( "Network reactor is not supported on this platform" );
+}
+
+size_t ClientReactor::client_count() const
+{
+  return 0;
+}
+#endif
+}  // namespace Network
+}  // namespace Pol
@@ -0,0 +1,49 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#ifndef CLIENTREACTOR_H
+#define CLIENTREACTOR_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Pol
+{
+namespace Network
+{
+class Client;
+
+/**
+ * Alternative to the one thread per client model:
+ * A fixed number of event loops (epoll) each drive the receive state machine (process_data) and
+ * the queued output of many clients.
+ * Enabled by pol.cfg NetworkReactorThreads, only available on linux.
+ */
+class ClientReactor
+{
+public:
+  explicit ClientReactor( unsigned int loop_count );
+  ~ClientReactor();
+  ClientReactor( const ClientReactor& ) = delete;
+  ClientReactor& operator=( const ClientReactor& ) = delete;
+
+  static bool supported();
+
+  // hands the client over to the least loaded event loop, from now on the loop owns the i/o of
+  // the client until it disconnects
+  void add( Client* client );
+  size_t client_count() const;
+
+  class EventLoop;
+
+private:
+  std::vector<std::unique_ptr<EventLoop>> _loops;
+};
+}  // namespace Network
+}  // namespace Pol
+
+#endif  // CLIENTREACTOR_H
@@ -128,15 +128,7 @@ bool client_io_thread( Network::Client* client, bool login )
           ++nidle;
           if ( nidle == 30 * Plib::systemstate.config.inactivity_warning_timeout )
           {
-            CLIENT_CHECKPOINT( 4 );
-            PolLock lck;  // multithread
-            Network::PktHelper::PacketOut<Network::PktOut_53> msg;
-            msg->Write<u8>( PKTOUT_53_WARN_CHARACTER_IDLE );
-            CLIENT_CHECKPOINT( 5 );
-            msg.Send( client );
-            CLIENT_CHECKPOINT( 18 );
-            if ( client->pause_count )
-              client->restart();
+            send_inactivity_warning( client );
           }
           else if ( nidle == 30 * Plib::systemstate.config.inactivity_disconnect_timeout )
           {
@@ -155,65 +147,15 @@ bool client_io_thread( Network::Client* client, bool login )
         break;
       }
 
-      // region Speedhack
-      if ( !client->movementqueue.empty() )  // not empty then process the first packet
-      {
-        PolLock lck;  // multithread
-        Network::PacketThrottler pkt = client->movementqueue.front();
-        if ( client->SpeedHackPrevention( false ) )
-        {
-          if ( client->isReallyConnected() )
-          {
-            unsigned char msgtype = pkt.pktbuffer[0];
-            Network::MSG_HANDLER packetHandler =
-                Network::PacketRegistry::find_handler( msgtype, client );
-            try
-            {
-              INFO_PRINT_TRACE( 10 ) << "Client#" << client->instance_ << ": message 0x"
-                                     << fmt::hexu( msgtype ) << "\n";
-              CLIENT_CHECKPOINT( 26 );
-              packetHandler.func( client, pkt.pktbuffer );
-              CLIENT_CHECKPOINT( 27 );
-              restart_all_clients();
-            }
-            catch ( std::exception& ex )
-            {
-              POLLOG_ERROR.Format( "Client#{}: Exception in message handler 0x{:X}: {}\n" )
-                  << client->instance_ << (int)msgtype << ex.what();
-              fmt::Writer tmp;
-              Clib::fdump( tmp, pkt.pktbuffer, 7 );
-              POLLOG << tmp.str() << "\n";
-              restart_all_clients();
-              throw;
-            }
-          }
-          client->movementqueue.pop();
-        }
-      }
-      // endregion Speedhack
+      process_movement_queue( client );
 
       if ( clientpoller.incoming() )
       {
         checkpoint = 4;
-        CLIENT_CHECKPOINT( 6 );
-        if ( process_data( client ) )
+        if ( process_incoming_data( client ) )
         {
-          CLIENT_CHECKPOINT( 17 );
-          PolLock lck;
-
-          // reset packet timer
-          client->last_packet_at = polclock();
-          if ( !check_inactivity( client ) )
-          {
-            nidle = 0;
-            client->last_activity_at = polclock();
-          }
-
           checkpoint = 5;
-          CLIENT_CHECKPOINT( 7 );
-          send_pulse();
-          if ( TaskScheduler::is_dirty() )
-            wake_tasks_thread();
+          nidle = 0;
         }
       }
       checkpoint = 6;
@@ -256,6 +198,88 @@ bool client_io_thread( Network::Client* client, bool login )
 
   if ( login && client->isConnected() )
     return true;
+  handle_client_disconnect( client );
+  return false;
+}
+
+void process_movement_queue( Network::Client* client )
+{
+  // region Speedhack
+  // not empty then process the first packet
+  if ( client->movementqueue.empty() )
+    return;
+
+  PolLock lck;  // multithread
+  Network::PacketThrottler pkt = client->movementqueue.front();
+  if ( client->SpeedHackPrevention( false ) )
+  {
+    if ( client->isReallyConnected() )
+    {
+      unsigned char msgtype = pkt.pktbuffer[0];
+      Network::MSG_HANDLER packetHandler = Network::PacketRegistry::find_handler( msgtype, client );
+      try
+      {
+        INFO_PRINT_TRACE( 10 ) << "Client#" << client->instance_ << ": message 0x"
+                               << fmt::hexu( msgtype ) << "\n";
+        CLIENT_CHECKPOINT( 26 );
+        packetHandler.func( client, pkt.pktbuffer );
+        CLIENT_CHECKPOINT( 27 );
+        restart_all_clients();
+      }
+      catch ( std::exception& ex )
+      {
+        POLLOG_ERROR.Format( "Client#{}: Exception in message handler 0x{:X}: {}\n" )
+            << client->instance_ << (int)msgtype << ex.what();
+        fmt::Writer tmp;
+        Clib::fdump( tmp, pkt.pktbuffer, 7 );
+        POLLOG << tmp.str() << "\n";
+        restart_all_clients();
+        throw;
+      }
+    }
+    client->movementqueue.pop();
+  }
+  // endregion Speedhack
+}
+
+bool process_incoming_data( Network::Client* client )
+{
+  CLIENT_CHECKPOINT( 6 );
+  if ( !process_data( client ) )
+    return false;
+
+  CLIENT_CHECKPOINT( 17 );
+  PolLock lck;
+
+  // reset packet timer
+  client->last_packet_at = polclock();
+  bool active = !check_inactivity( client );
+  if ( active )
+    client->last_activity_at = polclock();
+
+  CLIENT_CHECKPOINT( 7 );
+  send_pulse();
+  if ( TaskScheduler::is_dirty() )
+    wake_tasks_thread();
+  return active;
+}
+
+void send_inactivity_warning( Network::Client* client )
+{
+  CLIENT_CHECKPOINT( 4 );
+  PolLock lck;  // multithread
+  Network::PktHelper::PacketOut<Network::PktOut_53> msg;
+  msg->Write<u8>( PKTOUT_53_WARN_CHARACTER_IDLE );
+  CLIENT_CHECKPOINT( 5 );
+  msg.Send( client );
+  CLIENT_CHECKPOINT( 18 );
+  if ( client->pause_count )
+    client->restart();
+}
+
+void handle_client_disconnect( Network::Client* client )
+{
+  int checkpoint = 7;
   POLLOG.Format( "Client#{} ({}): disconnected (account {})\n" )
       << client->instance_ << client->ipaddrAsString()
       << ( ( client->acct != nullptr ) ? client->acct->name() : "unknown" );
@@ -315,7 +339,7 @@ bool client_io_thread( Network::Client* client, bool login )
       {
         CLIENT_CHECKPOINT( 14 );
         {
-          PolLock lck;
+          PolSharedLock lck;
           if ( polclock() >= when_logoff )
             break;
         }
@@ -348,7 +372,6 @@ bool client_io_thread( Network::Client* client, bool login )
 
   // queue delete of client ptr see method doc for reason
   Core::networkManager.clientTransmit->QueueDelete( client );
-  return false;
 }
 
 bool valid_message_length( Network::Client* client, unsigned int length )
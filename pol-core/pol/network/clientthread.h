@@ -13,6 +13,16 @@ bool client_io_thread( Network::Client* client, bool login );
 bool process_data( Network::Client* client );
 bool check_inactivity( Network::Client* client );
 
+// Building blocks of the client i/o loop, shared by the per-client threads and the reactor.
+// All of them acquire the PolLock themselves when needed.
+void process_movement_queue( Network::Client* client );
+// Reads and dispatches pending data, returns true if the client showed non-idle activity
+bool process_incoming_data( Network::Client* client );
+void send_inactivity_warning( Network::Client* client );
+// Unregisters the client, runs the logoff scripts and queues the client for deletion. Blocks until
+// the logoff delay is over.
+void handle_client_disconnect( Network::Client* client );
+
 void handle_unknown_packet( Network::Client* client );
 void handle_undefined_packet( Network::Client* client );
 void handle_humongous_packet( Network::Client* client, unsigned int reported_size );
@@ -29,6 +29,15 @@ void ClientTransmit::AddToQueue( Client* client, const void* data, int len )
   _transmitqueue.push_move( std::move( transmitdata ) );
 }
 
+void ClientTransmit::AddToQueue( Client* client, const SharedPacketData& data )
+{
+  auto transmitdata = TransmitDataSPtr( new TransmitData );
+  transmitdata->client = client->getWeakPtr();
+  transmitdata->len = static_cast<int>( data->size() );
+  transmitdata->shared = data;
+  _transmitqueue.push_move( std::move( transmitdata ) );
+}
+
 void ClientTransmit::QueueDisconnection( Client* client )
 {
   auto transmitdata = TransmitDataSPtr( new TransmitData );
@@ -72,7 +81,10 @@ void ClientTransmitThread()
           data->client->forceDisconnect();
         }
         else if ( data->client->isReallyConnected() )
-          data->client->transmit( static_cast<void*>( &data->data[0] ), data->len, true );
+        {
+          const u8* message = data->shared ? data->shared->data() : data->data.data();
+          data->client->transmit( message, data->len, true );
+        }
       }
     }
     catch ( ClientTransmitQueue::Canceled& )
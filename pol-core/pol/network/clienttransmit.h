@@ -15,12 +15,17 @@ namespace Network
 {
 class Client;
 
+// immutable packet copy, shared between the queue entries of all clients receiving the same packet
+typedef std::shared_ptr<const std::vector<u8>> SharedPacketData;
+
 struct TransmitData
 {
   // store a weak_ptr as a guard for pkts after deleting
   weak_ptr<Client> client;
   int len;
   std::vector<u8> data;
+  // used instead of data if set
+  SharedPacketData shared;
   bool disconnects;
   bool remove;
 
@@ -39,6 +44,8 @@ public:
   ClientTransmit& operator=( const ClientTransmit& ) = delete;
 
   void AddToQueue( Client* client, const void* data, int len );
+  // queues the packet without copying it, the compression/encryption still happens per client
+  void AddToQueue( Client* client, const SharedPacketData& data );
   void QueueDisconnection( Client* client );
   // queue delete and perform it in transmitthread, to be sure
   // that the weak_ptr stays valid without PolLock
@@ -0,0 +1,170 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#include "gumpcache.h"
+
+#include "pol_global_config.h"
+
+#include "../../plib/systemstate.h"
+#include <string.h>
+
+#ifdef USE_SYSTEM_ZLIB
+#include <zlib.h>
+#else
+#include "../../../lib/zlib/zlib.h"
+#endif
+
+namespace Pol
+{
+namespace Network
+{
+GumpCache::GumpCache()
+    : _mutex(), _lru(), _index(), _bytes( 0 ), _hits( 0 ), _misses( 0 ), _evictions( 0 )
+{
+}
+
+// FNV-1a over both blocks, the lengths separate layout and text
+u64 GumpCache::hash( const u8* layout, u32 layoutlen, const u8* text, u32 textlen )
+{
+  u64 h = 14695981039346656037ull;
+  auto add = [&h]( const u8* data, u32 len ) {
+    for ( u32 i = 0; i < len; ++i )
+    {
+      h ^= data[i];
+      h *= 1099511628211ull;
+    }
+    h ^= len;
+    h *= 1099511628211ull;
+  };
+  add( layout, layoutlen );
+  add( text, textlen );
+  return h;
+}
+
+bool GumpCache::compress( const u8* data, u32 len, Block& block )
+{
+  uLongf clen = compressBound( len );
+  block.data.resize( clen );
+  if ( compress2( reinterpret_cast<Bytef*>( &block.data[0] ), &clen, data, len,
+                  Z_DEFAULT_COMPRESSION ) != Z_OK )
+    return false;
+  block.data.resize( clen );
+  block.data.shrink_to_fit();
+  block.dlen = len;
+  return true;
+}
+
+size_t GumpCache::entrySize( const Entry& entry )
+{
+  return sizeof( Entry ) + entry.layout.data.capacity() + entry.text.data.capacity() +
+         entry.source.capacity();
+}
+
+bool GumpCache::matches( const Entry& entry, const u8* layout, u32 layoutlen, const u8* text,
+                         u32 textlen, u32 numlines )
+{
+  if ( entry.layout.dlen != layoutlen || entry.numlines != numlines ||
+       entry.source.size() != static_cast<size_t>( layoutlen ) + textlen )
+    return false;
+  const char* source = entry.source.data();
+  return ( layoutlen == 0 || memcmp( source, layout, layoutlen ) == 0 ) &&
+         ( textlen == 0 || memcmp( source + layoutlen, text, textlen ) == 0 );
+}
+
+std::shared_ptr<const GumpCache::Entry> GumpCache::get( const u8* layout, u32 layoutlen,
+                                                        const u8* text, u32 textlen, u32 numlines )
+{
+  size_t max_bytes = static_cast<size_t>( Plib::systemstate.config.gump_cache_size ) * 1024;
+  u64 key = hash( layout, layoutlen, text, textlen );
+  if ( max_bytes == 0 )
+    clear();  // disabled by a pol.cfg reload
+  else
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    auto itr = _index.find( key );
+    if ( itr != _index.end() )
+    {
+      // the hash only selects the candidate, the uncompressed bytes decide
+      if ( matches( *itr->second->second, layout, layoutlen, text, textlen, numlines ) )
+      {
+        _lru.splice( _lru.begin(), _lru, itr->second );
+        ++_hits;
+        return itr->second->second;
+      }
+    }
+    ++_misses;
+  }
+
+  // compress outside of the lock, other scripts can use the cache meanwhile
+  std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+  entry->numlines = numlines;
+  entry->text.dlen = 0;
+  if ( !compress( layout, layoutlen, entry->layout ) )
+    return nullptr;
+  if ( numlines != 0 && !compress( text, textlen, entry->text ) )
+    return nullptr;
+  if ( max_bytes == 0 )
+    return entry;
+  entry->source.reserve( static_cast<size_t>( layoutlen ) + textlen );
+  entry->source.assign( reinterpret_cast<const char*>( layout ), layoutlen );
+  entry->source.append( reinterpret_cast<const char*>( text ), textlen );
+
+  std::lock_guard<std::mutex> lock( _mutex );
+  auto itr = _index.find( key );
+  if ( itr != _index.end() )
+  {
+    _bytes -= entrySize( *itr->second->second );
+    _lru.erase( itr->second );
+    _index.erase( itr );
+  }
+  _lru.emplace_front( key, entry );
+  _index[key] = _lru.begin();
+  _bytes += entrySize( *entry );
+  evict( max_bytes );
+  return entry;
+}
+
+// drops the least recently used entries until the cache fits into max_bytes
+void GumpCache::evict( size_t max_bytes )
+{
+  while ( _bytes > max_bytes && !_lru.empty() )
+  {
+    _bytes -= entrySize( *_lru.back().second );
+    _index.erase( _lru.back().first );
+    _lru.pop_back();
+    ++_evictions;
+  }
+}
+
+void GumpCache::clear()
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  _lru.clear();
+  _index.clear();
+  _bytes = 0;
+}
+
+GumpCache::Stats GumpCache::stats() const
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  Stats stats;
+  stats.hits = _hits;
+  stats.misses = _misses;
+  stats.evictions = _evictions;
+  stats.entries = _lru.size();
+  stats.bytes = _bytes;
+  return stats;
+}
+
+size_t GumpCache::estimateSize() const
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  return sizeof( GumpCache ) + _bytes +
+         _lru.size() * ( 3 * sizeof( void* ) + sizeof( LruList::value_type ) +
+                         sizeof( std::pair<u64, LruList::iterator> ) + 2 * sizeof( void* ) );
+}
+}  // namespace Network
+}  // namespace Pol
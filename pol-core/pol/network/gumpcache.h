@@ -0,0 +1,88 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#ifndef POL_GUMPCACHE_H
+#define POL_GUMPCACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <string>
+#include <unordered_map>
+
+#include "../../clib/rawtypes.h"
+
+namespace Pol
+{
+namespace Network
+{
+/**
+ * Compressed layout and text blocks of the gumps sent with packet 0xDD.
+ * Most gumps (spellbooks, crafting menus, help pages) are identical for every player,
+ * so the zlib output is kept keyed by a hash of the uncompressed data and only the
+ * per send header (serial, gumpid, position) is written for each packet.
+ * Layout and text may carry player controlled strings, so a hit is only accepted if the
+ * uncompressed bytes are equal, a hash collision can never leak another gump.
+ * Least recently used entries get dropped when the size set by pol.cfg GumpCacheSize
+ * is exceeded.
+ */
+class GumpCache
+{
+public:
+  struct Block
+  {
+    std::string data;  // zlib compressed
+    u32 dlen;          // uncompressed length
+  };
+  struct Entry
+  {
+    Block layout;
+    Block text;  // empty if numlines is 0
+    u32 numlines;
+    std::string source;  // uncompressed layout followed by the text, compared on every hit
+  };
+  struct Stats
+  {
+    u64 hits;
+    u64 misses;
+    u64 evictions;
+    size_t entries;
+    size_t bytes;
+  };
+
+  GumpCache();
+  GumpCache( const GumpCache& ) = delete;
+  GumpCache& operator=( const GumpCache& ) = delete;
+
+  // compressed form of the given uncompressed layout and text lines, nullptr if zlib fails
+  std::shared_ptr<const Entry> get( const u8* layout, u32 layoutlen, const u8* text, u32 textlen,
+                                    u32 numlines );
+  void clear();
+  Stats stats() const;
+  size_t estimateSize() const;
+
+private:
+  typedef std::list<std::pair<u64, std::shared_ptr<const Entry>>> LruList;
+
+  static u64 hash( const u8* layout, u32 layoutlen, const u8* text, u32 textlen );
+  static bool compress( const u8* data, u32 len, Block& block );
+  static size_t entrySize( const Entry& entry );
+  static bool matches( const Entry& entry, const u8* layout, u32 layoutlen, const u8* text,
+                       u32 textlen, u32 numlines );
+  void evict( size_t max_bytes );
+
+  mutable std::mutex _mutex;
+  LruList _lru;  // most recently used first
+  std::unordered_map<u64, LruList::iterator> _index;
+  size_t _bytes;
+  u64 _hits;
+  u64 _misses;
+  u64 _evictions;
+};
+}  // namespace Network
+}  // namespace Pol
+#endif
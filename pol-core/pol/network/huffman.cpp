@@ -0,0 +1,76 @@
+#include "huffman.h"
+
+#include "../../clib/rawtypes.h"
+#include "../ctable.h"
+
+namespace Pol
+{
+namespace Network
+{
+namespace
+{
+// code (MSB first) in the upper bits, length in the lower 5 bits
+struct HuffmanTable
+{
+  u32 entries[257];
+
+  HuffmanTable()
+  {
+    for ( unsigned int i = 0; i < 257; ++i )
+    {
+      unsigned int nbits = Core::keydesc[i].nbits;
+      unsigned int reversed = Core::keydesc[i].bits_reversed;
+      u32 code = 0;
+      for ( unsigned int bit = 0; bit < nbits; ++bit )
+      {
+        code = ( code << 1 ) | ( reversed & 1 );
+        reversed >>= 1;
+      }
+      entries[i] = ( code << 5 ) | nbits;
+    }
+  }
+};
+
+// keydesc is constant initialized, so it is safe to use during dynamic initialization
+const HuffmanTable huffman_table;
+}  // namespace
+
+unsigned int huffman_compress( unsigned char* out, const unsigned char* data, unsigned int len )
+{
+  const u32* table = huffman_table.entries;
+  unsigned char* pch = out;
+  u64 acc = 0;
+  unsigned int nbits = 0;  // valid bits in the lower part of acc
+
+  for ( unsigned int i = 0; i < len; ++i )
+  {
+    u32 entry = table[data[i]];
+    acc = ( acc << ( entry & 0x1f ) ) | ( entry >> 5 );
+    nbits += entry & 0x1f;
+    if ( nbits >= 32 )
+    {
+      nbits -= 32;
+      u32 word = static_cast<u32>( acc >> nbits );
+      pch[0] = static_cast<unsigned char>( word >> 24 );
+      pch[1] = static_cast<unsigned char>( word >> 16 );
+      pch[2] = static_cast<unsigned char>( word >> 8 );
+      pch[3] = static_cast<unsigned char>( word );
+      pch += 4;
+    }
+  }
+
+  u32 entry = table[0x100];
+  acc = ( acc << ( entry & 0x1f ) ) | ( entry >> 5 );
+  nbits += entry & 0x1f;
+  while ( nbits >= 8 )
+  {
+    nbits -= 8;
+    *pch++ = static_cast<unsigned char>( acc >> nbits );
+  }
+  if ( nbits )
+    *pch++ = static_cast<unsigned char>( acc << ( 8 - nbits ) );
+
+  return static_cast<unsigned int>( pch - out );
+}
+}  // namespace Network
+}  // namespace Pol
@@ -0,0 +1,19 @@
+/** @file
+ *
+ * @par History
+ */
+
+#ifndef NETWORK_HUFFMAN_H
+#define NETWORK_HUFFMAN_H
+
+namespace Pol
+{
+namespace Network
+{
+// Compresses the server to client stream with the code table of Core::keydesc, including the
+// terminator code. Works on a 64bit accumulator instead of single bits.
+// Returns the number of bytes written into out.
+unsigned int huffman_compress( unsigned char* out, const unsigned char* data, unsigned int len );
+}  // namespace Network
+}  // namespace Pol
+#endif
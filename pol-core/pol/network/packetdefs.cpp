@@ -19,15 +19,15 @@ void SendWorldItem::Send( Client* client )
     if ( _p->offset == 1 )
       buildF3();
     if ( client->ClientType & CLIENTTYPE_7090 ) /*once known split class?*/
-      _p.Send( client, 26 );
+      _p.SendShared( client, 26 );
     else
-      _p.Send( client, 24 );
+      _p.SendShared( client, 24 );
   }
   else
   {
     if ( _p_old->offset == 1 )
       build1A();
-    _p_old.Send( client, _p_oldlen );
+    _p_old.SendShared( client, _p_oldlen );
   }
 }
 
@@ -167,15 +167,15 @@ void SendWorldMulti::Send( Client* client )
     if ( _p->offset == 1 )
       buildF3();
     if ( client->ClientType & CLIENTTYPE_7090 ) /*once known split class?*/
-      _p.Send( client, 26 );
+      _p.SendShared( client, 26 );
     else
-      _p.Send( client, 24 );
+      _p.SendShared( client, 24 );
   }
   else
   {
     if ( _p_old->offset == 1 )
       build1A();
-    _p_old.Send( client, _p_oldlen );
+    _p_old.SendShared( client, _p_oldlen );
   }
 }
 
@@ -228,13 +228,13 @@ void AddItemContainerMsg::Send( Client* client )
   {
     if ( _p->offset == 1 )
       build();
-    _p.Send( client, _p->getSize() );
+    _p.SendShared( client, _p->getSize() );
   }
   else
   {
     if ( _p_old->offset == 1 )
       buildLegacy();
-    _p_old.Send( client, _p->getSize() - 1 );
+    _p_old.SendShared( client, _p->getSize() - 1 );
   }
 }
 
@@ -330,7 +330,7 @@ void MobileAnimationMsg::Send( Client* client )
       return;
     if ( _p->offset == 1 )
       build();
-    _p.Send( client, _p->getSize() );
+    _p.SendShared( client, _p->getSize() );
   }
   else
   {
@@ -338,7 +338,7 @@ void MobileAnimationMsg::Send( Client* client )
       return;
     if ( _p_old->offset == 1 )
       build6E();
-    _p_old.Send( client, _p_old->getSize() );
+    _p_old.SendShared( client, _p_old->getSize() );
   }
 }
 
@@ -358,7 +358,7 @@ void PlaySoundPkt::Send( Client* client )
 {
   if ( _p->offset == 1 )
     build();
-  _p.Send( client, _p->getSize() );
+  _p.SendShared( client, _p->getSize() );
 }
 
 void PlaySoundPkt::build()
@@ -385,7 +385,7 @@ void RemoveObjectPkt::Send( Client* client )
 {
   if ( _p->offset == 1 )
     build();
-  _p.Send( client, _p->getSize() );
+  _p.SendShared( client, _p->getSize() );
 }
 
 void RemoveObjectPkt::build()
@@ -404,13 +404,13 @@ void SendDamagePkt::Send( Client* client )
   {
     if ( _p->offset == 1 )
       build();
-    _p.Send( client, _p->getSize() );
+    _p.SendShared( client, _p->getSize() );
   }
   else
   {
     if ( _p_old->offset == 1 )
       buildold();
-    _p_old.Send( client );
+    _p_old.SendShared( client );
   }
 }
 
@@ -450,13 +450,13 @@ void ObjRevisionPkt::Send( Client* client )
       {
         if ( _p->offset == 1 )
           build();
-        _p.Send( client, _p->getSize() );
+        _p.SendShared( client, _p->getSize() );
       }
       else
       {
         if ( _p_old->offset == 1 )
           buildold();
-        _p_old.Send( client );
+        _p_old.SendShared( client );
       }
     }
   }
@@ -633,7 +633,7 @@ void GraphicEffectPkt::Send( Client* client )
 {
   if ( _p->offset == 1 )
     build();
-  _p.Send( client, _p->getSize() );
+  _p.SendShared( client, _p->getSize() );
 }
 
 
@@ -836,7 +836,7 @@ void GraphicEffectExPkt::Send( Client* client )
 {
   if ( _p->offset == 1 )
     build();
-  _p.Send( client, _p->getSize() );
+  _p.SendShared( client, _p->getSize() );
 }
 
 
@@ -859,7 +859,7 @@ void HealthBarStatusUpdate::Send( Client* client )
   {
     if ( _p->offset == 1 )
       build();
-    _p.Send( client );
+    _p.SendShared( client );
   }
 }
 
@@ -885,7 +885,7 @@ void MoveChrPkt::Send( Client* client )
   _p->offset = 15;
   _p->Write<u8>( _chr->get_flag1( client ) );
   _p->Write<u8>( _chr->hilite_color_idx( client->chr ) );
-  _p.Send( client );
+  _p.SendShared( client );
 }
 }  // namespace Network
 }  // namespace Pol
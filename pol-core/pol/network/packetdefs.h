@@ -21,6 +21,8 @@ namespace Network
 {
 class Client;
 
+// build once and call Send for every client in range, the packet gets copied only once
+// (PacketOut::SendShared)
 class PktSender
 {
 public:
@@ -1,6 +1,9 @@
 #ifndef __PACKETHELPER_H
 #define __PACKETHELPER_H
 
+#include <cstring>
+#include <memory>
+
 #include "../globals/network.h"
 #include "client.h"
 #include "clienttransmit.h"
@@ -32,12 +35,18 @@ class PacketOut
 {
 private:
   T* pkt;
+  mutable SharedPacketData _shared;
 
 public:
   PacketOut();
   ~PacketOut();
   void Release();
   void Send( Client* client, int len = -1 ) const;
+  // for packets which get sent to many clients: the packet gets copied only once and the copy is
+  // shared by the queue entries, as long as the content does not change between the calls
+  void SendShared( Client* client, int len = -1 ) const;
+  // the copy SendShared queues, made again only if the first len bytes changed
+  SharedPacketData Shared( int len = -1 ) const;
   // be really really careful with this function
   // needs PolLock
   void SendDirect( Client* client, int len = -1 ) const;
@@ -75,6 +84,29 @@ void PacketOut<T>::Send( Client* client, int len ) const
   Core::networkManager.clientTransmit->AddToQueue( client, &pkt->buffer, len );
 }
 
+template <class T>
+void PacketOut<T>::SendShared( Client* client, int len ) const
+{
+  if ( pkt == 0 )
+    return;
+  Core::networkManager.clientTransmit->AddToQueue( client, Shared( len ) );
+}
+
+template <class T>
+SharedPacketData PacketOut<T>::Shared( int len ) const
+{
+  if ( pkt == 0 )
+    return SharedPacketData();
+  if ( len == -1 )
+    len = pkt->offset;
+  const u8* data = reinterpret_cast<const u8*>( &pkt->buffer );
+  // compare instead of tracking every write, packets are small
+  if ( !_shared || _shared->size() != static_cast<size_t>( len ) ||
+       memcmp( _shared->data(), data, len ) != 0 )
+    _shared = std::make_shared<const std::vector<u8>>( data, data + len );
+  return _shared;
+}
+
 template <class T>
 void PacketOut<T>::SendDirect( Client* client, int len ) const
 {
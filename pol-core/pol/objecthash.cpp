@@ -7,6 +7,7 @@
 
 #include "objecthash.h"
 
+#include <algorithm>
 #include <stddef.h>
 
 #include "../clib/clib_endian.h"
@@ -23,21 +24,19 @@ namespace Pol
 {
 namespace Core
 {
-ObjectHash::ObjectHash() : hash(), reap_iterator( hash.end() ){};
+ObjectHash::ObjectHash() : hash(), reap_serials(), reap_pos( 0 ){};
 
 ObjectHash::~ObjectHash(){};
 
 bool ObjectHash::Insert( UObject* obj )
 {
-  OH_iterator itr = hash.find( obj->serial );
-  if ( itr != hash.end() )
+  if ( !hash.insert( obj->serial, UObjectRef( obj ) ) )
   {
     if ( Plib::systemstate.config.loglevel >= 5 )
       POLLOG.Format( "ObjectHash insert failed for object serial 0x{:X}. (duplicate serial?)\n" )
           << obj->serial;
     return false;
   }
-  hash.insert( hash.end(), std::make_pair( obj->serial, UObjectRef( obj ) ) );
   return true;
 }
 
@@ -51,11 +50,7 @@ bool ObjectHash::Remove( u32 /*serial*/ )
 
 UObject* ObjectHash::Find( u32 serial )
 {
-  OH_iterator itr = hash.find( serial );
-  if ( itr != hash.end() )
-    return ( itr->second ).get();
-  else
-    return nullptr;
+  return hash.find( serial );
 }
 
 u32 ObjectHash::GetNextUnusedItemSerial()
@@ -70,7 +65,7 @@ u32 ObjectHash::GetNextUnusedItemSerial()
     if ( tempserial < ITEMSERIAL_START || tempserial > ITEMSERIAL_END )
       tempserial = ITEMSERIAL_START;
 
-    if ( hash.find( tempserial ) != hash.end() )
+    if ( hash.find( tempserial ) != nullptr )
     {
       tempserial++;
       continue;
@@ -105,7 +100,7 @@ u32 ObjectHash::GetNextUnusedCharSerial()
     if ( tempserial < CHARACTERSERIAL_START || tempserial > CHARACTERSERIAL_END )
       tempserial = CHARACTERSERIAL_START;
 
-    if ( hash.find( tempserial ) != hash.end() )
+    if ( hash.find( tempserial ) != nullptr )
     {
       tempserial++;
       continue;
@@ -130,12 +125,11 @@ u32 ObjectHash::GetNextUnusedCharSerial()
 
 void ObjectHash::PrintContents( Clib::StreamWriter& sw ) const
 {
-  OH_const_iterator itr, itrend;
   sw() << "Object Count: " << hash.size() << "\n";
-  for ( itr = hash.begin(), itrend = hash.end(); itr != itrend; ++itr )
+  for ( const UObject* obj : Ordered() )
   {
-    sw() << "type: " << itr->second->classname() << " serial: 0x"
-         << fmt::hexu( itr->second->serial ) << " name: " << itr->second->name() << "\n";
+    sw() << "type: " << obj->classname() << " serial: 0x" << fmt::hexu( obj->serial )
+         << " name: " << obj->name() << "\n";
     // itr->second->printOn( sw ); // its no more safe to try to print the complete object
   }
 }
@@ -148,34 +142,35 @@ void ObjectHash::Reap()
   // 30 minutes = 1800 seconds = 900 reap calls per sweep
 
   // first, figure out how many objects to check:
-  hs::size_type count = hash.size();
+  size_t count = hash.size();
   if ( count == 0 )
     return;
-  hs::size_type count_this = count / 60;
+  size_t count_this = count / 60;
   if ( count_this < 1 )
     count_this = 1;
-  if ( reap_iterator == hash.end() )
-    reap_iterator = hash.begin();
 
   while ( count_this-- )
   {
-    UObject* obj = ( *reap_iterator ).second.get();
+    // a sweep walks the serials in order, objects created meanwhile wait for the next one
+    if ( reap_pos >= reap_serials.size() )
+    {
+      reap_serials.clear();
+      reap_serials.reserve( hash.size() );
+      hash.for_each( [this]( UObject* obj ) { reap_serials.push_back( obj->serial ); } );
+      std::sort( reap_serials.begin(), reap_serials.end() );
+      reap_pos = 0;
+    }
+    u32 serial = reap_serials[reap_pos++];
+    UObject* obj = hash.find( serial );
+    if ( obj == nullptr )
+      continue;
 
     // We want the objecthash to be the holder of the last reference to an
     // object when it is deleted - hence the ref_counted_count() check.
     if ( obj->orphan() && obj->ref_counted_count() == 1 )
     {
       dirty_deleted.insert( cfBEu32( obj->serial_ext ) );
-      hash.erase( reap_iterator++ );
-    }
-    else
-      ++reap_iterator;
-
-    if ( reap_iterator == hash.end() )
-    {
-      reap_iterator = hash.begin();
-      if ( reap_iterator == hash.end() )
-        break;
+      hash.erase( serial );
     }
   }
 }
@@ -186,32 +181,31 @@ void ObjectHash::Clear()
   do
   {
     any = false;
-    unsigned skipped = 0;
-    for ( OH_iterator itr = hash.begin(), itrend = hash.end(); itr != itrend; )
-    {
-      UObject* obj = ( *itr ).second.get();
-
+    std::vector<u32> unused;
+    hash.for_each( [&unused]( UObject* obj ) {
       if ( obj->orphan() && obj->ref_counted_count() == 1 )
-      {
-        hash.erase( itr++ );
+        unused.push_back( obj->serial );
+    } );
+    // erasing may release the last references to further objects
+    for ( u32 serial : unused )
+    {
+      if ( hash.erase( serial ) )
         any = true;
-      }
-      else
-      {
-        ++skipped;
-        ++itr;
-      }
     }
   } while ( any );
+  reap_serials.clear();
+  reap_pos = 0;
   if ( !hash.empty() )
   {
     INFO_PRINT << "Leftover objects in objecthash: " << hash.size() << "\n";
 
     // the hash will be cleared after main() exits, with other statics.
     // this usually causes assertion failures and crashes.
-    // creating a copy of the internal hash will ensure no refcounts reach zero.
+    // leaking a reference to every leftover will ensure no refcounts reach zero.
     INFO_PRINT << "Leaking a copy of the objecthash in order to avoid a crash.\n";
-    new hs( hash );
+    auto leaked = new std::vector<UObjectRef>();
+    leaked->reserve( hash.size() );
+    hash.for_each( [leaked]( UObject* obj ) { leaked->emplace_back( obj ); } );
   }
   //    hash.clear();
 }
@@ -219,9 +213,9 @@ void ObjectHash::Clear()
 
 void ObjectHash::ClearCharacterAccountReferences()
 {
-  for ( OH_const_iterator itr = hash.begin(), itrend = hash.end(); itr != itrend; ++itr )
+  // destroy() does arbitrary cleanup, walk a snapshot instead of the table
+  for ( UObject* obj : Ordered() )
   {
-    UObject* obj = ( *itr ).second.get();
     if ( !obj->orphan() && obj->ismobile() )
     {
       Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -236,14 +230,24 @@ void ObjectHash::ClearCharacterAccountReferences()
   }
 }
 
-ObjectHash::hs::const_iterator ObjectHash::begin() const
+size_t ObjectHash::size() const
+{
+  return hash.size();
+}
+
+std::vector<UObject*> ObjectHash::Ordered() const
 {
-  return hash.begin();
+  std::vector<UObject*> objs;
+  objs.reserve( hash.size() );
+  hash.for_each( [&objs]( UObject* obj ) { objs.push_back( obj ); } );
+  std::sort( objs.begin(), objs.end(),
+             []( const UObject* a, const UObject* b ) { return a->serial < b->serial; } );
+  return objs;
 }
 
-ObjectHash::hs::const_iterator ObjectHash::end() const
+size_t ObjectHash::estimatedIndexSize() const
 {
-  return hash.end();
+  return hash.estimatedSize();
 }
 
 ObjectHash::ds::const_iterator ObjectHash::dirty_deleted_begin() const
@@ -7,12 +7,12 @@
 #ifndef __OBJECTHASH_H
 #define __OBJECTHASH_H
 
-#include <map>
 #include <unordered_set>
-#include <utility>
+#include <vector>
 
 #include "../clib/rawtypes.h"
 #include "reftypes.h"
+#include "serialindex.h"
 
 namespace Pol
 {
@@ -41,10 +41,7 @@ class ObjectHash
 {
 public:
   typedef std::unordered_set<u32> ds;
-  typedef std::pair<u32, UObjectRef> hashpair;
-  typedef std::map<u32, UObjectRef> hs;
-  typedef hs::iterator OH_iterator;
-  typedef hs::const_iterator OH_const_iterator;
+  typedef SerialIndex<UObject, UObjectRef> hs;
 
   ObjectHash();
   ~ObjectHash();
@@ -59,8 +56,16 @@ public:
   u32 GetNextUnusedCharSerial();
   void PrintContents( Clib::StreamWriter& sw ) const;
 
-  hs::const_iterator begin() const;
-  hs::const_iterator end() const;
+  size_t size() const;
+  // f( UObject* ) for every object, in no particular order
+  template <class F>
+  void ForEach( F f ) const
+  {
+    hash.for_each( f );
+  }
+  // the objects sorted by serial, for the saves
+  std::vector<UObject*> Ordered() const;
+  size_t estimatedIndexSize() const;
   void ClearCharacterAccountReferences();
 
   ds::const_iterator dirty_deleted_begin() const;
@@ -73,7 +78,9 @@ public:
 
 private:
   hs hash;
-  OH_iterator reap_iterator;
+  // serials of the current reap sweep, taken sorted at its start
+  std::vector<u32> reap_serials;
+  size_t reap_pos;
 
   ds dirty_deleted;
   ds clean_deleted;
@@ -0,0 +1,224 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#include "parallelcfgread.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "../clib/cfgelem.h"
+#include "../clib/logfacility.h"
+#include "../clib/timer.h"
+#include "globals/uvars.h"
+#include <format/format.h>
+
+namespace Pol
+{
+namespace Core
+{
+namespace
+{
+const size_t CHUNK_SIZE = 1024 * 1024;
+}  // namespace
+
+struct ParallelConfigReader::Chunk
+{
+  std::string content;
+  int first_line = 0;
+  std::vector<Clib::ConfigElem> elems;
+  std::vector<unsigned int> lines;
+  std::future<bool> parsed;
+};
+
+ParallelConfigReader::ParallelConfigReader( const std::string& filename,
+                                            const char* allowed_types )
+    : _filename( filename ),
+      _allowed_types( allowed_types != nullptr ? allowed_types : "" ),
+      _binary(),
+      _fp( nullptr ),
+      _carry(),
+      _next_line( 0 ),
+      _chunks(),
+      _max_chunks( std::max( size_t( 2 ), gamestate.task_thread_pool.size() * 2 ) ),
+      _front_parsed( false ),
+      _elem_index( 0 ),
+      _element_line_start( 0 ),
+      _read_time( 0 ),
+      _wait_time( 0 )
+{
+  if ( Clib::BinaryConfigFile::is_binary( filename ) )
+  {
+    _binary.reset( new Clib::BinaryConfigFile( filename, allowed_types ) );
+    return;
+  }
+  _fp = fopen( filename.c_str(), "rb" );
+  if ( !_fp )
+  {
+    POLLOG_ERROR << "Unable to open configuration file " << _filename << " " << errno << ": "
+                 << std::strerror( errno ) << "\n";
+    throw std::runtime_error( std::string( "Unable to open configuration file " ) + _filename );
+  }
+}
+
+ParallelConfigReader::~ParallelConfigReader()
+{
+  // chunks still being parsed are kept alive by their task
+  if ( _fp )
+    fclose( _fp );
+  _fp = nullptr;
+}
+
+const std::string& ParallelConfigReader::filename() const
+{
+  return _filename;
+}
+
+ParallelConfigReader::duration ParallelConfigReader::read_time() const
+{
+  return _read_time;
+}
+
+ParallelConfigReader::duration ParallelConfigReader::wait_time() const
+{
+  return _wait_time;
+}
+
+std::string ParallelConfigReader::timing_summary( long long total_ms ) const
+{
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  long long read_ms = duration_cast<milliseconds>( _read_time ).count();
+  long long wait_ms = duration_cast<milliseconds>( _wait_time ).count();
+  fmt::Writer tmp;
+  tmp << "read " << read_ms << " ms, waiting for parser " << wait_ms << " ms, applying "
+      << std::max( 0LL, total_ms - read_ms - wait_ms ) << " ms";
+  return tmp.str();
+}
+
+// reads the next part of the file, which ends with a complete element
+bool ParallelConfigReader::next_chunk( std::string& content )
+{
+  content.swap( _carry );
+  _carry.clear();
+  while ( _fp != nullptr )
+  {
+    size_t size = content.size();
+    content.resize( size + CHUNK_SIZE );
+    size_t count = fread( &content[size], 1, CHUNK_SIZE, _fp );
+    content.resize( size + count );
+    if ( count < CHUNK_SIZE )
+    {
+      fclose( _fp );
+      _fp = nullptr;
+      break;
+    }
+    size_t end = Clib::last_element_end( content );
+    if ( end != std::string::npos )
+    {
+      _carry.assign( content, end, std::string::npos );
+      content.resize( end );
+      return true;
+    }
+    // element larger than the chunk size, continue reading
+  }
+  return !content.empty();
+}
+
+void ParallelConfigReader::fill()
+{
+  while ( _chunks.size() < _max_chunks )
+  {
+    Tools::HighPerfTimer timer;
+    auto chunk = std::make_shared<Chunk>();
+    bool got_chunk = next_chunk( chunk->content );
+    _read_time += timer.ellapsed();
+    if ( !got_chunk )
+      return;
+
+    chunk->first_line = _next_line;
+    _next_line += static_cast<int>(
+        std::count( chunk->content.begin(), chunk->content.end(), '\n' ) );
+
+    std::string filename = _filename;
+    std::string allowed_types = _allowed_types;
+    chunk->parsed = gamestate.task_thread_pool.checked_push( [chunk, filename, allowed_types]() {
+      Clib::ConfigFile cf( filename, std::move( chunk->content ), chunk->first_line,
+                           allowed_types.empty() ? nullptr : allowed_types.c_str() );
+      chunk->elems.emplace_back();
+      while ( cf.read( chunk->elems.back() ) )
+      {
+        chunk->lines.push_back( cf.element_line_start() );
+        chunk->elems.emplace_back();
+      }
+      chunk->elems.pop_back();
+    } );
+    _chunks.push_back( std::move( chunk ) );
+  }
+}
+
+bool ParallelConfigReader::read( Clib::ConfigElem& elem )
+{
+  if ( _binary )
+  {
+    Tools::HighPerfTimer timer;
+    bool result = _binary->read( elem );
+    _read_time += timer.ellapsed();
+    return result;
+  }
+  for ( ;; )
+  {
+    fill();
+    if ( _chunks.empty() )
+      return false;
+
+    Chunk& chunk = *_chunks.front();
+    if ( !_front_parsed )
+    {
+      Tools::HighPerfTimer timer;
+      chunk.parsed.get();  // rethrows parse errors
+      _wait_time += timer.ellapsed();
+      _front_parsed = true;
+    }
+    if ( _elem_index < chunk.elems.size() )
+    {
+      _element_line_start = chunk.lines[_elem_index];
+      elem = std::move( chunk.elems[_elem_index] );
+      elem.set_source( this );
+      ++_elem_index;
+      return true;
+    }
+    _chunks.pop_front();
+    _front_parsed = false;
+    _elem_index = 0;
+  }
+}
+
+void ParallelConfigReader::display_error( const std::string& msg, bool /*show_curline*/,
+                                          const Clib::ConfigElemBase* elem, bool error ) const
+{
+  fmt::Writer tmp;
+  tmp << ( error ? "Error" : "Warning" ) << " reading configuration file " << _filename << ":\n"
+      << "\t" << msg << "\n";
+
+  if ( elem != nullptr && strlen( elem->type() ) > 0 )
+  {
+    tmp << "\tElement: " << elem->type() << " " << elem->rest();
+    if ( _element_line_start )
+      tmp << ", found on line " << _element_line_start;
+    tmp << "\n";
+  }
+  else if ( _element_line_start )
+  {
+    tmp << "\tElement started on line: " << _element_line_start << "\n";
+  }
+  ERROR_PRINT << tmp.str();
+}
+}  // namespace Core
+}  // namespace Pol
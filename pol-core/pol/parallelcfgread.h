@@ -0,0 +1,79 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#ifndef PARALLELCFGREAD_H
+#define PARALLELCFGREAD_H
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <stdio.h>
+#include <string>
+
+#include "../clib/binarycfg.h"
+#include "../clib/cfgfile.h"
+
+namespace Pol
+{
+namespace Clib
+{
+class ConfigElem;
+}
+namespace Core
+{
+/**
+ * Reads a data file like Clib::ConfigFile, but parses it in parallel:
+ * The main thread splits the file at element boundaries into chunks, the chunks get parsed into
+ * ConfigElems on the task thread pool and read() hands out the elements in file order.
+ * Files in the binary format need no parsing, they are decoded directly from the mapped file.
+ */
+class ParallelConfigReader : public Clib::ConfigSource
+{
+public:
+  typedef std::chrono::microseconds duration;
+
+  ParallelConfigReader( const std::string& filename, const char* allowed_types = nullptr );
+  virtual ~ParallelConfigReader();
+  ParallelConfigReader( const ParallelConfigReader& ) = delete;
+  ParallelConfigReader& operator=( const ParallelConfigReader& ) = delete;
+
+  bool read( Clib::ConfigElem& elem );  // true=got one, false=end of file
+
+  const std::string& filename() const;
+  // time the caller spent in read() reading the file
+  duration read_time() const;
+  // time the caller spent in read() waiting for chunks to be parsed
+  duration wait_time() const;
+  // per file breakdown of a load which took total_ms, for the startup log
+  std::string timing_summary( long long total_ms ) const;
+
+  virtual void display_error( const std::string& msg, bool show_curline = true,
+                              const Clib::ConfigElemBase* elem = nullptr,
+                              bool error = true ) const override;
+
+private:
+  struct Chunk;
+  bool next_chunk( std::string& content );
+  void fill();
+
+  std::string _filename;
+  std::string _allowed_types;
+  std::unique_ptr<Clib::BinaryConfigFile> _binary;
+  FILE* _fp;
+  std::string _carry;  // begin of an element which did not fit into the last chunk
+  int _next_line;
+  std::deque<std::shared_ptr<Chunk>> _chunks;
+  size_t _max_chunks;
+  bool _front_parsed;
+  size_t _elem_index;
+  unsigned int _element_line_start;
+  duration _read_time;
+  duration _wait_time;
+};
+}  // namespace Core
+}  // namespace Pol
+
+#endif  // PARALLELCFGREAD_H
@@ -680,6 +680,7 @@ void threadstatus_thread( void )
       fmt::Writer tmp;
       tmp << "*Thread Info*\n";
       tmp << "Semaphore TID: " << locker << "\n";
+      tmp << "Semaphore shared holders: " << shared_lockers << "\n";
 
       if ( Plib::systemstate.config.log_traces_when_stuck )
         Pol::Clib::ExceptionParser::logAllStackTraces();
@@ -691,11 +692,17 @@ void threadstatus_thread( void )
       tmp << "Tasks Thread Checkpoint: " << stateManager.polsig.tasks_thread_checkpoint << "\n";
       tmp << "Active Client Thread Checkpoint: "
           << stateManager.polsig.active_client_thread_checkpoint << "\n";
-      tmp << "Number of clients: " << Core::networkManager.clients.size() << "\n";
-      for ( const auto& client : Core::networkManager.clients )
-        tmp << " " << client->ipaddrAsString() << " "
-            << ( client->acct == nullptr ? "prelogin " : client->acct->name() ) << " "
-            << client->checkpoint << "\n";
+      {
+        // the client list is only read, but a stuck thread may hold the lock for good
+        PolSharedLock lck( 1000 );
+        if ( !lck.locked() )
+          tmp << "Lock not available, the client list is read without it\n";
+        tmp << "Number of clients: " << Core::networkManager.clients.size() << "\n";
+        for ( const auto& client : Core::networkManager.clients )
+          tmp << " " << client->ipaddrAsString() << " "
+              << ( client->acct == nullptr ? "prelogin " : client->acct->name() ) << " "
+              << client->checkpoint << "\n";
+      }
       if ( stateManager.polsig.check_attack_after_move_function_checkpoint )
         tmp << "check_attack_after_move() Checkpoint: "
             << stateManager.polsig.check_attack_after_move_function_checkpoint << "\n";
@@ -710,6 +717,8 @@ void threadstatus_thread( void )
       }
       tmp << "Child threads (child_threads): " << threadhelp::child_threads << "\n";
       tmp << "Registered threads (ThreadMap): " << contents.size() << "\n";
+      if ( Plib::systemstate.config.profile_locks )
+        tmp << "Top lock holders:\n" << lock_report( 10 );
       stateManager.polsig.report_status_signalled = false;
       ERROR_PRINT << tmp.str();
     }
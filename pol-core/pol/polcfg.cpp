@@ -67,6 +67,8 @@ void PolConfig::read_pol_config( bool initial_load )
     Plib::systemstate.config.realm_data_path = elem.remove_string( "RealmDataPath", "realm/" );
     Plib::systemstate.config.realm_data_path =
         Clib::normalized_dir_form( Plib::systemstate.config.realm_data_path );
+    Plib::systemstate.config.map_server =
+        Clib::strlowerASCII( elem.remove_string( "MapServer", "" ) );
 
     Plib::systemstate.config.pidfile_path = elem.remove_string( "PidFilePath", "./" );
     Plib::systemstate.config.pidfile_path =
@@ -94,7 +96,11 @@ void PolConfig::read_pol_config( bool initial_load )
 
     Plib::systemstate.config.debug_port = elem.remove_ushort( "DebugPort", 0 );
 
+    Plib::systemstate.config.network_reactor_threads =
+        elem.remove_ushort( "NetworkReactorThreads", 0 );
+
     Plib::systemstate.config.account_save = elem.remove_int( "AccountDataSave", -1 );
+    Plib::systemstate.config.account_journal = elem.remove_bool( "AccountDataJournal", false );
     if ( Plib::systemstate.config.account_save > 0 )
     {
       gamestate.write_account_task->set_secs( Plib::systemstate.config.account_save );
@@ -111,6 +117,10 @@ void PolConfig::read_pol_config( bool initial_load )
   Plib::systemstate.config.watch_sysload = elem.remove_bool( "WatchSysLoad", false );
   Plib::systemstate.config.log_sysload = elem.remove_bool( "LogSysLoad", false );
   Plib::systemstate.config.inhibit_saves = elem.remove_bool( "InhibitSaves", false );
+  Plib::systemstate.config.binary_worldsave = elem.remove_bool( "BinaryWorldSave", false );
+  Plib::systemstate.config.snapshot_worldsave = elem.remove_bool( "SnapshotWorldSave", false );
+  Plib::systemstate.config.snapshot_worldsave_cache_size =
+      elem.remove_unsigned( "SnapshotWorldSaveCacheSize", 1024 );
   Plib::systemstate.config.log_script_cycles = elem.remove_bool( "LogScriptCycles", false );
   Plib::systemstate.config.web_server_local_only = elem.remove_bool( "WebServerLocalOnly", true );
   Plib::systemstate.config.web_server_debug = elem.remove_ushort( "WebServerDebug", 0 );
@@ -120,6 +130,7 @@ void PolConfig::read_pol_config( bool initial_load )
 
   Plib::systemstate.config.cache_interactive_scripts =
       elem.remove_bool( "CacheInteractiveScripts", true );
+  Plib::systemstate.config.gump_cache_size = elem.remove_unsigned( "GumpCacheSize", 1024 );
   Plib::systemstate.config.show_speech_colors = elem.remove_bool( "ShowSpeechColors", false );
   Plib::systemstate.config.require_spellbooks = elem.remove_bool( "RequireSpellbooks", true );
 
@@ -254,6 +265,7 @@ void PolConfig::read_pol_config( bool initial_load )
   Plib::systemstate.config.single_thread_decay = elem.remove_bool( "SingleThreadDecay", false );
   Plib::systemstate.config.thread_decay_statistics =
       elem.remove_bool( "ThreadDecayStatistics", false );
+  Plib::systemstate.config.profile_locks = elem.remove_bool( "ProfileLocks", false );
 
   Plib::systemstate.config.show_warning_gump = elem.remove_bool( "ShowWarningGump", true );
   Plib::systemstate.config.show_warning_item = elem.remove_bool( "ShowWarningItem", true );
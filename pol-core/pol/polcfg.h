@@ -27,6 +27,7 @@ struct PolConfig
   std::string uo_datafile_root;
   std::string world_data_path;
   std::string realm_data_path;
+  std::string map_server;  // overrides the mapserver type of every realm if not empty
   std::string pidfile_path;
   bool verbose;
   unsigned short loglevel;  // 0=nothing 10=lots
@@ -38,6 +39,9 @@ struct PolConfig
   bool watch_mapcache;
   bool check_integrity;
   bool inhibit_saves;
+  bool binary_worldsave;
+  bool snapshot_worldsave;
+  unsigned int snapshot_worldsave_cache_size;  // mbytes of saved text kept, 0 is unlimited
   bool log_script_cycles;
   bool count_resource_tiles;
   Crypt::TCryptInfo client_encryption_version;
@@ -49,6 +53,7 @@ struct PolConfig
   std::string web_server_password;
   bool profile_cprops;
   bool cache_interactive_scripts;
+  unsigned int gump_cache_size;  // kbytes of compressed gumps kept, 0 disables the cache
   bool show_speech_colors;
   bool require_spellbooks;
   bool enable_secure_trading;
@@ -88,13 +93,16 @@ struct PolConfig
   std::string minidump_type;
 
   int account_save;
+  bool account_journal;
   bool use_single_thread_login;
+  unsigned short network_reactor_threads;  // 0: one i/o thread per client
 
   bool disable_nagle;
   bool show_realm_info;
   bool enforce_mount_objtype;
   bool single_thread_decay;
   bool thread_decay_statistics;
+  bool profile_locks;
 
   bool show_warning_gump;
   bool show_warning_item;
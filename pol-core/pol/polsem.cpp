@@ -6,12 +6,21 @@
 
 #include "polsem.h"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
 #include <time.h>
+#include <utility>
+#include <vector>
+
+#include <format/format.h>
 
 #include "../clib/logfacility.h"
 #include "../clib/passert.h"
+#include "../clib/rawtypes.h"
 #include "../clib/threadhelp.h"
 #include "../clib/tracebuf.h"
+#include "../plib/systemstate.h"
 
 #ifdef _WIN32
 #include <process.h>
@@ -25,11 +34,12 @@ namespace Pol
 namespace Core
 {
 size_t locker;
+std::atomic<unsigned> shared_lockers( 0 );
 #ifdef _WIN32
 void polsem_lock()
 {
   size_t tid = threadhelp::thread_pid();
-  EnterCriticalSection( &cs );
+  AcquireSRWLockExclusive( &polsem );
   passert_always( locker == 0 );
   locker = tid;
 }
@@ -39,16 +49,36 @@ void polsem_unlock()
   size_t tid = GetCurrentThreadId();
   passert_always( locker == tid );
   locker = 0;
-  LeaveCriticalSection( &cs );
+  ReleaseSRWLockExclusive( &polsem );
+}
+
+void polsem_lock_shared()
+{
+  AcquireSRWLockShared( &polsem );
+  ++shared_lockers;
+}
+
+static bool try_lock_shared()
+{
+  if ( !TryAcquireSRWLockShared( &polsem ) )
+    return false;
+  ++shared_lockers;
+  return true;
+}
+
+void polsem_unlock_shared()
+{
+  --shared_lockers;
+  ReleaseSRWLockShared( &polsem );
 }
 #else
 void polsem_lock()
 {
   size_t tid = threadhelp::thread_pid();
-  int res = pthread_mutex_lock( &polsem );
+  int res = pthread_rwlock_wrlock( &polsem );
   if ( res != 0 || locker != 0 )
   {
-    POLLOG.Format( "pthread_mutex_lock: res={}, tid={}, locker={}\n" ) << res << tid << locker;
+    POLLOG.Format( "pthread_rwlock_wrlock: res={}, tid={}, locker={}\n" ) << res << tid << locker;
   }
   passert_always( res == 0 );
   passert_always( locker == 0 );
@@ -59,19 +89,180 @@ void polsem_unlock()
   size_t tid = threadhelp::thread_pid();
   passert_always( locker == tid );
   locker = 0;
-  int res = pthread_mutex_unlock( &polsem );
+  int res = pthread_rwlock_unlock( &polsem );
+  if ( res != 0 )
+  {
+    POLLOG.Format( "pthread_rwlock_unlock: res={},tid={}" ) << res << tid;
+  }
+  passert_always( res == 0 );
+}
+
+void polsem_lock_shared()
+{
+  int res = pthread_rwlock_rdlock( &polsem );
   if ( res != 0 )
   {
-    POLLOG.Format( "pthread_mutex_unlock: res={},tid={}" ) << res << tid;
+    POLLOG.Format( "pthread_rwlock_rdlock: res={}, tid={}\n" ) << res
+                                                               << threadhelp::thread_pid();
   }
   passert_always( res == 0 );
+  ++shared_lockers;
+}
+static bool try_lock_shared()
+{
+  if ( pthread_rwlock_tryrdlock( &polsem ) != 0 )
+    return false;
+  ++shared_lockers;
+  return true;
+}
+void polsem_unlock_shared()
+{
+  --shared_lockers;
+  int res = pthread_rwlock_unlock( &polsem );
+  passert_always( res == 0 );
 }
 
 #endif
 
+bool polsem_try_lock_shared( unsigned int millis )
+{
+  auto give_up_at = std::chrono::steady_clock::now() + std::chrono::milliseconds( millis );
+  while ( !try_lock_shared() )
+  {
+    if ( std::chrono::steady_clock::now() >= give_up_at )
+      return false;
+    threadhelp::thread_sleep_ms( 10 );
+  }
+  return true;
+}
+
+namespace
+{
+struct LockSiteStats
+{
+  LockSiteStats() : shared( false ), count( 0 ), wait_us( 0 ), hold_us( 0 ), max_hold_us( 0 )
+  {
+  }
+  void add( const LockSiteStats& other )
+  {
+    shared = other.shared;
+    count += other.count;
+    wait_us += other.wait_us;
+    hold_us += other.hold_us;
+    max_hold_us = std::max( max_hold_us, other.max_hold_us );
+  }
+  bool shared;
+  u64 count;
+  u64 wait_us;
+  u64 hold_us;
+  u64 max_hold_us;
+};
+typedef std::pair<const char*, int> LockSite;
+typedef std::map<LockSite, LockSiteStats> LockSites;
+
+struct ThreadLockStats;
+// the totals of every thread, the threads which already ended are merged into retired
+std::mutex lockstats_mutex;
+std::vector<ThreadLockStats*> lockstats_threads;
+LockSites lockstats_retired;
+
+// The totals of one thread. Only lock_report() competes for the mutex, recording a release
+// never waits for another thread.
+struct ThreadLockStats
+{
+  ThreadLockStats() : mutex(), sites(), registered( false ) {}
+  ~ThreadLockStats()
+  {
+    if ( !registered )
+      return;
+    std::lock_guard<std::mutex> guard( lockstats_mutex );
+    for ( const auto& site : sites )
+      lockstats_retired[site.first].add( site.second );
+    lockstats_threads.erase(
+        std::find( lockstats_threads.begin(), lockstats_threads.end(), this ) );
+  }
+
+  std::mutex mutex;
+  LockSites sites;
+  bool registered;
+};
+thread_local ThreadLockStats thread_lockstats;
+
+u64 elapsed_us( std::chrono::steady_clock::time_point from,
+                std::chrono::steady_clock::time_point to )
+{
+  return static_cast<u64>(
+      std::chrono::duration_cast<std::chrono::microseconds>( to - from ).count() );
+}
+}  // namespace
+
+void LockTiming::waiting()
+{
+  enabled_ = Plib::systemstate.config.profile_locks;
+  if ( enabled_ )
+    wait_start_ = std::chrono::steady_clock::now();
+}
+
+void LockTiming::add_to_totals()
+{
+  LockSiteStats stats;
+  stats.shared = shared_;
+  stats.count = 1;
+  stats.wait_us = elapsed_us( wait_start_, acquired_ );
+  stats.hold_us = elapsed_us( acquired_, released_ );
+  stats.max_hold_us = stats.hold_us;
+
+  ThreadLockStats& local = thread_lockstats;
+  if ( !local.registered )
+  {
+    std::lock_guard<std::mutex> guard( lockstats_mutex );
+    lockstats_threads.push_back( &local );
+    local.registered = true;
+  }
+  std::lock_guard<std::mutex> guard( local.mutex );
+  local.sites[LockSite( file_, line_ )].add( stats );
+}
+
+std::string lock_report( size_t max_sites )
+{
+  LockSites totals;
+  {
+    std::lock_guard<std::mutex> guard( lockstats_mutex );
+    totals = lockstats_retired;
+    for ( ThreadLockStats* thread : lockstats_threads )
+    {
+      std::lock_guard<std::mutex> thread_guard( thread->mutex );
+      for ( const auto& site : thread->sites )
+        totals[site.first].add( site.second );
+    }
+  }
+  std::vector<std::pair<LockSite, LockSiteStats>> sites( totals.begin(), totals.end() );
+  std::sort( sites.begin(), sites.end(), []( const std::pair<LockSite, LockSiteStats>& a,
+                                             const std::pair<LockSite, LockSiteStats>& b ) {
+    return a.second.hold_us > b.second.hold_us;
+  } );
+  if ( sites.size() > max_sites )
+    sites.resize( max_sites );
+
+  fmt::Writer tmp;
+  for ( const auto& site : sites )
+  {
+    std::string file = site.first.first != nullptr ? site.first.first : "unknown";
+    std::string::size_type pos = file.find_last_of( "/\\" );
+    if ( pos != std::string::npos )
+      file.erase( 0, pos + 1 );
+    const LockSiteStats& stats = site.second;
+    tmp << " " << file << ":" << site.first.second << ( stats.shared ? " shared" : "" )
+        << " count=" << stats.count << " wait=" << stats.wait_us / 1000
+        << "ms hold=" << stats.hold_us / 1000 << "ms max hold=" << stats.max_hold_us / 1000
+        << "ms\n";
+  }
+  return tmp.str();
+}
+
 
 #ifdef _WIN32
-CRITICAL_SECTION cs;
+SRWLOCK polsem;
 HANDLE hEvPulse;
 
 HANDLE hEvTasksThread;
@@ -81,7 +272,7 @@ HANDLE hSemThread;
 
 void init_ipc_vars()
 {
-  InitializeCriticalSection( &cs );
+  InitializeSRWLock( &polsem );
   hEvPulse = CreateEvent( nullptr, TRUE, FALSE, nullptr );
 
   hEvTasksThread = CreateEvent( nullptr, FALSE, FALSE, nullptr );
@@ -99,7 +290,6 @@ void deinit_ipc_vars()
   hEvTasksThread = nullptr;
 
   CloseHandle( hEvPulse );
-  DeleteCriticalSection( &cs );
 }
 void send_pulse()
 {
@@ -123,10 +313,8 @@ void tasks_thread_sleep( unsigned int millis )
 }
 #else
 
-pthread_mutexattr_t polsem_attr;
-pthread_mutex_t polsem;
-// pthread_mutex_t polsem = PTHREAD_MUTEX_INITIALIZER;
-// pthread_mutex_t polsem = PTHREAD_ERRORCHECK_MUTEX_INITIALIZER_NP;
+pthread_rwlockattr_t polsem_attr;
+pthread_rwlock_t polsem;
 
 pthread_mutex_t pulse_mut = PTHREAD_MUTEX_INITIALIZER;
 pthread_cond_t pulse_cond = PTHREAD_COND_INITIALIZER;
@@ -147,18 +335,17 @@ pthread_attr_t thread_attr;
 void init_ipc_vars()
 {
   int res;
-  res = pthread_mutexattr_init( &polsem_attr );
+  res = pthread_rwlockattr_init( &polsem_attr );
   passert_always( res == 0 );
 
-  /*
-      res = pthread_mutexattr_setkind_np( &polsem_attr, PTHREAD_MUTEX_ERRORCHECK_NP );
-      passert_always( res == 0 );
-
-      res = pthread_mutexattr_settype( &polsem_attr, PTHREAD_MUTEX_ERRORCHECK );
-      passert_always( res == 0 );
-      */
+#ifdef __GLIBC__
+  // the default lets a steady stream of shared holders starve the exclusive ones
+  res = pthread_rwlockattr_setkind_np( &polsem_attr,
+                                       PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP );
+  passert_always( res == 0 );
+#endif
 
-  res = pthread_mutex_init( &polsem, &polsem_attr );
+  res = pthread_rwlock_init( &polsem, &polsem_attr );
   passert_always( res == 0 );
 
   pthread_attr_init( &thread_attr );
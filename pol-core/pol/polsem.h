@@ -16,6 +16,8 @@
 #include <unistd.h>
 #endif
 #include <atomic>
+#include <chrono>
+#include <string>
 
 namespace Pol
 {
@@ -32,44 +34,174 @@ void tasks_thread_sleep( unsigned int millis );
 
 extern size_t locker;
 #ifdef _WIN32
-extern CRITICAL_SECTION cs;
+extern SRWLOCK polsem;
 #else
-extern pthread_mutex_t polsem;
+extern pthread_rwlock_t polsem;
 #endif  // not _WIN32
+// number of threads holding the lock shared
+extern std::atomic<unsigned> shared_lockers;
 
+// exclusive access to the world
 void polsem_lock();
 void polsem_unlock();
+// shared access, concurrent with other shared holders. Only for code which never modifies
+// anything guarded by the lock, not even through scripts or ref counts.
+void polsem_lock_shared();
+// gives up after millis, returns if the lock is held
+bool polsem_try_lock_shared( unsigned int millis );
+void polsem_unlock_shared();
+
+// the call site of a PolLock is taken from the default arguments where the compiler supports it
+#if defined( __GNUC__ ) || ( defined( _MSC_VER ) && _MSC_VER >= 1926 )
+#define POLLOCK_FILE __builtin_FILE()
+#define POLLOCK_LINE __builtin_LINE()
+#else
+#define POLLOCK_FILE nullptr
+#define POLLOCK_LINE 0
+#endif
+
+/**
+ * Measures how long a call site waited for the lock and how long it held it, only if
+ * pol.cfg ProfileLocks is set. The times are taken around the lock, but added to the totals
+ * of the calling thread only after the lock got released. lock_report() sums up all threads.
+ */
+class LockTiming
+{
+public:
+  LockTiming( const char* file, int line, bool shared )
+      : file_( file ),
+        line_( line ),
+        shared_( shared ),
+        enabled_( false ),
+        wait_start_(),
+        acquired_(),
+        released_()
+  {
+  }
+
+  void waiting();
+  void acquired()
+  {
+    if ( enabled_ )
+      acquired_ = std::chrono::steady_clock::now();
+  }
+  void released()
+  {
+    if ( enabled_ )
+      released_ = std::chrono::steady_clock::now();
+  }
+  // call after the lock is released
+  void record()
+  {
+    if ( enabled_ )
+      add_to_totals();
+  }
+
+private:
+  void add_to_totals();
+
+  const char* file_;
+  int line_;
+  bool shared_;
+  bool enabled_;
+  std::chrono::steady_clock::time_point wait_start_;
+  std::chrono::steady_clock::time_point acquired_;
+  std::chrono::steady_clock::time_point released_;
+};
+
+// the call sites with the longest total hold time, one per line
+std::string lock_report( size_t max_sites );
 
 class PolLock
 {
 public:
-  PolLock() { polsem_lock(); }
-  ~PolLock() { polsem_unlock(); }
+  explicit PolLock( const char* file = POLLOCK_FILE, int line = POLLOCK_LINE )
+      : timing_( file, line, false )
+  {
+    timing_.waiting();
+    polsem_lock();
+    timing_.acquired();
+  }
+  ~PolLock()
+  {
+    timing_.released();
+    polsem_unlock();
+    timing_.record();
+  }
+
+private:
+  LockTiming timing_;
 };
 
 class PolLock2
 {
 public:
-  PolLock2() : locked_( true ) { polsem_lock(); }
+  explicit PolLock2( const char* file = POLLOCK_FILE, int line = POLLOCK_LINE )
+      : timing_( file, line, false ), locked_( true )
+  {
+    timing_.waiting();
+    polsem_lock();
+    timing_.acquired();
+  }
   ~PolLock2()
   {
     if ( locked_ )
-      polsem_unlock();
+      unlock();
     locked_ = false;
   }
 
   void unlock()
   {
+    timing_.released();
     polsem_unlock();
     locked_ = false;
+    timing_.record();
   }
   void lock()
   {
+    timing_.waiting();
     polsem_lock();
+    timing_.acquired();
     locked_ = true;
   }
 
 private:
+  LockTiming timing_;
+  bool locked_;
+};
+
+class PolSharedLock
+{
+public:
+  explicit PolSharedLock( const char* file = POLLOCK_FILE, int line = POLLOCK_LINE )
+      : timing_( file, line, true ), locked_( true )
+  {
+    timing_.waiting();
+    polsem_lock_shared();
+    timing_.acquired();
+  }
+  // waits at most timeout_ms for the lock, check locked()
+  explicit PolSharedLock( unsigned int timeout_ms, const char* file = POLLOCK_FILE,
+                          int line = POLLOCK_LINE )
+      : timing_( file, line, true ), locked_( false )
+  {
+    timing_.waiting();
+    locked_ = polsem_try_lock_shared( timeout_ms );
+    timing_.acquired();
+  }
+  ~PolSharedLock()
+  {
+    if ( !locked_ )
+      return;
+    timing_.released();
+    polsem_unlock_shared();
+    timing_.record();
+  }
+
+  bool locked() const { return locked_; }
+
+private:
+  LockTiming timing_;
   bool locked_;
 };
 }
@@ -8,6 +8,7 @@
 #include "proplist.h"
 
 #include <stddef.h>
+#include <unordered_set>
 
 #include "../bscript/berror.h"
 #include "../bscript/bobject.h"
@@ -74,7 +75,10 @@ CPropProfiler& CPropProfiler::instance()
   return instance;
 }
 
-CPropProfiler::CPropProfiler() : _proplists( new PropLists() ), _hits( new Hits() ) {}
+CPropProfiler::CPropProfiler()
+    : _proplists( new PropLists() ), _hits( new Hits() ), _cacheHits( 0 ), _cacheMisses( 0 )
+{
+}
 
 /**
  * Returns proplist type, internal usage
@@ -139,6 +143,22 @@ void CPropProfiler::cpropErase( const PropertyList* proplist, const std::string&
 {
   cpropAction( proplist, name, HitsCounter::ERASE );
 }
+/**
+ * Register a read served by the decoded value cache
+ */
+void CPropProfiler::cpropCacheHit()
+{
+  Clib::SpinLockGuard lock( _hitsLock );
+  ++_cacheHits;
+}
+/**
+ * Register a read which had to unpack a cached type
+ */
+void CPropProfiler::cpropCacheMiss()
+{
+  Clib::SpinLockGuard lock( _hitsLock );
+  ++_cacheMisses;
+}
 
 /**
  * Registers a property list address
@@ -204,6 +224,8 @@ void CPropProfiler::clear()
 
   _proplists->clear();
   _hits->clear();
+  _cacheHits = 0;
+  _cacheMisses = 0;
 }
 
 /**
@@ -217,9 +239,12 @@ void CPropProfiler::dumpProfile( std::ostream& os ) const
 
   // map<categoryname, map<typename, vector<lines> >>
   std::map<std::string, std::map<std::string, std::vector<std::string>>> outData;
+  u64 cacheHits, cacheMisses;
 
   {
     Clib::SpinLockGuard lock( _hitsLock );
+    cacheHits = _cacheHits;
+    cacheMisses = _cacheMisses;
 
     for ( auto tIter = _hits->begin(); tIter != _hits->end(); ++tIter )
     {
@@ -276,6 +301,11 @@ void CPropProfiler::dumpProfile( std::ostream& os ) const
   }
 
   // Then output it
+  os << "Decode cache hits/misses: " << cacheHits << "/" << cacheMisses;
+  if ( cacheHits + cacheMisses )
+    os << " (" << cacheHits * 100 / ( cacheHits + cacheMisses ) << "% hits)";
+  os << std::endl << std::endl;
+
   for ( auto it1 = outData.rbegin(); it1 != outData.rend(); ++it1 )
   {
     // 1st level header
@@ -328,11 +358,28 @@ size_t CPropProfiler::estimateSize() const
   return ret;
 }
 
+struct PropertyList::DecodedProps
+{
+  // a name without value was read once, the value is kept from the second read on
+  std::map<boost_utils::cprop_name_flystring, std::unique_ptr<Bscript::BObjectImp>> values;
+};
+
+namespace
+{
+// property lists with decoded values, never destroyed since global lists may outlive it
+Clib::SpinLock decoded_lists_lock;
+std::unordered_set<const PropertyList*>& decoded_lists()
+{
+  static auto lists = new std::unordered_set<const PropertyList*>();
+  return *lists;
+}
+}  // namespace
+
 /**
  * Initialize and register this property list based on a given type
  * register only if the profile_cprops flag is set
  */
-PropertyList::PropertyList( CPropProfiler::Type type ) : properties()
+PropertyList::PropertyList( CPropProfiler::Type type ) : properties(), decoded_()
 {
   if ( Plib::systemstate.config.profile_cprops )
     CPropProfiler::instance().registerProplist( this, type );
@@ -342,7 +389,7 @@ PropertyList::PropertyList( CPropProfiler::Type type ) : properties()
  * Initialize and register this property list based on a given type,
  * always register if force flag is is true
  */
-PropertyList::PropertyList( CPropProfiler::Type type, bool force ) : properties()
+PropertyList::PropertyList( CPropProfiler::Type type, bool force ) : properties(), decoded_()
 {
   if ( force || Plib::systemstate.config.profile_cprops )
     CPropProfiler::instance().registerProplist( this, type );
@@ -351,7 +398,7 @@ PropertyList::PropertyList( CPropProfiler::Type type, bool force ) : properties(
 /**
  * Initialize by copying content and type from a given one
  */
-PropertyList::PropertyList( const PropertyList& props ) : properties()
+PropertyList::PropertyList( const PropertyList& props ) : properties(), decoded_()
 {
   copyprops( props );
 
@@ -359,12 +406,28 @@ PropertyList::PropertyList( const PropertyList& props ) : properties()
     CPropProfiler::instance().registerProplist( this, &props );
 }
 
+PropertyList::~PropertyList()
+{
+  forget_all_decoded_of_this();
+}
+
 size_t PropertyList::estimatedSize() const
 {
   size_t size = sizeof( PropertyList );
   size += properties.size() *
           ( sizeof( boost_utils::cprop_name_flystring ) +
             sizeof( boost_utils::cprop_value_flystring ) + ( sizeof( void* ) * 3 + 1 ) / 2 );
+  if ( decoded_ )
+  {
+    size += sizeof( DecodedProps );
+    for ( const auto& value : decoded_->values )
+    {
+      size += sizeof( boost_utils::cprop_name_flystring ) + sizeof( value.second ) +
+              ( sizeof( void* ) * 3 + 1 ) / 2;
+      if ( value.second )
+        size += value.second->sizeEstimate();
+    }
+  }
   return size;
 }
 
@@ -384,12 +447,60 @@ bool PropertyList::getprop( const std::string& propname, std::string& propval )
     return true;
   }
 }
+Bscript::BObjectImp* PropertyList::getpropimp( const std::string& propname ) const
+{
+  if ( Plib::systemstate.config.profile_cprops )
+    CPropProfiler::instance().cpropRead( this, propname );
+
+  boost_utils::cprop_name_flystring name( propname );
+  Properties::const_iterator itr = properties.find( name );
+  if ( itr == properties.end() )
+    return nullptr;
+
+  const std::string& packed = itr->second;
+  // scalars are cheaper to unpack than to copy out of a cache
+  if ( packed.empty() || ( packed[0] != 'a' && packed[0] != 't' && packed[0] != 'd' ) )
+    return Bscript::BObjectImp::unpack( packed.c_str() );
+
+  if ( !decoded_ )
+  {
+    decoded_.reset( new DecodedProps );
+    Clib::SpinLockGuard lock( decoded_lists_lock );
+    decoded_lists().insert( this );
+  }
+  auto cached = decoded_->values.find( name );
+  if ( cached != decoded_->values.end() && cached->second )
+  {
+    if ( Plib::systemstate.config.profile_cprops )
+      CPropProfiler::instance().cpropCacheHit();
+    return cached->second->copy();
+  }
+
+  if ( Plib::systemstate.config.profile_cprops )
+    CPropProfiler::instance().cpropCacheMiss();
+  Bscript::BObjectImp* imp = Bscript::BObjectImp::unpack( packed.c_str() );
+  // props read only once would just cost memory
+  if ( cached == decoded_->values.end() )
+    decoded_->values.emplace( name, nullptr );
+  else
+    cached->second.reset( imp->copy() );
+  return imp;
+}
+
+void PropertyList::forget_decoded( const boost_utils::cprop_name_flystring& propname )
+{
+  if ( decoded_ )
+    decoded_->values.erase( propname );
+}
+
 void PropertyList::setprop( const std::string& propname, const std::string& propvalue )
 {
   if ( Plib::systemstate.config.profile_cprops )
     CPropProfiler::instance().cpropWrite( this, propname );
 
-  properties[boost_utils::cprop_name_flystring( propname )] = propvalue;
+  boost_utils::cprop_name_flystring name( propname );
+  forget_decoded( name );
+  properties[name] = propvalue;
 }
 
 void PropertyList::eraseprop( const std::string& propname )
@@ -397,7 +508,9 @@ void PropertyList::eraseprop( const std::string& propname )
   if ( Plib::systemstate.config.profile_cprops )
     CPropProfiler::instance().cpropErase( this, propname );
 
-  properties.erase( boost_utils::cprop_name_flystring( propname ) );
+  boost_utils::cprop_name_flystring name( propname );
+  forget_decoded( name );
+  properties.erase( name );
 }
 
 void PropertyList::copyprops( const PropertyList& from )
@@ -407,7 +520,10 @@ void PropertyList::copyprops( const PropertyList& from )
   if ( !properties.empty() )
   {
     for ( const auto& prop : from.properties )
+    {
+      forget_decoded( prop.first );
       properties.erase( prop.first );
+    }
   }
 
   properties.insert( from.properties.begin(), from.properties.end() );
@@ -416,6 +532,29 @@ void PropertyList::copyprops( const PropertyList& from )
 void PropertyList::clear()
 {
   properties.clear();
+  forget_all_decoded_of_this();
+}
+
+void PropertyList::forget_all_decoded_of_this() const
+{
+  if ( !decoded_ )
+    return;
+  {
+    Clib::SpinLockGuard lock( decoded_lists_lock );
+    decoded_lists().erase( this );
+  }
+  decoded_.reset();
+}
+
+void PropertyList::forget_all_decoded()
+{
+  std::unordered_set<const PropertyList*> lists;
+  {
+    Clib::SpinLockGuard lock( decoded_lists_lock );
+    lists.swap( decoded_lists() );
+  }
+  for ( const auto& proplist : lists )
+    proplist->decoded_.reset();
 }
 
 void PropertyList::getpropnames( std::vector<std::string>& propnames ) const
@@ -530,11 +669,11 @@ Bscript::BObjectImp* CallPropertyListMethod_id( PropertyList& proplist, const in
     const String* propname_str;
     if ( !ex.getStringParam( 0, propname_str ) )
       return new BError( "Invalid parameter type" );
-    std::string val;
-    if ( !proplist.getprop( propname_str->value(), val ) )
+    Bscript::BObjectImp* val = proplist.getpropimp( propname_str->value() );
+    if ( val == nullptr )
       return new BError( "Property not found" );
 
-    return Bscript::BObjectImp::unpack( val.c_str() );
+    return val;
   }
 
   case MTH_SETPROP:
@@ -13,6 +13,7 @@
 #include <boost/flyweight.hpp>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -116,6 +117,9 @@ private:
 
   std::unique_ptr<PropLists> _proplists;
   std::unique_ptr<Hits> _hits;
+  /// reads served by the decoded value cache of PropertyList::getpropimp, guarded by _hitsLock
+  u64 _cacheHits;
+  u64 _cacheMisses;
   mutable Clib::SpinLock _proplistsLock;
   mutable Clib::SpinLock _hitsLock;
 
@@ -123,6 +127,8 @@ public:
   void cpropRead( const PropertyList* proplist, const std::string& name );
   void cpropWrite( const PropertyList* proplist, const std::string& name );
   void cpropErase( const PropertyList* proplist, const std::string& name );
+  void cpropCacheHit();
+  void cpropCacheMiss();
 };
 
 
@@ -136,13 +142,18 @@ public:
   PropertyList( CPropProfiler::Type type );
   PropertyList( CPropProfiler::Type type, bool force );
   PropertyList( const PropertyList& );  // dave added 1/26/3
+  ~PropertyList();
   bool getprop( const std::string& propname, std::string& propvalue ) const;
+  // unpacked value or nullptr if not found, the caller owns the returned object
+  Bscript::BObjectImp* getpropimp( const std::string& propname ) const;
   void setprop( const std::string& propname, const std::string& propvalue );
   void eraseprop( const std::string& propname );
   void copyprops( const PropertyList& proplist );
   void getpropnames( std::vector<std::string>& propnames ) const;
   void clear();
   size_t estimatedSize() const;
+  // drops the decoded values of all property lists, called by every worldsave
+  static void forget_all_decoded();
 
   void printProperties( Clib::StreamWriter& sw ) const;
   void printProperties( Clib::ConfigElem& elem ) const;
@@ -161,6 +172,16 @@ protected:
   Properties properties;
 
 private:
+  /**
+   * Unpacked copies of the container properties which got read more than once since the last
+   * worldsave, arrays, structs and dictionaries are expensive to unpack and scripts tend to read
+   * them over and over. Readers get a copy, so scripts never modify the cached value.
+   */
+  struct DecodedProps;
+  mutable std::unique_ptr<DecodedProps> decoded_;
+  void forget_decoded( const boost_utils::cprop_name_flystring& propname );
+  void forget_all_decoded_of_this() const;
+
   // not implemented
   PropertyList& operator=( const PropertyList& ) = delete;
 };
@@ -89,6 +89,7 @@ size_t Realm::sizeEstimate() const
       size += 3 * sizeof( void** ) + zone[x][y].characters.capacity() * sizeof( void* );
       size += 3 * sizeof( void** ) + zone[x][y].npcs.capacity() * sizeof( void* );
       size += 3 * sizeof( void** ) + zone[x][y].items.capacity() * sizeof( void* );
+      size += zone[x][y].item_blocks.estimatedSize();
       size += 3 * sizeof( void** ) + zone[x][y].multis.capacity() * sizeof( void* );
     }
   }
@@ -99,6 +100,7 @@ size_t Realm::sizeEstimate() const
   size += _descriptor.sizeEstimate() + ( ( !_mapserver ) ? 0 : _mapserver->sizeEstimate() ) +
           ( ( !_staticserver ) ? 0 : _staticserver->sizeEstimate() ) +
           ( ( !_maptileserver ) ? 0 : _maptileserver->sizeEstimate() );
+  size += _walkcache.estimatedSize();
   return size;
 }
 
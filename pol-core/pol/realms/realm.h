@@ -20,7 +20,9 @@
 #include "../../plib/realmdescriptor.h"
 #include "../../plib/uconst.h"
 #include "../../plib/udatfile.h"
+#include "../decay.h"
 #include "WorldChangeReasons.h"
+#include "walkcache.h"
 
 
 namespace Pol
@@ -131,6 +133,7 @@ public:
   void readmultis( Plib::StaticList& vec, unsigned short x, unsigned short y ) const;
 
   Core::Zone** zone;
+  Core::DecayQueue decay_queue;  // items of the realm lying in the world by decay time
   std::set<unsigned int> global_hulls;  // xy-smashed together
   unsigned getUOMapID() const;
   unsigned getNumStaticPatches() const;
@@ -155,6 +158,10 @@ protected:
 
   static bool dropheight( Plib::MapShapeList& shapes, short dropz, short chrz, short* newz );
 
+  void static_standheight( Plib::MOVEMODE movemode, unsigned int flags, unsigned short x,
+                           unsigned short y, short oldz, bool* result, short* newz,
+                           short* gradual_boost );
+
   void readdynamics( Plib::MapShapeList& vec, unsigned short x, unsigned short y,
                      Core::ItemsVector& walkon_items, bool doors_block );
 
@@ -175,6 +182,7 @@ private:
   std::unique_ptr<Plib::MapServer> _mapserver;
   std::unique_ptr<Plib::StaticServer> _staticserver;
   std::unique_ptr<Plib::MapTileServer> _maptileserver;
+  WalkCache _walkcache;
 
 private:
   // not implemented:
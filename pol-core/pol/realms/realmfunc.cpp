@@ -194,6 +194,42 @@ void Realm::standheight( Plib::MOVEMODE movemode, Plib::MapShapeList& shapes, sh
   }
 }
 
+// standheight for a tile without dynamic items and multis
+void Realm::static_standheight( Plib::MOVEMODE movemode, unsigned int flags, unsigned short x,
+                                unsigned short y, short oldz, bool* result, short* newz,
+                                short* gradual_boost )
+{
+  short boost = ( gradual_boost != nullptr ) ? *gradual_boost : 0;
+  if ( boost < 5 )
+    boost = 5;  // standheight uses at least this boost
+  if ( boost > 0xFF )
+  {
+    static Plib::MapShapeList shapes;
+    shapes.clear();
+    getmapshapes( shapes, x, y, flags );
+    standheight( movemode, shapes, oldz, result, newz, gradual_boost );
+    return;
+  }
+
+  // shadowrealms share the map and statics of their base
+  WalkCache& cache = is_shadowrealm ? baserealm->_walkcache : _walkcache;
+  WalkCache::Entry& entry = cache.at( x, y, oldz, static_cast<u8>( movemode ), u8( boost ) );
+  if ( entry.state == WalkCache::EMPTY )
+  {
+    static Plib::MapShapeList shapes;
+    shapes.clear();
+    getmapshapes( shapes, x, y, flags );
+    short new_boost = boost;
+    standheight( movemode, shapes, oldz, result, newz, &new_boost );
+    entry.state = *result ? WalkCache::WALKABLE : WalkCache::BLOCKED;
+    entry.newz = *newz;
+    entry.new_boost = u8( new_boost );
+  }
+  *result = entry.state == WalkCache::WALKABLE;
+  *newz = entry.newz;
+  if ( *result && gradual_boost != nullptr )
+    *gradual_boost = entry.new_boost;
+}
 
 void Realm::lowest_standheight( Plib::MOVEMODE movemode, Plib::MapShapeList& shapes, short minz,
                                 bool* result_out, short* newz_out, short* gradual_boost )
@@ -311,8 +347,10 @@ void Realm::lowest_standheight( Plib::MOVEMODE movemode, Plib::MapShapeList& sha
 void Realm::readdynamics( Plib::MapShapeList& vec, unsigned short x, unsigned short y,
                           Core::ItemsVector& walkon_items, bool doors_block )
 {
-  Core::ZoneItems& witems = Core::getzone( x, y, this ).items;
-  for ( const auto& item : witems )
+  const Core::ZoneItems* witems = Core::getzone( x, y, this ).item_blocks.at( x, y );
+  if ( witems == nullptr )
+    return;
+  for ( const auto& item : *witems )
   {
     if ( ( item->x == x ) && ( item->y == y ) )
     {
@@ -359,10 +397,15 @@ bool Realm::walkheight( unsigned short x, unsigned short y, short oldz, short* n
   if ( movemode & Plib::MOVEMODE_FLY )
     flags |= Plib::FLAG::OVERFLIGHT;
   readmultis( shapes, x, y, flags, mvec );
-  getmapshapes( shapes, x, y, flags );
 
   bool result;
-  standheight( movemode, shapes, oldz, &result, newz, gradual_boost );
+  if ( shapes.empty() && mvec.empty() )
+    static_standheight( movemode, flags, x, y, oldz, &result, newz, gradual_boost );
+  else
+  {
+    getmapshapes( shapes, x, y, flags );
+    standheight( movemode, shapes, oldz, &result, newz, gradual_boost );
+  }
 
   if ( result && ( pwalkon != nullptr ) )
   {
@@ -412,10 +455,15 @@ bool Realm::walkheight( const Mobile::Character* chr, unsigned short x, unsigned
   if ( chr->movemode & Plib::MOVEMODE_FLY )
     flags |= Plib::FLAG::OVERFLIGHT;
   readmultis( shapes, x, y, flags, mvec );
-  getmapshapes( shapes, x, y, flags );
 
   bool result;
-  standheight( chr->movemode, shapes, oldz, &result, newz, gradual_boost );
+  if ( shapes.empty() && mvec.empty() )
+    static_standheight( chr->movemode, flags, x, y, oldz, &result, newz, gradual_boost );
+  else
+  {
+    getmapshapes( shapes, x, y, flags );
+    standheight( chr->movemode, shapes, oldz, &result, newz, gradual_boost );
+  }
 
   if ( result && ( pwalkon != nullptr ) )
   {
@@ -0,0 +1,74 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#ifndef POL_WALKCACHE_H
+#define POL_WALKCACHE_H
+
+#include <memory>
+#include <stddef.h>
+
+#include "../../clib/rawtypes.h"
+
+namespace Pol
+{
+namespace Realms
+{
+/**
+ * Remembers the standheight results of tiles with only map and statics on them.
+ * Neither changes while the server runs, so an entry never gets stale, dynamic items and
+ * multis are checked before and bypass the cache.
+ * Direct mapped, a colliding entry simply replaces the old one.
+ */
+class WalkCache
+{
+public:
+  enum State : u8
+  {
+    EMPTY,
+    BLOCKED,
+    WALKABLE
+  };
+  struct Entry
+  {
+    u64 key;
+    s16 newz;
+    u8 new_boost;
+    u8 state;
+  };
+
+  WalkCache() : _entries() {}
+
+  // entry for the given start conditions, state is EMPTY if it needs to be calculated
+  Entry& at( unsigned short x, unsigned short y, short oldz, u8 movemode, u8 boost )
+  {
+    if ( _entries == nullptr )
+      clear();
+    u64 key = ( u64( x ) << 48 ) | ( u64( y ) << 32 ) | ( u64( u16( oldz ) ) << 16 ) |
+              ( u64( movemode ) << 8 ) | boost;
+    Entry& entry = _entries[( key * 0x9E3779B97F4A7C15ull ) >> ( 64 - BITS )];
+    if ( entry.key != key )
+    {
+      entry.key = key;
+      entry.state = EMPTY;
+    }
+    return entry;
+  }
+
+  void clear()
+  {
+    _entries.reset( new Entry[size_t( 1 ) << BITS]() );
+  }
+
+  // size of the table, the object itself is part of the realm
+  size_t estimatedSize() const { return _entries != nullptr ? sizeof( Entry ) << BITS : 0; }
+
+private:
+  static const unsigned BITS = 16;
+  std::unique_ptr<Entry[]> _entries;
+};
+}  // namespace Realms
+}  // namespace Pol
+#endif
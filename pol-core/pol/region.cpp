@@ -7,6 +7,7 @@
 
 #include "region.h"
 
+#include <algorithm>
 #include <stddef.h>
 #include <string>
 #include <tuple>
@@ -16,6 +17,7 @@
 #include "../clib/cfgelem.h"
 #include "../clib/cfgfile.h"
 #include "../clib/fileutil.h"
+#include "../clib/passert.h"
 #include "../clib/stlutil.h"
 #include "../plib/poltype.h"
 #include "globals/uvars.h"
@@ -59,42 +61,264 @@ Bscript::BObjectImp* Region::get_region_string( const std::string& propname )
 }
 
 
-RegionGroupBase::RegionGroupBase( const char* name ) : name_( name )
+RegionRaster::RegionRaster( unsigned width, unsigned height )
+    : _width( width ),
+      _height( height ),
+      _blockheight( ( height + BLOCK_MASK ) >> BLOCK_SHIFT ),
+      _blocks( ( ( width + BLOCK_MASK ) >> BLOCK_SHIFT ) * _blockheight )
 {
-  // memset( &regionidx_, 0, sizeof regionidx_ );
-  for ( const auto& realm : gamestate.Realms )
-  {
-    unsigned int gridwidth = realm->width() / ZONE_SIZE;
-    unsigned int gridheight = realm->height() / ZONE_SIZE;
+}
 
-    RegionId** zone = new RegionId*[gridwidth];
+void RegionRaster::paint( unsigned zx1, unsigned zy1, unsigned zx2, unsigned zy2, RegionId id )
+{
+  fill( zx1, zy1, zx2, zy2, nullptr, id );
+}
 
-    for ( unsigned int i = 0; i < gridwidth; i++ )
+void RegionRaster::copy( const RegionRaster& other, unsigned zx1, unsigned zy1, unsigned zx2,
+                         unsigned zy2 )
+{
+  passert( other._width == _width && other._height == _height );
+  fill( zx1, zy1, zx2, zy2, &other, 0 );
+}
+
+// sets the rectangle to id or to the ids of source, blocks which end up uniform get collapsed
+void RegionRaster::fill( unsigned zx1, unsigned zy1, unsigned zx2, unsigned zy2,
+                         const RegionRaster* source, RegionId id )
+{
+  for ( unsigned bx = zx1 >> BLOCK_SHIFT; bx <= zx2 >> BLOCK_SHIFT; ++bx )
+  {
+    for ( unsigned by = zy1 >> BLOCK_SHIFT; by <= zy2 >> BLOCK_SHIFT; ++by )
     {
-      zone[i] = new RegionId[gridheight];
-      for ( unsigned int j = 0; j < gridheight; j++ )
+      const size_t index = bx * _blockheight + by;
+      Block& block = _blocks[index];
+      const unsigned x0 = bx << BLOCK_SHIFT;
+      const unsigned y0 = by << BLOCK_SHIFT;
+      const unsigned x1 = std::max( zx1, x0 );
+      const unsigned y1 = std::max( zy1, y0 );
+      const unsigned x2 = std::min( zx2, x0 + BLOCK_MASK );
+      const unsigned y2 = std::min( zy2, y0 + BLOCK_MASK );
+      const bool full = x1 == x0 && y1 == y0 && x2 == std::min( x0 + BLOCK_MASK, _width - 1 ) &&
+                        y2 == std::min( y0 + BLOCK_MASK, _height - 1 );
+      const Block* src = source != nullptr ? &source->_blocks[index] : nullptr;
+      if ( src == nullptr || src->ids == nullptr )
+      {
+        const RegionId newid = src != nullptr ? src->id : id;
+        if ( full )
+        {
+          block.ids.reset();
+          block.id = newid;
+          continue;
+        }
+        if ( block.ids == nullptr && block.id == newid )
+          continue;
+      }
+      if ( block.ids == nullptr )
       {
-        zone[i][j] = 0;
+        block.ids.reset( new RegionId[BLOCK_CELLS] );
+        std::fill( block.ids.get(), block.ids.get() + BLOCK_CELLS, block.id );
+      }
+      for ( unsigned zx = x1; zx <= x2; ++zx )
+      {
+        for ( unsigned zy = y1; zy <= y2; ++zy )
+        {
+          const unsigned c = cell( zx, zy );
+          if ( src == nullptr )
+            block.ids[c] = id;
+          else
+            block.ids[c] = src->ids != nullptr ? src->ids[c] : src->id;
+        }
+      }
+      if ( std::all_of( block.ids.get(), block.ids.get() + BLOCK_CELLS,
+                        [&]( RegionId rid ) { return rid == block.ids[0]; } ) )
+      {
+        block.id = block.ids[0];
+        block.ids.reset();
       }
     }
-    regionrealms.insert( std::make_pair( realm, zone ) );
   }
 }
-RegionGroupBase::~RegionGroupBase()
+
+void RegionRaster::assign( unsigned zx1, unsigned zy1, unsigned zx2, unsigned zy2,
+                           const std::function<RegionId( unsigned zx, unsigned zy )>& id_at )
+{
+  RegionId ids[BLOCK_CELLS];
+  for ( unsigned bx = zx1 >> BLOCK_SHIFT; bx <= zx2 >> BLOCK_SHIFT; ++bx )
+  {
+    for ( unsigned by = zy1 >> BLOCK_SHIFT; by <= zy2 >> BLOCK_SHIFT; ++by )
+    {
+      Block& block = _blocks[bx * _blockheight + by];
+      const unsigned x0 = bx << BLOCK_SHIFT;
+      const unsigned y0 = by << BLOCK_SHIFT;
+      const unsigned x1 = std::max( zx1, x0 );
+      const unsigned y1 = std::max( zy1, y0 );
+      const unsigned x2 = std::min( zx2, x0 + BLOCK_MASK );
+      const unsigned y2 = std::min( zy2, y0 + BLOCK_MASK );
+      if ( block.ids != nullptr )
+        std::copy( block.ids.get(), block.ids.get() + BLOCK_CELLS, ids );
+      else
+        std::fill( ids, ids + BLOCK_CELLS, block.id );
+      for ( unsigned zx = x1; zx <= x2; ++zx )
+      {
+        for ( unsigned zy = y1; zy <= y2; ++zy )
+          ids[cell( zx, zy )] = id_at( zx, zy );
+      }
+      // cells outside of the realm take the first id, so they don't prevent collapsing
+      const unsigned xend = std::min( x0 + BLOCK_MASK, _width - 1 );
+      const unsigned yend = std::min( y0 + BLOCK_MASK, _height - 1 );
+      const RegionId first = ids[0];
+      bool uniform = true;
+      for ( unsigned zx = x0; zx <= xend && uniform; ++zx )
+      {
+        for ( unsigned zy = y0; zy <= yend; ++zy )
+        {
+          if ( ids[cell( zx, zy )] != first )
+          {
+            uniform = false;
+            break;
+          }
+        }
+      }
+      if ( uniform )
+      {
+        block.ids.reset();
+        block.id = first;
+        continue;
+      }
+      if ( block.ids == nullptr )
+        block.ids.reset( new RegionId[BLOCK_CELLS] );
+      std::copy( ids, ids + BLOCK_CELLS, block.ids.get() );
+    }
+  }
+}
+
+size_t RegionRaster::estimateSize() const
+{
+  size_t size = sizeof( *this ) + _blocks.capacity() * sizeof( Block );
+  for ( const auto& block : _blocks )
+  {
+    if ( block.ids != nullptr )
+      size += BLOCK_CELLS * sizeof( RegionId );
+  }
+  return size;
+}
+
+
+RegionIndex::RegionIndex()
+    : groups_(), rasters_(), combinations_(), combination_ids_(), dirty_( false )
+{
+}
+
+void RegionIndex::add_group( RegionGroupBase* group )
+{
+  group->index_slot_ = groups_.size();
+  groups_.push_back( group );
+  dirty_ = true;
+}
+
+void RegionIndex::remove_group( RegionGroupBase* group )
+{
+  groups_.erase( std::find( groups_.begin(), groups_.end(), group ) );
+  for ( size_t slot = 0; slot < groups_.size(); ++slot )
+    groups_[slot]->index_slot_ = slot;
+  dirty_ = true;
+}
+
+void RegionIndex::painted( Realms::Realm* realm, unsigned zx1, unsigned zy1, unsigned zx2,
+                           unsigned zy2 )
 {
-  for ( auto& realm : regionrealms )
+  if ( dirty_ )
+    return;
+  auto itr = rasters_.find( realm );
+  if ( itr == rasters_.end() )
+    return;
+  // painting at runtime leaves unused combinations behind, start over before the ids run out
+  const size_t zones = static_cast<size_t>( zx2 - zx1 + 1 ) * ( zy2 - zy1 + 1 );
+  if ( combination_ids_.size() + zones > 0xFFFF )
   {
-    unsigned int gridwidth = realm.first->width() / ZONE_SIZE;
+    dirty_ = true;
+    return;
+  }
+  itr->second.assign( zx1, zy1, zx2, zy2, [this, realm]( unsigned zx, unsigned zy ) {
+    return combination( realm, zx, zy );
+  } );
+}
+
+RegionId RegionIndex::get( const RegionGroupBase* group, unsigned zx, unsigned zy,
+                           Realms::Realm* realm )
+{
+  if ( dirty_ )
+    rebuild();
+  auto itr = rasters_.find( realm->is_shadowrealm ? realm->baserealm : realm );
+  if ( itr == rasters_.end() )
+    return 0;
+  return combinations_[itr->second.get( zx, zy ) * groups_.size() + group->index_slot_];
+}
 
-    // Tokuno-Fix removed Turley, 2009/09/08 (for ZONE_SIZE 4 not needed)
-    /*if (gridwidth * ZONE_SIZE < itr->first->width())
-      gridwidth++;*/
+RegionId RegionIndex::combination( Realms::Realm* realm, unsigned zx, unsigned zy )
+{
+  Combination ids( groups_.size() );
+  for ( size_t slot = 0; slot < groups_.size(); ++slot )
+    ids[slot] = groups_[slot]->regionrealms.at( realm ).get( zx, zy );
+  auto itr = combination_ids_.find( ids );
+  if ( itr != combination_ids_.end() )
+    return itr->second;
+  passert_always( combination_ids_.size() < 0xFFFF );
+  RegionId id = static_cast<RegionId>( combination_ids_.size() );
+  combinations_.insert( combinations_.end(), ids.begin(), ids.end() );
+  combination_ids_.emplace( std::move( ids ), id );
+  return id;
+}
+
+void RegionIndex::rebuild()
+{
+  dirty_ = false;
+  rasters_.clear();
+  combinations_.clear();
+  combination_ids_.clear();
+  if ( groups_.empty() )
+    return;
+  for ( const auto& realmregion : groups_.front()->regionrealms )
+  {
+    Realms::Realm* realm = realmregion.first;
+    if ( realm->is_shadowrealm )
+      continue;
+    unsigned width = realm->width() / ZONE_SIZE;
+    unsigned height = realm->height() / ZONE_SIZE;
+    auto itr = rasters_.emplace( realm, RegionRaster( width, height ) ).first;
+    itr->second.assign( 0, 0, width - 1, height - 1, [this, realm]( unsigned zx, unsigned zy ) {
+      return combination( realm, zx, zy );
+    } );
+  }
+}
 
-    for ( unsigned int i = 0; i < gridwidth; i++ )
-      delete[] realm.second[i];
-    delete[] realm.second;
+size_t RegionIndex::estimateSize() const
+{
+  size_t size = sizeof( *this ) + groups_.capacity() * sizeof( RegionGroupBase* ) +
+                combinations_.capacity() * sizeof( RegionId );
+  for ( const auto& realm : rasters_ )
+  {
+    size += realm.second.estimateSize() + sizeof( Realms::Realm* ) +
+            ( sizeof( void* ) * 3 + 1 ) / 2;
   }
+  size += combination_ids_.size() * ( sizeof( Combination ) + sizeof( RegionId ) +
+                                       groups_.size() * sizeof( RegionId ) +
+                                       ( sizeof( void* ) * 3 + 1 ) / 2 );
+  return size;
+}
+
 
+RegionGroupBase::RegionGroupBase( const char* name ) : name_( name ), index_slot_( 0 )
+{
+  for ( const auto& realm : gamestate.Realms )
+  {
+    regionrealms.emplace( realm, RegionRaster( realm->width() / ZONE_SIZE,
+                                               realm->height() / ZONE_SIZE ) );
+  }
+  gamestate.region_index.add_group( this );
+}
+RegionGroupBase::~RegionGroupBase()
+{
+  gamestate.region_index.remove_group( this );
   // cleans the regions_ vector...
   for ( auto& region : regions_ )
   {
@@ -124,20 +348,8 @@ void RegionGroupBase::paint_zones( Clib::ConfigElem& elem, RegionId ridx )
       unsigned zone_xwest, zone_ynorth, zone_xeast, zone_ysouth;
       std::tie( zone_xwest, zone_ynorth ) = XyToZone( xwest, ynorth );
       std::tie( zone_xeast, zone_ysouth ) = XyToZone( xeast, ysouth );
-      unsigned zx, zy;
-      for ( zx = zone_xwest; zx <= zone_xeast; ++zx )
-      {
-        for ( zy = zone_ynorth; zy <= zone_ysouth; ++zy )
-        {
-          /*
-          if (zones[zx][zy].regions[regiontype])
-          {
-          elem.throw_error( "Zone is already allocated" );
-          }
-          */
-          regionrealms[realm][zx][zy] = ridx;
-        }
-      }
+      regionrealms.at( realm ).paint( zone_xwest, zone_ynorth, zone_xeast, zone_ysouth, ridx );
+      gamestate.region_index.painted( realm, zone_xwest, zone_ynorth, zone_xeast, zone_ysouth );
     }
     else
     {
@@ -150,12 +362,7 @@ RegionId RegionGroupBase::getregionid( xcoord x, ycoord y, Realms::Realm* realm
 {
   unsigned zx, zy;
   std::tie( zx, zy ) = XyToZone( x, y );
-  RegionId** regiongrp;
-  if ( realm->is_shadowrealm )
-    regiongrp = regionrealms[realm->baserealm];
-  else
-    regiongrp = regionrealms[realm];
-  return regiongrp[zx][zy];
+  return gamestate.region_index.get( this, zx, zy, realm );
 }
 
 Region* RegionGroupBase::getregion_byname( const std::string& regionname )
@@ -207,12 +414,8 @@ size_t RegionGroupBase::estimateSize() const
   }
   for ( const auto& realm : regionrealms )
   {
-    if ( realm.first != nullptr )
-    {
-      unsigned int gridwidth = realm.first->width() / ZONE_SIZE;
-      size += gridwidth * sizeof( RegionId ) + sizeof( Realms::Realm* ) +
-              ( sizeof( void* ) * 3 + 1 ) / 2;
-    }
+    size += realm.second.estimateSize() + sizeof( Realms::Realm* ) +
+            ( sizeof( void* ) * 3 + 1 ) / 2;
   }
   size += name_.capacity();
   for ( const auto& realm : regions_byname_ )
@@ -7,8 +7,11 @@
 #ifndef REGION_H
 #define REGION_H
 
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "../plib/poltype.h"
 #include "proplist.h"
@@ -66,6 +69,90 @@ inline RegionId Region::regionid() const
   return regionid_;
 }
 
+/**
+ * Region ids of a realm in steps of ZONE_SIZE tiles.
+ * Stored in blocks of 16x16 zones, a block painted with a single region keeps only that id.
+ * Regions are rectangles, so most blocks stay uniform and a lookup reads one or two cache lines.
+ */
+class RegionRaster
+{
+public:
+  RegionRaster( unsigned width, unsigned height );
+
+  RegionId get( unsigned zx, unsigned zy ) const
+  {
+    const Block& block = _blocks[( zx >> BLOCK_SHIFT ) * _blockheight + ( zy >> BLOCK_SHIFT )];
+    if ( block.ids == nullptr )
+      return block.id;
+    return block.ids[cell( zx, zy )];
+  }
+  // inclusive zone rectangles
+  void paint( unsigned zx1, unsigned zy1, unsigned zx2, unsigned zy2, RegionId id );
+  void copy( const RegionRaster& other, unsigned zx1, unsigned zy1, unsigned zx2, unsigned zy2 );
+  void assign( unsigned zx1, unsigned zy1, unsigned zx2, unsigned zy2,
+               const std::function<RegionId( unsigned zx, unsigned zy )>& id_at );
+
+  size_t estimateSize() const;
+
+private:
+  static const unsigned BLOCK_SHIFT = 4;
+  static const unsigned BLOCK_MASK = ( 1 << BLOCK_SHIFT ) - 1;
+  static const unsigned BLOCK_CELLS = 1 << ( 2 * BLOCK_SHIFT );
+
+  struct Block
+  {
+    RegionId id = 0;
+    std::unique_ptr<RegionId[]> ids;  // nullptr if the whole block is id
+  };
+
+  static unsigned cell( unsigned zx, unsigned zy )
+  {
+    return ( ( zx & BLOCK_MASK ) << BLOCK_SHIFT ) | ( zy & BLOCK_MASK );
+  }
+  void fill( unsigned zx1, unsigned zy1, unsigned zx2, unsigned zy2,
+             const RegionRaster* source, RegionId id );
+
+  unsigned _width;
+  unsigned _height;
+  unsigned _blockheight;
+  std::vector<Block> _blocks;
+};
+
+/**
+ * The regions of all region groups in one raster per realm.
+ * A zone holds the id of the combination of region ids painted there, the ids of a combination
+ * are stored next to each other. The lookups of all groups for a position read the same raster
+ * block and the same combination.
+ * Painting updates the painted rectangle, adding or removing a group rebuilds all of it with
+ * the next lookup.
+ */
+class RegionIndex
+{
+public:
+  RegionIndex();
+  RegionIndex( const RegionIndex& ) = delete;
+  RegionIndex& operator=( const RegionIndex& ) = delete;
+
+  void add_group( RegionGroupBase* group );
+  void remove_group( RegionGroupBase* group );
+  // a group painted the inclusive zone rectangle
+  void painted( Realms::Realm* realm, unsigned zx1, unsigned zy1, unsigned zx2, unsigned zy2 );
+  RegionId get( const RegionGroupBase* group, unsigned zx, unsigned zy, Realms::Realm* realm );
+
+  size_t estimateSize() const;
+
+private:
+  typedef std::vector<RegionId> Combination;
+  RegionId combination( Realms::Realm* realm, unsigned zx, unsigned zy );
+  void rebuild();
+
+  std::vector<RegionGroupBase*> groups_;
+  std::map<Realms::Realm*, RegionRaster> rasters_;
+  std::vector<RegionId> combinations_;  // groups_.size() region ids per combination
+  std::map<Combination, RegionId> combination_ids_;
+  bool dirty_;
+};
+
 class RegionGroupBase
 {
 public:
@@ -84,10 +171,13 @@ protected:
 
   std::vector<Region*> regions_;
 
-  typedef std::map<Realms::Realm*, RegionId**> RegionRealms;
+  typedef std::map<Realms::Realm*, RegionRaster> RegionRealms;
+  // the painting of this group, lookups use the combined gamestate.region_index
   RegionRealms regionrealms;
 
 private:
+  friend class RegionIndex;
+
   virtual Region* create_region( Clib::ConfigElem& elem, RegionId id ) const = 0;
 
   RegionId getregionid( xcoord x, ycoord y, Realms::Realm* realm );
@@ -95,6 +185,7 @@ private:
   std::string name_;
   typedef std::map<std::string, Region*> RegionsByName;
   RegionsByName regions_byname_;
+  size_t index_slot_;  // position of the ids of this group in a combination of the RegionIndex
 };
 
 inline const std::string& RegionGroupBase::name() const
@@ -134,12 +134,8 @@ void write_dirty_data( Clib::StreamWriter& sw_data )
   // iterate over the object hash, writing dirty elements.
   // the only tricky bit here is we want to write dirty containers first.
   // this includes Characters.
-  ObjectHash::hs::const_iterator citr = objStorageManager.objecthash.begin(),
-                                 end = objStorageManager.objecthash.end();
-  for ( ; citr != end; ++citr )
+  for ( const UObject* obj : objStorageManager.objecthash.Ordered() )
   {
-    const UObjectRef& ref = ( *citr ).second;
-    const UObject* obj = ref.get();
 
     auto id = Items::find_itemdesc( obj->objtype_ );
     if ( !id.save_on_exit )
@@ -10,6 +10,7 @@
 #include <fstream>
 #include <future>
 #include <string>
+#include <vector>
 
 #include "../clib/streamsaver.h"
 
@@ -57,6 +58,14 @@ public:
   SaveStrategy party;
   static std::shared_future<bool> finished;
   static void ready();
+
+  // keeps the formatted data in memory until flush_all
+  void defer_flush();
+  // writes all files in parallel on the task thread pool
+  void flush_all();
+
+private:
+  std::vector<Clib::OFStreamWriter*> writers();
 };
 
 int save_incremental( unsigned int& dirty_writes, unsigned int& clean_objects,
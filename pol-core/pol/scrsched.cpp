@@ -15,6 +15,7 @@
 
 #include "scrsched.h"
 
+#include <algorithm>
 #include <ctime>
 #include <exception>
 
@@ -77,33 +78,26 @@ void check_blocked( polclock_t* pclocksleft )
   {
     THREAD_CHECKPOINT( scripts, 131 );
 
-    auto itr = scriptScheduler.getHoldlist().cbegin();
-    if ( itr == scriptScheduler.getHoldlist().cend() )
+    UOExecutor* ex = scriptScheduler.next_expired( now_clock );
+    if ( ex == nullptr )
       break;
-
-    UOExecutor* ex = ( *itr ).second;
     // ++ex->sleep_cycles;
 
     passert( ex->blocked() );
     passert( ex->sleep_until_clock() != 0 );
-    clocksleft = ex->sleep_until_clock() - now_clock;
-    if ( clocksleft <= 0 )
-    {
-      if ( clocksleft == 0 )
-        INC_PROFILEVAR( scripts_ontime );
-      else
-        INC_PROFILEVAR( scripts_late );
-      // wakey-wakey
-      // read comment above to understand what goes on here.
-      // the return value is already on the stack.
-      THREAD_CHECKPOINT( scripts, 132 );
-      ex->revive();
-    }
+    if ( ex->sleep_until_clock() == now_clock )
+      INC_PROFILEVAR( scripts_ontime );
     else
-    {
-      break;
-    }
-  }
+      INC_PROFILEVAR( scripts_late );
+    // wakey-wakey
+    // read comment above to understand what goes on here.
+    // the return value is already on the stack.
+    THREAD_CHECKPOINT( scripts, 132 );
+    ex->revive();
+  }
+  const HoldList& holdlist = scriptScheduler.getHoldlist();
+  if ( !holdlist.empty() )
+    clocksleft = std::min( clocksleft, holdlist.next_expiry() - now_clock );
   *pclocksleft = clocksleft;
 }
 
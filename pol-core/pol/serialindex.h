@@ -0,0 +1,175 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#ifndef POL_SERIALINDEX_H
+#define POL_SERIALINDEX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../clib/rawtypes.h"
+
+namespace Pol
+{
+namespace Core
+{
+/**
+ * Open addressing hash table from serial to object.
+ * Linear probing over a flat array, so a lookup mostly touches a single cache line instead of
+ * walking the nodes of a tree. Erase shifts the following entries back, no tombstones needed.
+ * Serials are handed out in sequence, a multiplicative hash spreads the item and the character
+ * ranges over the whole table.
+ * Ptr is what an entry holds, a raw pointer or an owning reference like UObjectRef.
+ * There is no order, for_each visits the entries as they lie in the table.
+ */
+template <class T, class Ptr = T*>
+class SerialIndex
+{
+public:
+  SerialIndex() : _entries( MIN_CAPACITY ), _shift( 32 - MIN_BITS ), _size( 0 ) {}
+  SerialIndex( const SerialIndex& ) = delete;
+  SerialIndex& operator=( const SerialIndex& ) = delete;
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  T* find( u32 serial ) const
+  {
+    const size_t mask = _entries.size() - 1;
+    for ( size_t i = slot( serial );; i = ( i + 1 ) & mask )
+    {
+      const Entry& entry = _entries[i];
+      if ( entry.empty() )
+        return nullptr;
+      if ( entry.serial == serial )
+        return pointer( entry.value );
+    }
+  }
+
+  // false if the serial is already in use
+  bool insert( u32 serial, Ptr value )
+  {
+    if ( ( _size + 1 ) * 2 > _entries.size() )
+      grow();
+    const size_t mask = _entries.size() - 1;
+    for ( size_t i = slot( serial );; i = ( i + 1 ) & mask )
+    {
+      Entry& entry = _entries[i];
+      if ( entry.empty() )
+      {
+        entry.serial = serial;
+        entry.value = std::move( value );
+        ++_size;
+        return true;
+      }
+      if ( entry.serial == serial )
+        return false;
+    }
+  }
+
+  bool erase( u32 serial )
+  {
+    const size_t mask = _entries.size() - 1;
+    size_t i = slot( serial );
+    for ( ;; i = ( i + 1 ) & mask )
+    {
+      if ( _entries[i].empty() )
+        return false;
+      if ( _entries[i].serial == serial )
+        break;
+    }
+    // an owned object is released after the table is consistent again
+    Ptr removed = Ptr();
+    std::swap( removed, _entries[i].value );
+    // move following entries of the probe sequence into the hole
+    for ( size_t j = ( i + 1 ) & mask; !_entries[j].empty(); j = ( j + 1 ) & mask )
+    {
+      const size_t home = slot( _entries[j].serial );
+      // entry j may fill hole i if its home slot is not cyclically in (i, j]
+      if ( ( ( j - home ) & mask ) >= ( ( j - i ) & mask ) )
+      {
+        _entries[i] = std::move( _entries[j] );
+        i = j;
+      }
+    }
+    _entries[i] = Entry();
+    --_size;
+    return true;
+  }
+
+  // f( T* ) for every entry, f must not insert or erase
+  template <class F>
+  void for_each( F f ) const
+  {
+    for ( const auto& entry : _entries )
+    {
+      if ( !entry.empty() )
+        f( pointer( entry.value ) );
+    }
+  }
+
+  void clear()
+  {
+    std::vector<Entry>( MIN_CAPACITY ).swap( _entries );
+    _shift = 32 - MIN_BITS;
+    _size = 0;
+  }
+
+  size_t estimatedSize() const
+  {
+    return sizeof( SerialIndex ) + _entries.capacity() * sizeof( Entry );
+  }
+
+private:
+  static const unsigned int MIN_BITS = 10;
+  static const size_t MIN_CAPACITY = size_t( 1 ) << MIN_BITS;
+
+  struct Entry
+  {
+    u32 serial = 0;
+    Ptr value = Ptr();
+
+    bool empty() const { return !value; }
+  };
+
+  static T* pointer( T* value ) { return value; }
+  template <class P>
+  static T* pointer( const P& value )
+  {
+    return value.get();
+  }
+
+  size_t slot( u32 serial ) const
+  {
+    return static_cast<u32>( serial * 2654435769u ) >> _shift;
+  }
+
+  void grow()
+  {
+    std::vector<Entry> old( _entries.size() * 2 );
+    old.swap( _entries );
+    --_shift;
+    const size_t mask = _entries.size() - 1;
+    for ( auto& entry : old )
+    {
+      if ( entry.empty() )
+        continue;
+      size_t i = slot( entry.serial );
+      while ( !_entries[i].empty() )
+        i = ( i + 1 ) & mask;
+      _entries[i] = std::move( entry );
+    }
+  }
+
+  std::vector<Entry> _entries;
+  unsigned int _shift;
+  size_t _size;
+};
+}  // namespace Core
+}  // namespace Pol
+
+#endif  // POL_SERIALINDEX_H
@@ -9,18 +9,17 @@
 
 #include <exception>
 #include <string>
-#include <time.h>
 
 #include "../bscript/berror.h"
 #include "../bscript/bobject.h"
 #include "../bscript/contiter.h"
 #include "../bscript/impstr.h"
 #include "../clib/cfgelem.h"
-#include "../clib/cfgfile.h"
 #include "../clib/clib.h"
 #include "../clib/logfacility.h"
 #include "../clib/rawtypes.h"
 #include "../clib/streamsaver.h"
+#include "../clib/timer.h"
 #include "../plib/poltype.h"
 #include "../plib/systemstate.h"
 #include "containr.h"
@@ -30,6 +29,7 @@
 #include "item/item.h"
 #include "loaddata.h"
 #include "mkscrobj.h"
+#include "parallelcfgread.h"
 #include "polcfg.h"
 #include "ufunc.h"
 #include "objtype.h"
@@ -343,7 +343,7 @@ void Storage::on_delete_realm( Realms::Realm* realm )
   }
 }
 
-void Storage::read( Clib::ConfigFile& cf )
+void Storage::read( ParallelConfigReader& cf )
 {
   static int num_until_dot = 1000;
   unsigned int nobjects = 0;
@@ -352,7 +352,7 @@ void Storage::read( Clib::ConfigFile& cf )
   Clib::ConfigElem elem;
   std::string areaName = "";
 
-  clock_t start = clock();
+  Tools::Timer<> timer;
 
   while ( cf.read( elem ) )
   {
@@ -394,10 +394,10 @@ void Storage::read( Clib::ConfigFile& cf )
     ++nobjects;
   }
 
-  clock_t end = clock();
-  int ms = static_cast<int>( ( end - start ) * 1000.0 / CLOCKS_PER_SEC );
+  timer.stop();
 
-  INFO_PRINT << " " << nobjects << " elements in " << ms << " ms.\n";
+  INFO_PRINT << " " << nobjects << " elements in " << timer.ellapsed() << " ms ("
+             << cf.timing_summary( timer.ellapsed() ) << ").\n";
 }
 
 void Storage::print( Clib::StreamWriter& sw ) const
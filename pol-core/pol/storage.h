@@ -24,12 +24,13 @@ class Realm;
 }
 namespace Clib
 {
-class ConfigFile;
 class ConfigElem;
 class StreamWriter;
 }  // namespace Clib
 namespace Core
 {
+class ParallelConfigReader;
+
 class StorageArea
 {
 public:
@@ -69,7 +70,7 @@ public:
   void on_delete_realm( Realms::Realm* realm );
 
   void print( Clib::StreamWriter& sw ) const;
-  void read( Clib::ConfigFile& cf );
+  void read( ParallelConfigReader& cf );
   void clear();
   size_t estimateSize() const;
 
@@ -47,12 +47,11 @@ void regen_stats()
   gameclock_t now_gameclock = read_gameclock();
   THREAD_CHECKPOINT( tasks, 401 );
 
-  unsigned empty_zones = 0;
-  unsigned nonempty_zones = 0;
+  // the vitals are indexed by vitalid, walk them as array instead of following Vital::next
+  const unsigned numVitals = gamestate.numVitals;
+  const auto& vitals = gamestate.vitals;
 
-  unsigned wgridx, wgridy;
-
-  auto stat_regen = [&now_gameclock, &now]( Mobile::Character* chr ) {
+  auto stat_regen = [&now_gameclock, &now, numVitals, &vitals]( Mobile::Character* chr ) {
     THREAD_CHECKPOINT( tasks, 402 );
 
     if ( chr->has_lightoverride() )
@@ -88,15 +87,17 @@ void regen_stats()
     }
 
     THREAD_CHECKPOINT( tasks, 405 );
-    for ( const Vital* pVital = FindVital( 0 ); pVital; pVital = pVital->next )
+    bool dead = chr->dead();
+    for ( unsigned vi = 0; vi < numVitals; ++vi )
     {
       THREAD_CHECKPOINT( tasks, 406 );
-      if ( !chr->dead() || pVital->regen_while_dead )
+      const Vital* pVital = vitals[vi];
+      if ( !dead || pVital->regen_while_dead )
         chr->regen_vital( pVital );
       THREAD_CHECKPOINT( tasks, 407 );
     }
 
-    if ( !chr->dead() )
+    if ( !dead )
     {
       THREAD_CHECKPOINT( tasks, 408 );
       chr->check_undamaged();
@@ -105,33 +106,29 @@ void regen_stats()
   };
 
 
-  for ( auto& realm : gamestate.Realms )
+  // only the queued characters can have anything to regenerate or to clear, the ones which
+  // scripts queue during the loop wait for the next run
+  auto& queued = gamestate.regen_characters;
+  const size_t count = queued.size();
+  size_t kept = 0;
+  for ( size_t i = 0; i < count; ++i )
   {
-    wgridx = realm->grid_width();
-    wgridy = realm->grid_height();
-
-    for ( unsigned wx = 0; wx < wgridx; ++wx )
+    Mobile::Character* chr = queued[i].get();
+    // only characters in the world regenerate, entering it queues them again
+    if ( !chr->orphan() && chr->logged_in() )
     {
-      for ( unsigned wy = 0; wy < wgridy; ++wy )
+      stat_regen( chr );
+      if ( chr->regen_pending() )
       {
-        bool any = false;
-        for ( auto& chr : realm->zone[wx][wy].characters )
-        {
-          any = true;
-          stat_regen( chr );
-        }
-        for ( auto& chr : realm->zone[wx][wy].npcs )
-        {
-          any = true;
-          stat_regen( chr );
-        }
-        if ( any )
-          ++nonempty_zones;
-        else
-          ++empty_zones;
+        if ( kept != i )
+          queued[kept] = queued[i];
+        ++kept;
+        continue;
       }
     }
+    chr->dequeue_regen();
   }
+  queued.erase( queued.begin() + kept, queued.begin() + count );
   THREAD_CHECKPOINT( tasks, 499 );
 }
 
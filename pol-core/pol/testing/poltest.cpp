@@ -33,8 +33,23 @@ void run_pol_tests()
 //  walk_test();
 //  multiwalk_test();
 //  map_test();
+//  pathfind_test();
 //  dynprops_test();
   packet_test();
+  packet_shared_test();
+  huffman_test();
+  timerwheel_test();
+  decay_test();
+  regionraster_test();
+  proplist_test();
+  gumpcache_test();
+  customhouse_test();
+  listenpoint_test();
+  parallelcfgread_test();
+  binaryworldsave_test();
+  serialindex_test();
+  snapshotsave_test();
+  account_test();
   dummy();
   display_test_results();
 }
@@ -45,9 +45,24 @@ void walk_test();
 void multiwalk_test();
 void drop_test();
 void los_test();
+void pathfind_test();
 void dynprops_test();
 void dummy();
 void packet_test();
+void packet_shared_test();
+void huffman_test();
+void timerwheel_test();
+void decay_test();
+void regionraster_test();
+void proplist_test();
+void gumpcache_test();
+void customhouse_test();
+void listenpoint_test();
+void parallelcfgread_test();
+void binaryworldsave_test();
+void serialindex_test();
+void snapshotsave_test();
+void account_test();
 }
 }
 #endif
@@ -0,0 +1,132 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#include "testenv.h"
+
+#include "pol_global_config.h"
+
+#include <cstring>
+#include <vector>
+
+#ifdef ENABLE_BENCHMARK
+#include <benchmark/benchmark.h>
+#endif
+
+#include "../../clib/logfacility.h"
+#include "../../clib/random.h"
+#include "../ctable.h"
+#include "../network/huffman.h"
+
+namespace Pol
+{
+namespace Testing
+{
+namespace
+{
+// former bit by bit implementation of Client::transmit_encrypted, used as reference
+unsigned int huffman_compress_bitwise( unsigned char* out, const unsigned char* data,
+                                       unsigned int len )
+{
+  unsigned char* pch = out;
+  int bidx = 0;
+  for ( unsigned int i = 0; i <= len; i++ )
+  {
+    unsigned int ch = i < len ? data[i] : 0x100;  // terminator
+    int nbits = Core::keydesc[ch].nbits;
+    unsigned short inval = Core::keydesc[ch].bits_reversed;
+    while ( nbits-- )
+    {
+      *pch <<= 1;
+      if ( inval & 1 )
+        *pch |= 1;
+      bidx++;
+      if ( bidx == 8 )
+      {
+        pch++;
+        bidx = 0;
+      }
+      inval >>= 1;
+    }
+  }
+  if ( bidx == 0 )
+    pch--;
+  else
+    *pch <<= ( 8 - bidx );
+  return static_cast<unsigned int>( pch - out + 1 );
+}
+
+std::vector<unsigned char> random_packet( unsigned int len )
+{
+  std::vector<unsigned char> data( len );
+  for ( auto& c : data )
+    c = static_cast<unsigned char>( Clib::random_int( 255 ) );
+  return data;
+}
+
+void test_huffman( const std::vector<unsigned char>& data )
+{
+  std::vector<unsigned char> expected( data.size() * 2 + 4 );
+  std::vector<unsigned char> result( data.size() * 2 + 4 );
+  unsigned int expected_len = huffman_compress_bitwise(
+      expected.data(), data.data(), static_cast<unsigned int>( data.size() ) );
+  unsigned int result_len = Network::huffman_compress(
+      result.data(), data.data(), static_cast<unsigned int>( data.size() ) );
+  if ( expected_len == result_len && memcmp( expected.data(), result.data(), result_len ) == 0 )
+  {
+    inc_successes();
+  }
+  else
+  {
+    INFO_PRINT << "Huffman test failure: size " << data.size() << " expected " << expected_len
+               << " bytes got " << result_len << "\n";
+    inc_failures();
+  }
+}
+}  // namespace
+
+void huffman_test()
+{
+#ifndef ENABLE_BENCHMARK
+  INFO_PRINT << "Huffman compression tests:\n";
+#endif
+  for ( unsigned int len = 0; len < 64; ++len )
+    test_huffman( random_packet( len ) );
+  for ( unsigned int i = 0; i < 256; ++i )
+    test_huffman( std::vector<unsigned char>( 17, static_cast<unsigned char>( i ) ) );
+  test_huffman( random_packet( 4096 ) );
+  test_huffman( random_packet( 0xFFFF / 2 ) );
+}
+
+#ifdef ENABLE_BENCHMARK
+
+static void BM_huffman_bitwise( benchmark::State& state )
+{
+  auto data = random_packet( static_cast<unsigned int>( state.range( 0 ) ) );
+  std::vector<unsigned char> out( data.size() * 2 + 4 );
+  while ( state.KeepRunning() )
+  {
+    benchmark::DoNotOptimize( huffman_compress_bitwise( out.data(), data.data(),
+                                                        static_cast<unsigned int>( data.size() ) ) );
+  }
+  state.SetBytesProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( BM_huffman_bitwise )->Arg( 16 )->Arg( 256 )->Arg( 4096 );
+
+static void BM_huffman_table( benchmark::State& state )
+{
+  auto data = random_packet( static_cast<unsigned int>( state.range( 0 ) ) );
+  std::vector<unsigned char> out( data.size() * 2 + 4 );
+  while ( state.KeepRunning() )
+  {
+    benchmark::DoNotOptimize( Network::huffman_compress( out.data(), data.data(),
+                                                         static_cast<unsigned int>( data.size() ) ) );
+  }
+  state.SetBytesProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( BM_huffman_table )->Arg( 16 )->Arg( 256 )->Arg( 4096 );
+#endif
+}  // namespace Testing
+}  // namespace Pol
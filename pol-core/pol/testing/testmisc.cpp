@@ -3,23 +3,93 @@
  * @par History
  */
 
+#include "pol_global_config.h"
+
 #include <algorithm>
 #include <array>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "../../bscript/bobject.h"
+#include "../../clib/binarycfg.h"
+#include "../../clib/cfgelem.h"
+#include "../../clib/cfgfile.h"
+#include "../../clib/fileutil.h"
 #include "../../clib/logfacility.h"
+#include "../../clib/random.h"
 #include "../../clib/rawtypes.h"
+#include "../../clib/streamsaver.h"
 #include "../../plib/maptile.h"
+#include "../../plib/systemstate.h"
+#include "../accounts/account.h"
+#include "../accounts/accounts.h"
+#include "../decay.h"
 #include "../dynproperties.h"
+#include "../gameclck.h"
 #include "../globals/uvars.h"
+#include "../item/item.h"
+#include "../listenpt.h"
+#include "../module/osmod.h"
+#include "../mobile/npc.h"
+#include "../multi/customhouses.h"
+#include "../network/gumpcache.h"
 #include "../network/packethelper.h"
+#include "../parallelcfgread.h"
+#include "../proplist.h"
+#include "../region.h"
 #include "../realms/realm.h"
+#include "../scrsched.h"
+#include "../timerwheel.h"
+#include "../uoexec.h"
+#include "../uworld.h"
+#include "testenv.h"
+
+#ifdef USE_SYSTEM_ZLIB
+#include <zlib.h>
+#else
+#include "../../../lib/zlib/zlib.h"
+#endif
 
 namespace Pol
 {
 namespace Testing
 {
+namespace
+{
+// compares all remaining elements of both readers
+template <class Expected, class Reader>
+bool same_elements( Expected& expected_reader, Reader& reader )
+{
+  Clib::ConfigElem expected, elem;
+  for ( ;; )
+  {
+    bool got_expected = expected_reader.read( expected );
+    if ( got_expected != reader.read( elem ) )
+      return false;
+    if ( !got_expected )
+      return true;
+    if ( strcmp( expected.type(), elem.type() ) != 0 ||
+         strcmp( expected.rest(), elem.rest() ) != 0 )
+      return false;
+    std::string name1, value1, name2, value2;
+    bool more;
+    do
+    {
+      more = expected.remove_first_prop( &name1, &value1 );
+      if ( more != elem.remove_first_prop( &name2, &value2 ) ||
+           ( more && ( name1 != name2 || value1 != value2 ) ) )
+        return false;
+    } while ( more );
+  }
+}
+}  // namespace
+
 void dummy() {}
 
 void map_test()
@@ -153,5 +223,674 @@ void packet_test()
   }
 }
 
+void packet_shared_test()
+{
+  // broadcasts queue one refcounted copy for every receiver, see PacketOut::SendShared
+  using namespace Network;
+  using namespace Network::PktHelper;
+  bool ok = true;
+  std::weak_ptr<const std::vector<u8>> released;
+  {
+    std::vector<TransmitData> queue( 3 );
+    std::vector<u8> expected;
+    {
+      PacketOut<PktOut_2F> p;
+      p->Write<u32>( 0x12344321u );
+      p->Write<u16>( 0x4321u );
+      const int len = p->offset;
+      expected.assign( reinterpret_cast<const u8*>( &p->buffer ),
+                       reinterpret_cast<const u8*>( &p->buffer ) + len );
+      // unchanged content: every receiver gets the same copy
+      for ( auto& entry : queue )
+        entry.shared = p.Shared( len );
+      ok = queue[0].shared != nullptr && queue[0].shared == queue[1].shared &&
+           queue[1].shared == queue[2].shared && *queue[0].shared == expected &&
+           queue[0].shared.use_count() == 4;
+
+      // a changed packet gets a new copy, the queued one keeps the sent bytes
+      p->offset = 1;
+      p->Write<u32>( 0x0u );
+      auto changed = p.Shared( len );
+      ok = ok && changed != queue[0].shared && changed->size() == expected.size() &&
+           *changed != expected && *queue[0].shared == expected;
+      // so does a different length
+      ok = ok && p.Shared( 3 )->size() == 3;
+    }
+    // the packet went back to the pool, the next user overwrites its buffer
+    {
+      PacketOut<PktOut_2F> p;
+      p->Write<u32>( 0xFFFFFFFFu );
+      p->Write<u16>( 0xFFFFu );
+      ok = ok && *queue[2].shared == expected && *p.Shared() != expected;
+    }
+    released = queue[0].shared;
+    // the transmit thread drops the entries one after the other
+    queue[0].shared.reset();
+    queue[1].shared.reset();
+    ok = ok && !released.expired() && *released.lock() == expected;
+    queue[2].shared.reset();
+  }
+  ok = ok && released.expired();
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "shared packet test failure\n";
+    inc_failures();
+  }
+}
+
+void timerwheel_test()
+{
+  struct Entry;
+  typedef Core::TimerWheel<Entry, Core::polclock_t> Wheel;
+  struct Entry
+  {
+    Wheel::Node node;
+    Entry() : node( this ) {}
+  };
+  // compare the expiration order against a multimap, delays cover all levels and the overflow
+  const Core::polclock_t delays[] = {0, 1, 63, 64, 65, 700, 4095, 4096, 5000, 262143, 262144,
+                                     300000, 16777215, 16777216, 20000000, 50000000};
+  std::vector<Entry> entries( 64 );
+  Wheel wheel;
+  std::multimap<Core::polclock_t, Entry*> expected;
+  Core::polclock_t now = 12345;
+  size_t i = 0;
+  for ( auto& entry : entries )
+  {
+    Core::polclock_t when = now + delays[i % 16] + i / 16;
+    wheel.insert( &entry.node, when );
+    expected.insert( std::make_pair( when, &entry ) );
+    ++i;
+  }
+  // cancel some
+  for ( i = 0; i < entries.size(); i += 7 )
+  {
+    wheel.erase( &entries[i].node );
+    for ( auto itr = expected.begin(); itr != expected.end(); ++itr )
+    {
+      if ( itr->second == &entries[i] )
+      {
+        expected.erase( itr );
+        break;
+      }
+    }
+  }
+  bool ok = wheel.size() == expected.size();
+  while ( ok && !expected.empty() )
+  {
+    if ( wheel.next_expiry() > expected.begin()->first )
+      ok = false;
+    now += 997;
+    while ( Entry* entry = wheel.next_expired( now ) )
+    {
+      if ( expected.empty() || expected.begin()->second->node.when() != entry->node.when() ||
+           entry->node.when() > now )
+      {
+        ok = false;
+        break;
+      }
+      wheel.erase( &entry->node );
+      expected.erase( expected.begin() );
+    }
+    if ( !expected.empty() && expected.begin()->first <= now )
+      ok = false;
+  }
+  if ( ok && wheel.empty() )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "TimerWheel test failure\n";
+    inc_failures();
+  }
+}
+
+void decay_test()
+{
+  // items lying in the world wait in the decay queue of their realm while they can decay
+  Core::DecayQueue& queue = Core::gamestate.main_realm->decay_queue;
+  size_t queued = queue.size();
+  Items::Item* item = add_item( 0xeed, 1398, 1625, 29 );
+  item->movable( true );
+  item->decayat_gameclock_ = Core::read_gameclock() + 100;
+  Core::schedule_decay( item );
+  Core::DecayEntry* entry = item->decay_entry.get();
+  bool ok = entry != nullptr && entry->node.linked() && entry->queue == &queue &&
+            entry->node.when() == item->decayat_gameclock_ + 1;
+  item->movable( false );
+  ok = ok && !entry->node.linked() && queue.size() == queued;
+  item->movable( true );
+  ok = ok && entry->node.linked();
+  item->disable_decay();
+  ok = ok && !entry->node.linked();
+  item->set_decay_after( 60 );  // does not enable decay again
+  ok = ok && !entry->node.linked();
+  item->decayat_gameclock_ = Core::read_gameclock() + 100;
+  Core::schedule_decay( item );
+  Core::remove_item_from_world( item );
+  ok = ok && item->decay_entry == nullptr && queue.size() == queued;
+  item->destroy();
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "Decay queue test failure\n";
+    inc_failures();
+  }
+}
+
+void regionraster_test()
+{
+  // compare against a plain array, the size is no multiple of the block size
+  const unsigned width = 203;
+  const unsigned height = 151;
+  Core::RegionRaster raster( width, height );
+  Core::RegionRaster other( width, height );
+  std::vector<Core::RegionId> expected( width * height, 0 );
+  std::vector<Core::RegionId> expected_other( width * height, 0 );
+  auto random_rect = [&]( unsigned& x1, unsigned& y1, unsigned& x2, unsigned& y2 ) {
+    x1 = static_cast<unsigned>( Clib::random_int( width - 1 ) );
+    y1 = static_cast<unsigned>( Clib::random_int( height - 1 ) );
+    x2 = std::min( width - 1, x1 + static_cast<unsigned>( Clib::random_int( 80 ) ) );
+    y2 = std::min( height - 1, y1 + static_cast<unsigned>( Clib::random_int( 80 ) ) );
+  };
+  bool ok = true;
+  for ( int i = 0; i < 500 && ok; ++i )
+  {
+    unsigned x1, y1, x2, y2;
+    random_rect( x1, y1, x2, y2 );
+    Core::RegionId id = static_cast<Core::RegionId>( Clib::random_int( 3 ) );
+    if ( i % 5 == 4 )
+    {
+      raster.copy( other, x1, y1, x2, y2 );
+      for ( unsigned x = x1; x <= x2; ++x )
+        for ( unsigned y = y1; y <= y2; ++y )
+          expected[x * height + y] = expected_other[x * height + y];
+    }
+    else if ( i % 7 == 6 )
+    {
+      auto id_at = []( unsigned x, unsigned y ) {
+        return static_cast<Core::RegionId>( ( x / 3 + y / 5 ) % 3 );
+      };
+      raster.assign( x1, y1, x2, y2, id_at );
+      for ( unsigned x = x1; x <= x2; ++x )
+        for ( unsigned y = y1; y <= y2; ++y )
+          expected[x * height + y] = id_at( x, y );
+    }
+    else if ( i % 2 )
+    {
+      raster.paint( x1, y1, x2, y2, id );
+      for ( unsigned x = x1; x <= x2; ++x )
+        for ( unsigned y = y1; y <= y2; ++y )
+          expected[x * height + y] = id;
+    }
+    else
+    {
+      other.paint( x1, y1, x2, y2, id );
+      for ( unsigned x = x1; x <= x2; ++x )
+        for ( unsigned y = y1; y <= y2; ++y )
+          expected_other[x * height + y] = id;
+    }
+    for ( unsigned x = 0; x < width && ok; ++x )
+    {
+      for ( unsigned y = 0; y < height; ++y )
+      {
+        if ( raster.get( x, y ) != expected[x * height + y] ||
+             other.get( x, y ) != expected_other[x * height + y] )
+        {
+          ok = false;
+          break;
+        }
+      }
+    }
+  }
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "RegionRaster test failure\n";
+    inc_failures();
+  }
+}
+
+void proplist_test()
+{
+  // the decoded value cache must not leak changes of a read copy, must follow writes and
+  // gets dropped by a worldsave
+  Core::PropertyList props( Core::CPropProfiler::Type::GLOBAL );
+  Bscript::ObjArray arr;
+  arr.addElement( new Bscript::BLong( 1 ) );
+  props.setprop( "arr", arr.pack() );
+  size_t uncached_size = props.estimatedSize();
+  bool ok = true;
+  for ( int i = 0; i < 3; ++i )
+  {
+    Bscript::BObject read( props.getpropimp( "arr" ) );
+    auto read_arr = static_cast<Bscript::ObjArray*>( read.impptr() );
+    ok = ok && read.isa( Bscript::BObjectImp::OTArray ) && read_arr->ref_arr.size() == 1;
+    read_arr->addElement( new Bscript::BLong( 2 ) );
+  }
+  ok = ok && props.estimatedSize() > uncached_size;
+  Core::PropertyList::forget_all_decoded();
+  ok = ok && props.estimatedSize() == uncached_size;
+  arr.addElement( new Bscript::BLong( 3 ) );
+  props.setprop( "arr", arr.pack() );
+  {
+    Bscript::BObject read( props.getpropimp( "arr" ) );
+    ok = ok && read->pack() == arr.pack();
+  }
+  props.eraseprop( "arr" );
+  ok = ok && props.getpropimp( "arr" ) == nullptr;
+  props.setprop( "num", "i5" );
+  {
+    Bscript::BObject read( props.getpropimp( "num" ) );
+    ok = ok && read->pack() == "i5";
+  }
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "PropertyList test failure\n";
+    inc_failures();
+  }
+}
+
+void gumpcache_test()
+{
+  // identical gumps share one entry, the blocks uncompress to the input and the size is capped
+  Network::GumpCache cache;
+  unsigned int old_size = Plib::systemstate.config.gump_cache_size;
+  Plib::systemstate.config.gump_cache_size = 4;
+  std::string layout = "{ page 0 }{ resizepic 0 0 5054 200 200 }{ text 20 20 0 0 }";
+  layout.push_back( '\0' );
+  const u8* layout_data = reinterpret_cast<const u8*>( layout.data() );
+  std::string text( "\0\x03\0a\0b\0c", 8 );
+  const u8* text_data = reinterpret_cast<const u8*>( text.data() );
+
+  auto first = cache.get( layout_data, static_cast<u32>( layout.size() ), text_data, 8, 1 );
+  auto second = cache.get( layout_data, static_cast<u32>( layout.size() ), text_data, 8, 1 );
+  auto other = cache.get( layout_data, static_cast<u32>( layout.size() ), text_data, 0, 0 );
+  bool ok = first != nullptr && first == second && other != first && other->numlines == 0;
+  // same lengths and line count, only the bytes differ
+  std::string changed( "\0\x03\0a\0b\0d", 8 );
+  auto forged = cache.get( layout_data, static_cast<u32>( layout.size() ),
+                           reinterpret_cast<const u8*>( changed.data() ), 8, 1 );
+  ok = ok && forged != nullptr && forged != first;
+  if ( ok )
+  {
+    std::string plain( layout.size(), ' ' );
+    uLongf plainlen = static_cast<uLongf>( plain.size() );
+    ok = uncompress( reinterpret_cast<Bytef*>( &plain[0] ), &plainlen,
+                     reinterpret_cast<const Bytef*>( first->layout.data.data() ),
+                     static_cast<uLong>( first->layout.data.size() ) ) == Z_OK &&
+         plain == layout && first->text.dlen == 8;
+  }
+  Network::GumpCache::Stats stats = cache.stats();
+  ok = ok && stats.hits == 1 && stats.misses == 3 && stats.entries == 3;
+
+  // barely compressible layouts, the oldest ones have to go
+  for ( int i = 0; i < 20; ++i )
+  {
+    std::string noise;
+    for ( int k = 0; k < 1000; ++k )
+      noise.push_back( static_cast<char>( Clib::random_int( 255 ) ) );
+    cache.get( reinterpret_cast<const u8*>( noise.data() ), static_cast<u32>( noise.size() ),
+               text_data, 0, 0 );
+  }
+  stats = cache.stats();
+  ok = ok && stats.evictions > 0 && stats.bytes <= 4 * 1024;
+  Plib::systemstate.config.gump_cache_size = old_size;
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "GumpCache test failure\n";
+    inc_failures();
+  }
+}
+
+void customhouse_test()
+{
+  // planes are compressed once, copies keep them and only an edited floor gets compressed again
+  auto plane = []( const Multi::CustomHouseDesign& design, int floor, std::string& out ) {
+    u32 ulen;
+    const std::vector<u8>* data = design.Compress( floor, &ulen );
+    if ( data == nullptr )
+      return static_cast<const std::vector<u8>*>( nullptr );
+    out.assign( ulen, '\0' );
+    uLongf len = ulen;
+    if ( ulen != 0 && uncompress( reinterpret_cast<Bytef*>( &out[0] ), &len, data->data(),
+                                  static_cast<uLong>( data->size() ) ) != Z_OK )
+      return static_cast<const std::vector<u8>*>( nullptr );
+    return data;
+  };
+  Multi::CustomHouseDesign design;
+  design.InitDesign( 8, 7, 3, 3 );
+  Multi::CUSTOM_HOUSE_ELEMENT elem;
+  elem.z = 7;
+  elem.xoffset = 1;
+  elem.yoffset = -2;
+  elem.graphic = 0x0123;
+  design.Add( elem );
+  elem.xoffset = -3;
+  elem.graphic = 0x0456;
+  design.Add( elem );
+  elem.z = 0;
+  design.Add( elem );
+
+  std::string floor1;
+  const std::vector<u8>* first = plane( design, 1, floor1 );
+  // x major order, -3 before 1
+  bool ok = first != nullptr &&
+            floor1 == std::string( "\x04\x56\xfd\xfe\x07\x01\x23\x01\xfe\x07", 10 );
+  std::string again;
+  ok = ok && plane( design, 1, again ) == first && again == floor1;
+
+  Multi::CustomHouseDesign copy;
+  copy.InitDesign( 8, 7, 3, 3 );
+  copy = design;
+  std::string floor0;
+  ok = ok && plane( copy, 1, again ) != nullptr && again == floor1;
+  const std::vector<u8>* ground = plane( copy, 0, floor0 );
+  ok = ok && copy.EraseGraphicAt( 0x0456, static_cast<u32>( -3 ), static_cast<u32>( -2 ), 7 );
+  ok = ok && plane( copy, 1, again ) != nullptr &&
+       again == std::string( "\x01\x23\x01\xfe\x07", 5 ) && plane( copy, 0, floor0 ) == ground &&
+       floor0 == std::string( "\x04\x56\xfd\xfe\x00", 5 );
+  ok = ok && plane( design, 1, again ) != nullptr && again == floor1;
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "CustomHouseDesign test failure\n";
+    inc_failures();
+  }
+}
+
+void listenpoint_test()
+{
+  // npc listen points are looked up by the npcs of the zones, the rest stays a list
+  Core::ListenPointIndex index;
+  Core::ListenPoint npc_near( test_banker, nullptr, 5, 0 );
+  Core::ListenPoint npc_far( test_banker, nullptr, 12, 0 );
+  Core::ListenPoint npc_huge( test_banker, nullptr, 0x7FFFFFFF, 0 );
+  Core::ListenPoint chest( test_chest1, nullptr, 3, 0 );
+  index.add( &npc_near );
+  index.add( &npc_far );
+  index.add( &npc_huge );
+  index.add( &chest );
+  bool ok = index.max_npc_range() == 12 && index.others().size() == 2;
+
+  unsigned found = 0;
+  Core::WorldIterator<Core::NPCFilter>::InRange(
+      test_banker->x + 5, test_banker->y, test_banker->realm, 5, [&]( Mobile::Character* chr ) {
+        index.forEachOfNpc( chr, [&]( Core::ListenPoint* ) { ++found; } );
+      } );
+  ok = ok && found == 2;
+
+  index.remove( &npc_far );
+  ok = ok && index.max_npc_range() == 5;
+  index.remove( &npc_near );
+  index.remove( &npc_huge );
+  index.remove( &chest );
+  ok = ok && index.max_npc_range() == -1 && index.others().empty();
+
+  // the speech itself: near, unlimited range and out of range listeners
+  std::unique_ptr<Core::UOExecutor> near_ex( Core::create_script_executor() );
+  std::unique_ptr<Core::UOExecutor> huge_ex( Core::create_script_executor() );
+  std::unique_ptr<Core::UOExecutor> far_ex( Core::create_script_executor() );
+  Core::register_for_speech_events( test_banker, near_ex.get(), 5, 0 );
+  Core::register_for_speech_events( test_banker2, huge_ex.get(), 0x7FFFFFFF, 0 );
+  Core::register_for_speech_events( test_chest1, far_ex.get(), 3, 0 );
+  Core::sayto_listening_points( test_banker, "hello", Plib::TEXTTYPE_NORMAL );
+  auto events = []( Core::UOExecutor* ex ) {
+    return static_cast<Module::OSExecutorModule*>( ex->findModule( "OS" ) )->events_waiting();
+  };
+  ok = ok && events( near_ex.get() ) == 1 && events( huge_ex.get() ) == 1 &&
+       events( far_ex.get() ) == 0;
+  Core::deregister_from_speech_events( near_ex.get() );
+  Core::deregister_from_speech_events( huge_ex.get() );
+  Core::deregister_from_speech_events( far_ex.get() );
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "ListenPointIndex test failure\n";
+    inc_failures();
+  }
+}
+
+void parallelcfgread_test()
+{
+  // the chunked parallel reader has to return the same elements as ConfigFile, the file contains
+  // crlf line endings, indented closing braces and an element larger than a chunk
+  const char* filename = "parallelcfgread_test.txt";
+  FILE* fp = fopen( filename, "wb" );
+  for ( int i = 0; i < 20000; ++i )
+  {
+    fprintf( fp, "Item 0x%08X\n{\n\tSerial\t0x%X\n", i, i );
+    fprintf( fp, "\tName\t\"a \\\"b\\\" %d\"\n// comment\n", i );
+    fprintf( fp, "%s\n\n", i % 3 == 0 ? "  }" : "}" );
+    if ( i == 10000 )
+    {
+      fprintf( fp, "Item big\r\n{\r\n\tData\t" );
+      for ( int k = 0; k < 3000000; ++k )
+        fputc( 'a' + k % 26, fp );
+      fprintf( fp, "\r\n}\r\n" );
+    }
+  }
+  fprintf( fp, "Item last\n{\n\tX\t1\n}" );
+  fclose( fp );
+
+  bool ok;
+  {
+    Clib::ConfigFile cf( filename, "Item" );
+    Core::ParallelConfigReader reader( filename, "Item" );
+    ok = same_elements( cf, reader );
+  }
+  remove( filename );
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "ParallelConfigReader test failure\n";
+    inc_failures();
+  }
+}
+
+void binaryworldsave_test()
+{
+  // the binary format has to give the same elements as the text it was created from, with
+  // values which look like numbers but don't print back identically, typed cprops, quoting and
+  // the line rules of ConfigFile
+  const char* textfile = "binaryworldsave_test.txt";
+  const char* binfile = "binaryworldsave_test.bin";
+  const char* savefile = "binaryworldsave_test.nbn";
+  const char* backfile = "binaryworldsave_test.back.txt";
+  std::string text = "# comment\n\n";
+  for ( int i = 0; i < 5000; ++i )
+  {
+    fmt::Writer w;
+    w << "Item " << ( i % 2 ? "" : "rest of line" ) << "\n{\n\tSerial\t0x" << fmt::hex( i )
+      << "\n\tAmount\t" << ( i - 2500 ) << "\n\tColor\t0x00" << fmt::hex( i )
+      << "\n\tZ\t007\n\tX\t-0\n\tY\t0xABC\n\tEmpty\t\n"
+      << "\tName\t\"  spaces \\\"quoted\\\"\\nnewline \"\n"
+      << "\tCProp\tint i" << i << "\n\tCProp\tstr sstring " << i << "\n"
+      << "\tCProp\tarr a2:i1i2\n\tCProp\tlead i007\n\tCProp\ttab\ti5\n"
+      << "\tCProp\treal r1.5\n\tcprop\tflag b1\n\tMixed\t0xAbC\n\t# inner comment\n"
+      << "\tEq=value\n\tCR\tline \r\n\tIso\t\xE9t\xE9\n"
+      << "\tBig\t123456789012345678901234567890\n}\n\n";
+    text += w.str();
+  }
+  {
+    std::ofstream ofs( textfile, std::ios::out | std::ios::binary );
+    ofs << text;
+  }
+
+  bool ok = true;
+  try
+  {
+    // like a worldsave: formatted text in small pieces, encoded while writing
+    {
+      std::ofstream stream;
+      Clib::OFStreamWriter sw( &stream );
+      sw.init_binary( savefile );
+      for ( size_t pos = 0; pos < text.size(); pos += 777 )
+      {
+        sw() << text.substr( pos, 777 );
+        sw.flush();
+      }
+      sw.flush_file();
+    }
+    Clib::convert_config_to_binary( textfile, binfile );
+    Clib::convert_config_to_text( binfile, backfile );
+    {
+      Clib::ConfigFile cf( textfile );
+      Clib::BinaryConfigFile bcf( savefile );
+      ok = same_elements( cf, bcf ) && ok;
+    }
+    {
+      Clib::ConfigFile cf( textfile );
+      Core::ParallelConfigReader reader( binfile, "Item" );
+      ok = same_elements( cf, reader ) && ok;
+    }
+    {
+      Clib::ConfigFile cf( textfile );
+      Clib::ConfigFile back( backfile );
+      ok = same_elements( cf, back ) && ok;
+    }
+    ok = ok && Clib::BinaryConfigFile::is_binary( binfile ) &&
+         !Clib::BinaryConfigFile::is_binary( textfile );
+  }
+  catch ( std::exception& ex )
+  {
+    INFO_PRINT << ex.what() << "\n";
+    ok = false;
+  }
+  remove( textfile );
+  remove( binfile );
+  remove( savefile );
+  remove( backfile );
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "Binary worldsave test failure\n";
+    inc_failures();
+  }
+}
+
+void snapshotsave_test()
+{
+  // the kept text has to follow turns and moves, also those which bypass set_dirty
+  auto print = []( const Core::UObject* obj, bool snapshot ) {
+    Plib::systemstate.config.snapshot_worldsave = snapshot;
+    Clib::FMTStreamWriter sw;
+    obj->printOn( sw );
+    return sw().str();
+  };
+  bool old_snapshot = Plib::systemstate.config.snapshot_worldsave;
+  u8 old_facing = test_banker->facing;
+  u16 old_x = test_chest1->x;
+
+  print( test_banker, true );
+  print( test_chest1, true );
+  bool ok = Core::UObject::saved_text_bytes > 0;
+
+  test_banker->setfacing( static_cast<u8>( old_facing + 1 ) );
+  ok = ok && print( test_banker, true ) == print( test_banker, false );
+  print( test_chest1, true );
+  ++test_chest1->x;
+  ok = ok && print( test_chest1, true ) == print( test_chest1, false );
+  ok = ok && Core::UObject::saved_text_bytes == 0;
+
+  // a deferred save file writes the kept text even after the object dropped it
+  const char* savefile = "snapshottest.txt";
+  Core::UObject* objs[] = {test_chest1, test_banker};
+  std::string expected;
+  for ( const auto obj : objs )
+    expected += print( obj, false );
+  Plib::systemstate.config.snapshot_worldsave = true;
+  {
+    std::ofstream ofs;
+    Clib::OFStreamWriter sw( &ofs );
+    sw.init( savefile );
+    sw.defer_flush( true );
+    for ( const auto obj : objs )
+      obj->printOn( sw );
+    for ( const auto obj : objs )
+      obj->set_dirty();
+    sw.flush_file();
+  }
+  std::ifstream ifs( savefile, std::ios::binary );
+  std::string written( ( std::istreambuf_iterator<char>( ifs ) ),
+                       std::istreambuf_iterator<char>() );
+  ifs.close();
+  remove( savefile );
+  ok = ok && written == expected && Core::UObject::saved_text_bytes == 0;
+
+  test_chest1->x = old_x;
+  test_banker->setfacing( old_facing );
+  Plib::systemstate.config.snapshot_worldsave = old_snapshot;
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "snapshot worldsave kept outdated text\n";
+    inc_failures();
+  }
+}
+
+void account_test()
+{
+  // a rename moves the name index entry and the journal replays it as delete plus add
+  auto& config = Plib::systemstate.config;
+  std::string old_path = config.world_data_path;
+  bool old_journal = config.account_journal;
+  int old_save = config.account_save;
+  config.world_data_path = "accounttest_";
+  config.account_journal = true;
+  config.account_save = 0;
+  std::string journalfile = config.world_data_path + "accounts.jnl";
+  remove( journalfile.c_str() );
+  size_t accounts = Core::gamestate.accounts.size();
+
+  Accounts::Account* acct = Accounts::create_new_account( "renametest_old", "pw", true );
+  Core::gamestate.changed_accounts.clear();  // as if it was in accounts.txt
+  bool ok = Accounts::rename_account( acct, "RenameTest_New" );
+  ok = ok && Accounts::find_account( "renametest_new" ) == acct &&
+       Accounts::find_account( "renametest_old" ) == nullptr;
+  Accounts::Account* other = Accounts::create_new_account( "renametest_other", "pw", true );
+  ok = ok && !Accounts::rename_account( other, "RENAMETEST_NEW" );
+  Accounts::delete_account( "renametest_other" );
+  Core::gamestate.changed_accounts.erase( "renametest_other" );
+  Accounts::write_account_changes();
+  ok = ok && Core::gamestate.changed_accounts.empty() && Clib::FileExists( journalfile );
+
+  // replay onto the state before the rename
+  Accounts::rename_account( acct, "renametest_old" );
+  Core::gamestate.changed_accounts.clear();
+  Accounts::read_account_journal();
+  Accounts::Account* replayed = Accounts::find_account( "renametest_new" );
+  ok = ok && replayed != nullptr && strcmp( replayed->name(), "RenameTest_New" ) == 0 &&
+       Accounts::find_account( "renametest_old" ) == nullptr &&
+       Core::gamestate.accounts.size() == accounts + 1;
+
+  Accounts::delete_account( "renametest_new" );
+  Core::gamestate.changed_accounts.clear();
+  Core::gamestate.account_journal_records = 0;
+  Plib::systemstate.accounts_txt_dirty = false;
+  remove( journalfile.c_str() );
+  config.world_data_path = old_path;
+  config.account_journal = old_journal;
+  config.account_save = old_save;
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "account rename test failure\n";
+    inc_failures();
+  }
+}
 }  // namespace Testing
 }  // namespace Pol
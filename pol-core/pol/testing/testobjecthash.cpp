@@ -0,0 +1,186 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#include "testenv.h"
+
+#include "pol_global_config.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#ifdef ENABLE_BENCHMARK
+#include <benchmark/benchmark.h>
+#endif
+
+#include "../../clib/logfacility.h"
+#include "../../clib/random.h"
+#include "../../clib/rawtypes.h"
+#include "../../clib/refptr.h"
+#include "../globals/state.h"
+#include "../serialindex.h"
+
+namespace Pol
+{
+namespace Testing
+{
+namespace
+{
+// serials like a shard hands them out: a few characters and mostly items
+std::vector<u32> make_serials( size_t count )
+{
+  std::vector<u32> serials;
+  serials.reserve( count );
+  for ( size_t i = 0; i < count; ++i )
+  {
+    if ( i % 16 == 0 )
+      serials.push_back( Core::CHARACTERSERIAL_START + static_cast<u32>( i / 16 ) );
+    else
+      serials.push_back( Core::ITEMSERIAL_START + static_cast<u32>( i ) );
+  }
+  return serials;
+}
+
+struct Counted : public ref_counted
+{
+  explicit Counted( int& alive ) : _alive( alive ) { ++_alive; }
+  ~Counted() { --_alive; }
+  int& _alive;
+};
+}  // namespace
+
+void serialindex_test()
+{
+  // compare against a map while inserting, erasing and growing
+  std::vector<u32> serials = make_serials( 50000 );
+  std::vector<int> values( serials.size() );
+  Core::SerialIndex<int> index;
+  std::map<u32, int*> expected;
+  bool ok = true;
+  for ( size_t i = 0; i < serials.size(); ++i )
+  {
+    index.insert( serials[i], &values[i] );
+    expected[serials[i]] = &values[i];
+  }
+  if ( index.insert( serials[0], &values[1] ) )
+    ok = false;
+  for ( size_t i = 0; i < serials.size(); i += 3 )
+  {
+    if ( !index.erase( serials[i] ) )
+      ok = false;
+    expected.erase( serials[i] );
+  }
+  if ( index.erase( serials[0] ) )
+    ok = false;
+  for ( size_t i = 0; i < serials.size(); i += 6 )
+  {
+    index.insert( serials[i], &values[i] );
+    expected[serials[i]] = &values[i];
+  }
+  if ( index.size() != expected.size() )
+    ok = false;
+  for ( size_t i = 0; i < serials.size() && ok; ++i )
+  {
+    auto itr = expected.find( serials[i] );
+    int* value = itr != expected.end() ? itr->second : nullptr;
+    if ( index.find( serials[i] ) != value || index.find( serials[i] + 1000000 ) != nullptr )
+      ok = false;
+  }
+  size_t visited = 0;
+  index.for_each( [&visited]( int* ) { ++visited; } );
+  if ( visited != expected.size() )
+    ok = false;
+
+  // an owning index releases on erase and keeps the objects while growing
+  int alive = 0;
+  {
+    Core::SerialIndex<Counted, ref_ptr<Counted>> owner;
+    for ( size_t i = 0; i < 5000; ++i )
+      owner.insert( serials[i], ref_ptr<Counted>( new Counted( alive ) ) );
+    if ( alive != 5000 || owner.insert( serials[0], ref_ptr<Counted>( new Counted( alive ) ) ) )
+      ok = false;
+    ref_ptr<Counted> kept( owner.find( serials[1] ) );
+    for ( size_t i = 0; i < 2500; ++i )
+      owner.erase( serials[i] );
+    if ( alive != 2501 || owner.find( serials[2500] ) == nullptr || kept->count() != 1 )
+      ok = false;
+  }
+  if ( alive != 0 )
+    ok = false;
+
+  if ( ok )
+    inc_successes();
+  else
+  {
+    INFO_PRINT << "SerialIndex test failure\n";
+    inc_failures();
+  }
+}
+
+#ifdef ENABLE_BENCHMARK
+namespace
+{
+// random lookups, enough that they do not all stay in the cache
+const size_t LOOKUPS = 1 << 20;
+
+// building millions of entries takes a while, keep the last container between the runs
+struct LookupData
+{
+  std::vector<u32> serials;
+  std::vector<int> values;
+  std::vector<u32> lookups;
+  std::map<u32, int*> map;
+  std::unique_ptr<Core::SerialIndex<int>> index;
+};
+
+LookupData& lookup_data( size_t count )
+{
+  static LookupData data;
+  if ( data.serials.size() != count )
+  {
+    data.serials = make_serials( count );
+    data.values.assign( count, 0 );
+    data.lookups.clear();
+    for ( size_t i = 0; i < LOOKUPS; ++i )
+      data.lookups.push_back( data.serials[Clib::random_int( static_cast<int>( count ) - 1 )] );
+    data.map.clear();
+    data.index.reset();
+  }
+  return data;
+}
+}  // namespace
+
+static void BM_serial_lookup_map( benchmark::State& state )
+{
+  LookupData& data = lookup_data( static_cast<size_t>( state.range( 0 ) ) );
+  if ( data.map.empty() )
+  {
+    for ( size_t i = 0; i < data.serials.size(); ++i )
+      data.map.insert( data.map.end(), std::make_pair( data.serials[i], &data.values[i] ) );
+  }
+  size_t i = 0;
+  while ( state.KeepRunning() )
+    benchmark::DoNotOptimize( data.map.find( data.lookups[i++ & ( LOOKUPS - 1 )] ) );
+}
+BENCHMARK( BM_serial_lookup_map )->Arg( 1000000 )->Arg( 5000000 )->Arg( 10000000 );
+
+static void BM_serial_lookup_index( benchmark::State& state )
+{
+  LookupData& data = lookup_data( static_cast<size_t>( state.range( 0 ) ) );
+  if ( data.index == nullptr )
+  {
+    data.index.reset( new Core::SerialIndex<int>() );
+    for ( size_t i = 0; i < data.serials.size(); ++i )
+      data.index->insert( data.serials[i], &data.values[i] );
+  }
+  size_t i = 0;
+  while ( state.KeepRunning() )
+    benchmark::DoNotOptimize( data.index->find( data.lookups[i++ & ( LOOKUPS - 1 )] ) );
+}
+BENCHMARK( BM_serial_lookup_index )->Arg( 1000000 )->Arg( 5000000 )->Arg( 10000000 );
+#endif
+}  // namespace Testing
+}  // namespace Pol
@@ -0,0 +1,111 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#include "testenv.h"
+
+#include "pol_global_config.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#ifdef ENABLE_BENCHMARK
+#include <benchmark/benchmark.h>
+#endif
+
+#include "../../clib/logfacility.h"
+#include "../globals/uvars.h"
+#include "../realms/realm.h"
+#include "../uopathnode.h"
+
+namespace Pol
+{
+namespace Testing
+{
+namespace
+{
+typedef Plib::AStarSearch<Core::UOPathState> PathSearch;
+
+// searches like mf_FindPath without mobiles as blockers, returns the steps after the start
+bool find_path( PathSearch& search, short x1, short y1, short z1, short x2, short y2, short z2,
+                std::vector<Core::UOPathState>& path )
+{
+  Realms::Realm* realm = Core::gamestate.main_realm;
+  const short skirt = 5;
+  Core::AStarBlockers blockers( std::max( 0, std::min( x1, x2 ) - skirt ),
+                                std::max( x1, x2 ) + skirt,
+                                std::max( 0, std::min( y1, y2 ) - skirt ),
+                                std::max( y1, y2 ) + skirt );
+  Core::UOPathState start( x1, y1, z1, realm, &blockers );
+  Core::UOPathState goal( x2, y2, z2, realm, &blockers );
+  search.SetStartAndGoalStates( start, goal );
+  unsigned int state;
+  do
+  {
+    state = search.SearchStep( true );
+  } while ( state == PathSearch::SEARCH_STATE_SEARCHING );
+  path.clear();
+  if ( state != PathSearch::SEARCH_STATE_SUCCEEDED )
+    return false;
+  search.GetSolutionStart();
+  while ( Core::UOPathState* node = search.GetSolutionNext() )
+    path.push_back( *node );
+  search.FreeSolutionNodes();
+  return true;
+}
+
+void test_path( short x1, short y1, short z1, short x2, short y2, short z2 )
+{
+  INFO_PRINT << "FindPath(" << x1 << "," << y1 << "," << z1 << " - " << x2 << "," << y2 << ","
+             << z2 << "): ";
+  PathSearch search;
+  std::vector<Core::UOPathState> path;
+  bool ok = find_path( search, x1, y1, z1, x2, y2, z2, path ) && !path.empty() &&
+            path.back().x == x2 && path.back().y == y2;
+  // every step goes to a neighbouring tile
+  short x = x1, y = y1;
+  for ( const auto& node : path )
+  {
+    if ( std::abs( node.x - x ) > 1 || std::abs( node.y - y ) > 1 )
+      ok = false;
+    x = node.x;
+    y = node.y;
+  }
+  INFO_PRINT << path.size() << " steps: ";
+  if ( ok )
+  {
+    INFO_PRINT << "Ok!\n";
+    inc_successes();
+  }
+  else
+  {
+    INFO_PRINT << "Failure!\n";
+    inc_failures();
+  }
+}
+}  // namespace
+
+void pathfind_test()
+{
+  INFO_PRINT << "POL datafile FindPath tests:\n";
+  // along the street in britain
+  test_path( 1381, 1625, 30, 1414, 1625, 23 );
+  // down the stairs
+  test_path( 1352, 1635, 72, 1352, 1627, 50 );
+}
+
+#ifdef ENABLE_BENCHMARK
+static void BM_findpath( benchmark::State& state )
+{
+  PathSearch search( 10000 );
+  std::vector<Core::UOPathState> path;
+  while ( state.KeepRunning() )
+    benchmark::DoNotOptimize( find_path( search, 1381, 1625, 30, 1414, 1625, 23, path ) );
+}
+BENCHMARK( BM_findpath );
+#endif
+}  // namespace Testing
+}  // namespace Pol
@@ -0,0 +1,275 @@
+/** @file
+ *
+ * @par History
+ */
+
+
+#ifndef POL_TIMERWHEEL_H
+#define POL_TIMERWHEEL_H
+
+#include <algorithm>
+#include <cstddef>
+
+#include "../clib/passert.h"
+
+namespace Pol
+{
+namespace Core
+{
+/**
+ * Hierarchical timing wheel with intrusive nodes.
+ * Schedule and cancel are O(1) and do not allocate, the node lives inside the scheduled object.
+ * Every level has 2^BITS slots, a slot of level L covers 2^(BITS*L) ticks. Entries which are due
+ * too far in the future for the highest level wait in an overflow slot.
+ * Entries get moved to the next lower level (cascade) when time reaches their slot.
+ */
+template <class T, class Clock, unsigned int BITS = 6, unsigned int LEVELS = 4>
+class TimerWheel
+{
+  struct Slot;
+
+public:
+  class Node
+  {
+  public:
+    explicit Node( T* owner )
+        : _owner( owner ), _prev( nullptr ), _next( nullptr ), _slot( nullptr ), _when( 0 ), _level( 0 )
+    {
+    }
+    Node( const Node& ) = delete;
+    Node& operator=( const Node& ) = delete;
+
+    bool linked() const { return _slot != nullptr; }
+    Clock when() const { return _when; }
+
+  private:
+    friend class TimerWheel;
+    T* _owner;
+    Node* _prev;
+    Node* _next;
+    Slot* _slot;
+    Clock _when;
+    unsigned int _level;
+  };
+
+  class const_iterator
+  {
+  public:
+    T* operator*() const { return _node->_owner; }
+    const_iterator& operator++()
+    {
+      _node = _node->_next;
+      skip_empty();
+      return *this;
+    }
+    bool operator==( const const_iterator& other ) const { return _node == other._node; }
+    bool operator!=( const const_iterator& other ) const { return _node != other._node; }
+
+  private:
+    friend class TimerWheel;
+    const_iterator( const TimerWheel* wheel, size_t slot, Node* node )
+        : _wheel( wheel ), _slot( slot ), _node( node )
+    {
+    }
+    void skip_empty()
+    {
+      while ( _node == nullptr && ++_slot < SLOT_COUNT )
+        _node = _wheel->slot_at( _slot ).head;
+    }
+    const TimerWheel* _wheel;
+    size_t _slot;
+    Node* _node;
+  };
+
+  TimerWheel() : _now( 0 ), _size( 0 ), _wheel(), _overflow(), _counts() {}
+  TimerWheel( const TimerWheel& ) = delete;
+  TimerWheel& operator=( const TimerWheel& ) = delete;
+
+  bool empty() const { return _size == 0; }
+  size_t size() const { return _size; }
+
+  // node must not be scheduled already, returns the node as handle for erase
+  Node* insert( Node* node, Clock when )
+  {
+    passert( !node->linked() );
+    node->_when = when;
+    place( node );
+    ++_size;
+    return node;
+  }
+
+  void erase( Node* node )
+  {
+    passert( node->linked() );
+    unlink( node );
+    --_size;
+  }
+
+  // Returns the earliest entry which is due at now, without removing it.
+  // Advances the wheel, so now has to be monotonic.
+  T* next_expired( Clock now )
+  {
+    if ( _size == 0 )
+    {
+      _now = std::max( _now, now );
+      return nullptr;
+    }
+    for ( ;; )
+    {
+      Node* node = _wheel[0][_now & MASK].head;
+      if ( node != nullptr )
+        return node->_owner;
+      if ( _now >= now )
+        return nullptr;
+      advance( now );
+    }
+  }
+
+  // lower bound for the time of the next expiration, only valid if not empty
+  Clock next_expiry() const
+  {
+    // overflow entries are due after the next cascade of the highest level
+    Clock best = next_boundary( LEVELS - 1 );
+    for ( Clock i = 0; i <= MASK; ++i )
+    {
+      if ( _wheel[0][( _now + i ) & MASK].head != nullptr )
+      {
+        best = _now + i;
+        break;
+      }
+    }
+    // entries of higher levels may still be due before the ones already in level 0
+    for ( unsigned int level = 1; level < LEVELS; ++level )
+    {
+      if ( _counts[level] == 0 )
+        continue;
+      const Clock block = _now >> ( BITS * level );
+      for ( Clock i = 1; i <= SLOTS; ++i )
+      {
+        if ( _wheel[level][( block + i ) & MASK].head != nullptr )
+        {
+          best = std::min( best, ( block + i ) << ( BITS * level ) );
+          break;
+        }
+      }
+    }
+    return best;
+  }
+
+  const_iterator begin() const
+  {
+    const_iterator itr( this, 0, slot_at( 0 ).head );
+    itr.skip_empty();
+    return itr;
+  }
+  const_iterator end() const { return const_iterator( this, SLOT_COUNT, nullptr ); }
+
+private:
+  static const Clock SLOTS = Clock( 1 ) << BITS;
+  static const Clock MASK = SLOTS - 1;
+  static const size_t SLOT_COUNT = SLOTS * LEVELS + 1;
+
+  struct Slot
+  {
+    Node* head = nullptr;
+    Node* tail = nullptr;
+  };
+
+  const Slot& slot_at( size_t index ) const
+  {
+    if ( index == SLOTS * LEVELS )
+      return _overflow;
+    return _wheel[index / SLOTS][index % SLOTS];
+  }
+
+  // first tick after _now which starts a new slot of the given level
+  Clock next_boundary( unsigned int level ) const
+  {
+    return ( _now | ( ( Clock( 1 ) << ( BITS * level ) ) - 1 ) ) + 1;
+  }
+
+  void place( Node* node )
+  {
+    // already due entries go into the current slot
+    const Clock at = std::max( node->_when, _now );
+    const Clock delta = at - _now;
+    unsigned int level = 0;
+    while ( level < LEVELS && delta >= ( Clock( 1 ) << ( BITS * ( level + 1 ) ) ) )
+      ++level;
+    Slot& slot =
+        level == LEVELS ? _overflow : _wheel[level][( at >> ( BITS * level ) ) & MASK];
+    node->_level = level;
+    node->_slot = &slot;
+    node->_next = nullptr;
+    node->_prev = slot.tail;
+    if ( slot.tail != nullptr )
+      slot.tail->_next = node;
+    else
+      slot.head = node;
+    slot.tail = node;
+    ++_counts[level];
+  }
+
+  void unlink( Node* node )
+  {
+    Slot& slot = *node->_slot;
+    if ( node->_prev != nullptr )
+      node->_prev->_next = node->_next;
+    else
+      slot.head = node->_next;
+    if ( node->_next != nullptr )
+      node->_next->_prev = node->_prev;
+    else
+      slot.tail = node->_prev;
+    node->_prev = node->_next = nullptr;
+    node->_slot = nullptr;
+    --_counts[node->_level];
+  }
+
+  void advance( Clock limit )
+  {
+    // nothing can expire before the next slot of the lowest non empty level starts
+    Clock next = _now + 1;
+    for ( unsigned int level = 0; level + 1 < LEVELS && _counts[level] == 0; ++level )
+      next = next_boundary( level + 1 );
+    _now = std::min( next, limit );
+    if ( ( _now & MASK ) == 0 )
+      cascade();
+  }
+
+  void cascade()
+  {
+    for ( unsigned int level = 1; level < LEVELS; ++level )
+    {
+      const Clock index = ( _now >> ( BITS * level ) ) & MASK;
+      replace( _wheel[level][index] );
+      if ( index != 0 )
+        return;
+    }
+    replace( _overflow );
+  }
+
+  void replace( Slot& slot )
+  {
+    // detach first, entries may land in the same slot again (overflow)
+    Node* node = slot.head;
+    slot.head = slot.tail = nullptr;
+    while ( node != nullptr )
+    {
+      Node* next = node->_next;
+      --_counts[node->_level];
+      place( node );
+      node = next;
+    }
+  }
+
+  Clock _now;
+  size_t _size;
+  Slot _wheel[LEVELS][SLOTS];
+  Slot _overflow;
+  size_t _counts[LEVELS + 1];
+};
+}  // namespace Core
+}  // namespace Pol
+
+#endif  // POL_TIMERWHEEL_H
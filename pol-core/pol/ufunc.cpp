@@ -1490,20 +1490,34 @@ void send_death_message( Character* chr_died, Item* corpse )
   } );
 }
 
+// copies the packet once on first use, every receiver queues the same buffer
+static void queue_shared( Client* client, Network::SharedPacketData& shared, const void* msg,
+                          unsigned msglen )
+{
+  if ( !shared )
+  {
+    const u8* data = static_cast<const u8*>( msg );
+    shared = std::make_shared<const std::vector<u8>>( data, data + msglen );
+  }
+  Core::networkManager.clientTransmit->AddToQueue( client, shared );
+}
+
 void transmit_to_inrange( const UObject* center, const void* msg, unsigned msglen )
 {
+  Network::SharedPacketData shared;
   WorldIterator<OnlinePlayerFilter>::InVisualRange( center, [&]( Character* zonechr ) {
-    Core::networkManager.clientTransmit->AddToQueue( zonechr->client, msg, msglen );
+    queue_shared( zonechr->client, shared, msg, msglen );
   } );
 }
 
 void transmit_to_others_inrange( Character* center, const void* msg, unsigned msglen )
 {
+  Network::SharedPacketData shared;
   WorldIterator<OnlinePlayerFilter>::InVisualRange( center, [&]( Character* zonechr ) {
     Client* client = zonechr->client;
     if ( zonechr == center )
       return;
-    Core::networkManager.clientTransmit->AddToQueue( client, msg, msglen );
+    queue_shared( client, shared, msg, msglen );
   } );
 }
 
@@ -1582,6 +1596,8 @@ void subtract_amount_from_item( Item* item, unsigned short amount )
 
 void move_item( Item* item, Plib::UFACING facing )
 {
+  item->set_dirty();
+
   u16 oldx = item->x;
   u16 oldy = item->y;
 
@@ -53,6 +53,7 @@
 #include "multi/house.h"
 #include "multi/multi.h"
 #include "objecthash.h"
+#include "parallelcfgread.h"
 #include "polvar.h"
 #include "resource.h"
 #include "savedata.h"
@@ -361,6 +362,17 @@ std::string elapsed( clock_t start, clock_t end )
   return Clib::tostring( ms ) + " ms";
 }
 
+std::string world_data_file( const std::string& basename )
+{
+  // only one format exists after a save, the configured one wins after a manual conversion
+  const std::string path = Plib::systemstate.config.world_data_path + basename;
+  const std::string txtfile = path + ".txt";
+  const std::string binfile = path + ".bin";
+  if ( Plib::systemstate.config.binary_worldsave )
+    return ( Clib::FileExists( binfile ) || !Clib::FileExists( txtfile ) ) ? binfile : txtfile;
+  return ( Clib::FileExists( txtfile ) || !Clib::FileExists( binfile ) ) ? txtfile : binfile;
+}
+
 void slurp( const char* filename, const char* tags, int sysfind_flags )
 {
   static int num_until_dot = 1000;
@@ -368,11 +380,11 @@ void slurp( const char* filename, const char* tags, int sysfind_flags )
   if ( Clib::FileExists( filename ) )
   {
     INFO_PRINT << "  " << filename << ":";
-    Clib::ConfigFile cf( filename, tags );
-    Clib::ConfigElem elem;
-
     Tools::Timer<> timer;
 
+    ParallelConfigReader cf( filename, tags );
+    Clib::ConfigElem elem;
+
     unsigned int nobjects = 0;
     while ( cf.read( elem ) )
     {
@@ -418,7 +430,8 @@ void slurp( const char* filename, const char* tags, int sysfind_flags )
 
     timer.stop();
 
-    INFO_PRINT << " " << nobjects << " elements in " << timer.ellapsed() << " ms.\n";
+    INFO_PRINT << " " << nobjects << " elements in " << timer.ellapsed() << " ms ("
+               << cf.timing_summary( timer.ellapsed() ) << ").\n";
   }
 }
 
@@ -444,42 +457,42 @@ void read_pol_dat()
 
 void read_objects_dat()
 {
-  slurp( ( Plib::systemstate.config.world_data_path + "objects.txt" ).c_str(),
+  slurp( world_data_file( "objects" ).c_str(),
          "CHARACTER NPC ITEM GLOBALPROPERTIES" );
 }
 
 void read_pcs_dat()
 {
-  slurp( ( Plib::systemstate.config.world_data_path + "pcs.txt" ).c_str(), "CHARACTER ITEM",
+  slurp( world_data_file( "pcs" ).c_str(), "CHARACTER ITEM",
          SYSFIND_SKIP_WORLD );
 }
 
 void read_pcequip_dat()
 {
-  slurp( ( Plib::systemstate.config.world_data_path + "pcequip.txt" ).c_str(), "ITEM",
+  slurp( world_data_file( "pcequip" ).c_str(), "ITEM",
          SYSFIND_SKIP_WORLD );
 }
 
 void read_npcs_dat()
 {
-  slurp( ( Plib::systemstate.config.world_data_path + "npcs.txt" ).c_str(), "NPC ITEM",
+  slurp( world_data_file( "npcs" ).c_str(), "NPC ITEM",
          SYSFIND_SKIP_WORLD );
 }
 
 void read_npcequip_dat()
 {
-  slurp( ( Plib::systemstate.config.world_data_path + "npcequip.txt" ).c_str(), "ITEM",
+  slurp( world_data_file( "npcequip" ).c_str(), "ITEM",
          SYSFIND_SKIP_WORLD );
 }
 
 void read_items_dat()
 {
-  slurp( ( Plib::systemstate.config.world_data_path + "items.txt" ).c_str(), "ITEM" );
+  slurp( world_data_file( "items" ).c_str(), "ITEM" );
 }
 
 void read_multis_dat()
 {
-  slurp( ( Plib::systemstate.config.world_data_path + "multis.txt" ).c_str(), "MULTI" );
+  slurp( world_data_file( "multis" ).c_str(), "MULTI" );
   //  string multisfile = config.world_data_path + "multis.txt";
   //  if (FileExists( multisfile ))
   //  {
@@ -498,21 +511,22 @@ void read_multis_dat()
 
 void read_storage_dat()
 {
-  std::string storagefile = Plib::systemstate.config.world_data_path + "storage.txt";
+  std::string storagefile = world_data_file( "storage" );
 
   if ( Clib::FileExists( storagefile ) )
   {
     INFO_PRINT << "  " << storagefile << ":";
-    Clib::ConfigFile cf2( storagefile );
+    ParallelConfigReader cf2( storagefile );
     gamestate.storage.read( cf2 );
   }
 }
 
 Items::Item* find_existing_item( u32 objtype, u16 x, u16 y, s8 z, Realms::Realm* realm )
 {
-  unsigned short wx, wy;
-  zone_convert( x, y, &wx, &wy, realm );
-  for ( auto& item : realm->zone[wx][wy].items )
+  const ZoneItems* block = getzone( x, y, realm ).item_blocks.at( x, y );
+  if ( block == nullptr )
+    return nullptr;
+  for ( auto& item : *block )
   {
     // FIXME won't find doors which have been perturbed
     if ( item->objtype_ == objtype && item->x == x && item->y == y && item->z == z )
@@ -612,6 +626,7 @@ int read_data()
 {
   std::string objectsndtfile = Plib::systemstate.config.world_data_path + "objects.ndt";
   std::string storagendtfile = Plib::systemstate.config.world_data_path + "storage.ndt";
+  std::string storagenbnfile = Plib::systemstate.config.world_data_path + "storage.nbn";
 
   stateManager.gflag_in_system_load = true;
   if ( Clib::FileExists( objectsndtfile ) )
@@ -623,8 +638,10 @@ int read_data()
                 << "forcing human intervention.\n";
     throw std::runtime_error( "Human intervention required." );
   }
-  if ( Clib::FileExists( storagendtfile ) )
+  if ( Clib::FileExists( storagendtfile ) || Clib::FileExists( storagenbnfile ) )
   {
+    if ( !Clib::FileExists( storagendtfile ) )
+      storagendtfile = storagenbnfile;
     ERROR_PRINT << "Error!\n"
                 << "'" << storagendtfile << " exists.  This probably means the system\n"
                 << "exited while writing its state.  To avoid loss of data,\n"
@@ -672,11 +689,7 @@ int read_data()
   while ( !parent_conts.empty() )
     parent_conts.pop();
 
-  for ( ObjectHash::hs::const_iterator citr = objStorageManager.objecthash.begin(),
-                                       citrend = objStorageManager.objecthash.end();
-        citr != citrend; ++citr )
-  {
-    UObject* obj = ( *citr ).second.get();
+  objStorageManager.objecthash.ForEach( []( UObject* obj ) {
     if ( obj->ismobile() )
     {
       Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -684,12 +697,21 @@ int read_data()
       if ( chr->acct != nullptr )
         chr->logged_in( false );
     }
-  }
+  } );
 
   stateManager.gflag_in_system_load = false;
   return 0;
 }
 
+// text (*.ndt) or binary (*.nbn), commit() makes them the current save
+void init_world_data_file( Clib::OFStreamWriter& sw, const std::string& basename )
+{
+  const std::string path = Plib::systemstate.config.world_data_path + basename;
+  if ( Plib::systemstate.config.binary_worldsave )
+    sw.init_binary( path + ".nbn" );
+  else
+    sw.init( path + ".ndt" );
+}
 
 SaveContext::SaveContext()
     : _pol(),
@@ -721,13 +743,13 @@ SaveContext::SaveContext()
 {
   pol.init( Plib::systemstate.config.world_data_path + "pol.ndt" );
   objects.init( Plib::systemstate.config.world_data_path + "objects.ndt" );
-  pcs.init( Plib::systemstate.config.world_data_path + "pcs.ndt" );
-  pcequip.init( Plib::systemstate.config.world_data_path + "pcequip.ndt" );
-  npcs.init( Plib::systemstate.config.world_data_path + "npcs.ndt" );
-  npcequip.init( Plib::systemstate.config.world_data_path + "npcequip.ndt" );
-  items.init( Plib::systemstate.config.world_data_path + "items.ndt" );
-  multis.init( Plib::systemstate.config.world_data_path + "multis.ndt" );
-  storage.init( Plib::systemstate.config.world_data_path + "storage.ndt" );
+  init_world_data_file( pcs, "pcs" );
+  init_world_data_file( pcequip, "pcequip" );
+  init_world_data_file( npcs, "npcs" );
+  init_world_data_file( npcequip, "npcequip" );
+  init_world_data_file( items, "items" );
+  init_world_data_file( multis, "multis" );
+  init_world_data_file( storage, "storage" );
   resource.init( Plib::systemstate.config.world_data_path + "resource.ndt" );
   guilds.init( Plib::systemstate.config.world_data_path + "guilds.ndt" );
   datastore.init( Plib::systemstate.config.world_data_path + "datastore.ndt" );
@@ -796,6 +818,28 @@ SaveContext::~SaveContext()
   party.flush_file();
 }
 
+std::vector<Clib::OFStreamWriter*> SaveContext::writers()
+{
+  return {&pol,    &objects, &pcs,      &pcequip, &npcs,      &npcequip, &items,
+          &multis, &storage, &resource, &guilds,  &datastore, &party};
+}
+
+void SaveContext::defer_flush()
+{
+  for ( auto writer : writers() )
+    writer->defer_flush( true );
+}
+
+void SaveContext::flush_all()
+{
+  std::vector<std::future<bool>> tasks;
+  for ( auto writer : writers() )
+    tasks.push_back(
+        gamestate.task_thread_pool.checked_push( [writer]() { writer->flush_file(); } ) );
+  for ( auto& task : tasks )
+    task.get();  // rethrows i/o errors
+}
+
 /// blocks till possible last commit finishes
 void SaveContext::ready()
 {
@@ -851,16 +895,18 @@ inline void WriteGottenItem( Mobile::Character* chr, Items::Item* item, Clib::St
   item->z = chr->z;
   item->realm = chr->realm;
 
+  // the position is only valid for this save
+  item->forget_saved_text();
   item->printOn( sw );
+  item->forget_saved_text();
 
   item->x = item->y = item->z = 0;
 }
 
 void write_characters( Core::SaveContext& sc )
 {
-  for ( const auto& objitr : objStorageManager.objecthash )
+  for ( UObject* obj : objStorageManager.objecthash.Ordered() )
   {
-    UObject* obj = objitr.second.get();
     if ( obj->ismobile() && !obj->orphan() )
     {
       Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -876,9 +922,8 @@ void write_characters( Core::SaveContext& sc )
 
 void write_npcs( Core::SaveContext& sc )
 {
-  for ( const auto& objitr : objStorageManager.objecthash )
+  for ( UObject* obj : objStorageManager.objecthash.Ordered() )
   {
-    UObject* obj = objitr.second.get();
     if ( obj->ismobile() && !obj->orphan() )
     {
       Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -918,9 +963,8 @@ void write_items( Clib::StreamWriter& sw_items )
     }
   }
 
-  for ( const auto& objitr : objStorageManager.objecthash )
+  for ( UObject* obj : objStorageManager.objecthash.Ordered() )
   {
-    UObject* obj = objitr.second.get();
     if ( obj->ismobile() && !obj->orphan() )
     {
       Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -967,11 +1011,9 @@ void write_multis( Clib::StreamWriter& ofs )
   }
 }
 
-bool commit( const std::string& basename )
+bool commit_file( const std::string& bakfile, const std::string& datfile,
+                  const std::string& ndtfile )
 {
-  std::string bakfile = Plib::systemstate.config.world_data_path + basename + ".bak";
-  std::string datfile = Plib::systemstate.config.world_data_path + basename + ".txt";
-  std::string ndtfile = Plib::systemstate.config.world_data_path + basename + ".ndt";
   const char* bakfile_c = bakfile.c_str();
   const char* datfile_c = datfile.c_str();
   const char* ndtfile_c = ndtfile.c_str();
@@ -1014,6 +1056,15 @@ bool commit( const std::string& basename )
   return any;
 }
 
+bool commit( const std::string& basename )
+{
+  const std::string path = Plib::systemstate.config.world_data_path + basename;
+  // the current files of both formats become backups, so loading can't pick up an older save
+  bool any = commit_file( path + ".bak", path + ".txt", path + ".ndt" );
+  any = commit_file( path + ".bin.bak", path + ".bin", path + ".nbn" ) || any;
+  return any;
+}
+
 bool should_write_data()
 {
   if ( Plib::systemstate.config.inhibit_saves )
@@ -1036,6 +1087,8 @@ int write_data( unsigned int& dirty_writes, unsigned int& clean_writes, long lon
 
   UObject::dirty_writes = 0;
   UObject::clean_writes = 0;
+  // keeps the decoded cprops to those read again until the next save
+  PropertyList::forget_all_decoded();
 
   Tools::Timer<> timer;
   // launch complete save as seperate thread
@@ -1046,9 +1099,15 @@ int write_data( unsigned int& dirty_writes, unsigned int& clean_writes, long lon
   auto critical_future = critical_promise->get_future();
   SaveContext::finished = std::async( std::launch::async, [&, critical_promise]() -> bool {
     std::atomic<bool> result( true );
+    Tools::Timer<> save_timer;
+    long long critical_ms = 0;
     try
     {
       SaveContext sc;
+      // objects only get formatted while the world is locked, the files get written afterwards
+      const bool snapshot = Plib::systemstate.config.snapshot_worldsave;
+      if ( snapshot )
+        sc.defer_flush();
       std::vector<std::future<bool>> critical_parts;
       critical_parts.push_back( gamestate.task_thread_pool.checked_push( [&]() {
         try
@@ -1182,7 +1241,10 @@ int write_data( unsigned int& dirty_writes, unsigned int& clean_writes, long lon
       for ( auto& task : critical_parts )
         task.wait();
 
+      critical_ms = save_timer.ellapsed();
       critical_promise->set_value( result );  // critical part end
+      if ( snapshot )
+        sc.flush_all();
       // TODO: since promise can only be set one time move it into a method with a dedicated try
       // block, now when in theory an upper part fails the promise gets never set
     }  // deconstructor of the SaveContext flushes and joins the queues
@@ -1215,6 +1277,8 @@ int write_data( unsigned int& dirty_writes, unsigned int& clean_writes, long lon
       commit( "datastore" );
       commit( "parties" );
     }
+    POLLOG_INFO.Format( "Worldsave: formatting {} ms, writing files in the background {} ms\n" )
+        << critical_ms << save_timer.ellapsed() - critical_ms;
     return true;
   } );
   critical_future.wait();  // wait for end of critical part
@@ -1222,7 +1286,7 @@ int write_data( unsigned int& dirty_writes, unsigned int& clean_writes, long lon
   if ( Plib::systemstate.accounts_txt_dirty )  // write accounts extra, since it uses extra thread
                                                // for io operations would be to many threads working
   {
-    Accounts::write_account_data();
+    Accounts::write_account_changes();
   }
 
   commit_incremental_saves();
@@ -70,6 +70,7 @@ void display_unreaped_orphan_instances()
 
 std::atomic<unsigned int> UObject::dirty_writes;
 std::atomic<unsigned int> UObject::clean_writes;
+std::atomic<size_t> UObject::saved_text_bytes( 0 );
 
 UObject::UObject( u32 objtype, UOBJ_CLASS i_uobj_class )
     : ref_counted(),
@@ -82,7 +83,8 @@ UObject::UObject( u32 objtype, UOBJ_CLASS i_uobj_class )
       name_( "" ),
       _rev( 0 ),
       flags_(),
-      proplist_( CPropProfiler::class_to_type( i_uobj_class ) )
+      proplist_( CPropProfiler::class_to_type( i_uobj_class ) ),
+      saved_text_()
 {
   graphic = Items::getgraphic( objtype );
   flags_.set( OBJ_FLAGS::DIRTY );
@@ -103,12 +105,15 @@ UObject::~UObject()
     --stateManager.uobjcount.unreaped_orphans;
   }
   --stateManager.uobjcount.uobject_count;
+  forget_saved_text();
 }
 
 size_t UObject::estimatedSize() const
 {
   size_t size = sizeof( UObject ) + proplist_.estimatedSize();
   size += estimateSizeDynProps();
+  if ( saved_text_ != nullptr )
+    size += sizeof( SavedText ) + saved_text_->text->capacity();
   return size;
 }
 
@@ -154,11 +159,24 @@ void UObject::clear_dirty() const
   flags_.remove( OBJ_FLAGS::DIRTY );
 }
 
+void UObject::forget_saved_text() const
+{
+  if ( saved_text_ == nullptr )
+    return;
+  saved_text_bytes -= saved_text_->text->capacity();
+  saved_text_.reset();
+}
+
 bool UObject::getprop( const std::string& propname, std::string& propval ) const
 {
   return proplist_.getprop( propname, propval );
 }
 
+Bscript::BObjectImp* UObject::getpropimp( const std::string& propname ) const
+{
+  return proplist_.getpropimp( propname );
+}
+
 void UObject::setprop( const std::string& propname, const std::string& propvalue )
 {
   if ( propname[0] != '#' )
@@ -488,12 +506,48 @@ void UObject::printSelfOn( Clib::StreamWriter& sw ) const
 
 void UObject::printOn( Clib::StreamWriter& sw ) const
 {
-  sw() << classname() << pf_endl;
-  sw() << "{" << pf_endl;
-  printProperties( sw );
-  sw() << "}" << pf_endl;
-  sw() << pf_endl;
-  // sw.flush();
+  printCached( sw, [this]( Clib::StreamWriter& out ) {
+    out() << classname() << pf_endl;
+    out() << "{" << pf_endl;
+    printProperties( out );
+    out() << "}" << pf_endl;
+    out() << pf_endl;
+  } );
+}
+
+void UObject::printCached( Clib::StreamWriter& sw,
+                           const std::function<void( Clib::StreamWriter& )>& print ) const
+{
+  if ( !Plib::systemstate.config.snapshot_worldsave )
+  {
+    forget_saved_text();
+    print( sw );
+    return;
+  }
+  // set_dirty drops the text, moves and turns which bypass it are caught by the position
+  if ( saved_text_ != nullptr &&
+       ( saved_text_->realm != realm || saved_text_->x != x || saved_text_->y != y ||
+         saved_text_->z != z || saved_text_->facing != facing ) )
+    forget_saved_text();
+  if ( saved_text_ == nullptr )
+  {
+    Clib::FMTStreamWriter tmp;
+    print( tmp );
+    auto text = std::make_shared<const std::string>( tmp().str() );
+    size_t max_bytes =
+        static_cast<size_t>( Plib::systemstate.config.snapshot_worldsave_cache_size ) * 1024 *
+        1024;
+    if ( max_bytes != 0 && saved_text_bytes + text->capacity() > max_bytes )
+    {
+      // cache is full, this object gets formatted again by the next save
+      sw.write_shared( text );
+      return;
+    }
+    saved_text_bytes += text->capacity();
+    saved_text_.reset( new SavedText{text, realm, x, y, z, facing} );
+  }
+  // a deferred save file only keeps a reference, the text is written after the lock is released
+  sw.write_shared( saved_text_->text );
 }
 
 void UObject::printOnDebug( Clib::StreamWriter& sw ) const
@@ -19,8 +19,10 @@
 #include <atomic>
 #include <boost/any.hpp>
 #include <boost/flyweight.hpp>
+#include <functional>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -154,6 +156,7 @@ public:
   void setname( const std::string& );
 
   bool getprop( const std::string& propname, std::string& propvalue ) const;
+  Bscript::BObjectImp* getpropimp( const std::string& propname ) const;
   void setprop( const std::string& propname, const std::string& propvalue );
   void eraseprop( const std::string& propname );
   void copyprops( const UObject& obj );
@@ -226,12 +229,20 @@ public:
   bool dirty() const;
   void set_dirty();
   void clear_dirty() const;
+  // drops the element text printOn keeps for SnapshotWorldSave
+  void forget_saved_text() const;
   static std::atomic<unsigned int> dirty_writes;
   static std::atomic<unsigned int> clean_writes;
+  // bytes of element text kept by all objects, limited by pol.cfg SnapshotWorldSaveCacheSize
+  static std::atomic<size_t> saved_text_bytes;
 
 protected:
   virtual void printProperties( Clib::StreamWriter& sw ) const;
   virtual void printDebugProperties( Clib::StreamWriter& sw ) const;
+  // Writes the element formatted by print. With SnapshotWorldSave the text is kept and written
+  // again by the next save as long as the object does not get dirty.
+  void printCached( Clib::StreamWriter& sw,
+                    const std::function<void( Clib::StreamWriter& )>& print ) const;
 
   UObject( u32 objtype, UOBJ_CLASS uobj_class );
   virtual ~UObject();
@@ -301,7 +312,19 @@ protected:
   mutable AttributeFlags<OBJ_FLAGS> flags_;
 
 private:
+  // the position is stored too, it also gets changed by code which does not call set_dirty.
+  // The text never changes, a save in progress keeps it after the object dropped it.
+  struct SavedText
+  {
+    std::shared_ptr<const std::string> text;
+    const Realms::Realm* realm;
+    u16 x;
+    u16 y;
+    s8 z;
+    u8 facing;
+  };
   PropertyList proplist_;
+  mutable std::unique_ptr<SavedText> saved_text_;
 
 private:  // not implemented:
   UObject( const UObject& );
@@ -318,6 +341,8 @@ inline bool UObject::specific_name() const
 inline void UObject::set_dirty()
 {
   flags_.set( OBJ_FLAGS::DIRTY );
+  if ( saved_text_ != nullptr )
+    forget_saved_text();
 }
 
 inline void UObject::ref_counted_add_ref()
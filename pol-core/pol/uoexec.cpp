@@ -28,7 +28,8 @@ UOExecutor::UOExecutor()
       can_access_offline_mobiles( false ),
       auxsvc_assume_string( false ),
       pParent( nullptr ),
-      pChild( nullptr )
+      pChild( nullptr ),
+      hold_node( this )
 {
   weakptr.set( this );
   os_module = new Module::OSExecutorModule( *this );
@@ -66,6 +66,9 @@ public:
 
   UOExecutor *pParent, *pChild;
 
+  // entry in the scheduler holdlist while sleeping with timeout
+  Core::HoldList::Node hold_node;
+
 public:
   bool critical() const;
   void critical( bool critical );
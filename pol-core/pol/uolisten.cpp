@@ -20,6 +20,7 @@
 #include "core.h"
 #include "globals/network.h"
 #include "network/client.h"
+#include "network/clientreactor.h"
 #include "network/clienttransmit.h"
 #include "network/cliface.h"
 #include "polsem.h"
@@ -47,6 +48,11 @@ void UoClientThread::run()
     if ( !create() )
       return;
   }
+  if ( networkManager.clientReactor )
+  {
+    networkManager.clientReactor->add( client );
+    return;
+  }
   client->thread_pid = threadhelp::thread_pid();
   client_io_thread( client );
 }
@@ -126,6 +132,13 @@ void uo_client_listener_thread( void* arg )
           ls->login_clients.push_back( std::move( thread ) );
         }
       }
+      else if ( networkManager.clientReactor )
+      {
+        // no thread needed, the reactor takes over directly
+        UoClientThread thread( ls, std::move( newsck ) );
+        if ( thread.create() )
+          networkManager.clientReactor->add( thread.client );
+      }
       else
       {
         Clib::SocketClientThread* thread = new UoClientThread( ls, std::move( newsck ) );
@@ -147,7 +160,10 @@ void uo_client_listener_thread( void* arg )
 
         if ( client->isConnected() && client->chr )
         {
-          Clib::SocketClientThread::start_thread( itr->release() );
+          if ( networkManager.clientReactor )
+            networkManager.clientReactor->add( client );
+          else
+            Clib::SocketClientThread::start_thread( itr->release() );
           itr = ls->login_clients.erase( itr );
         }
         else if ( ( ( *itr )->login_time +
@@ -175,6 +191,15 @@ void uo_client_listener_thread( void* arg )
 
 void start_uo_client_listeners( void )
 {
+  if ( Plib::systemstate.config.network_reactor_threads > 0 )
+  {
+    if ( Network::ClientReactor::supported() )
+      networkManager.clientReactor.reset(
+          new Network::ClientReactor( Plib::systemstate.config.network_reactor_threads ) );
+    else
+      POLLOG_ERROR << "NetworkReactorThreads is not supported on this platform, using one thread "
+                      "per client\n";
+  }
   for ( unsigned i = 0; i < networkManager.uoclient_listeners.size(); ++i )
   {
     UoClientListener* ls = &networkManager.uoclient_listeners[i];
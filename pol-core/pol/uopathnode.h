@@ -11,6 +11,7 @@
 #include "../plib/stlastar.h"
 #include "realms/realm.h"
 
+#include "globals/settings.h"
 #include "realms.h"
 
 namespace Pol
@@ -103,23 +104,30 @@ public:
                       bool doors_block );
   float GetCost( UOPathState& successor );
   bool IsSameState( UOPathState& rhs );
+  size_t Hash() const;
   std::string Name();
 };
-bool UOPathState::IsSameState( UOPathState& rhs )
+inline bool UOPathState::IsSameState( UOPathState& rhs )
 {
   return ( ( rhs.x == x ) && ( rhs.y == y ) && ( rhs.z == z ) && ( rhs.realm == realm ) );
 }
-float UOPathState::GoalDistanceEstimate( UOPathState& nodeGoal )
+inline size_t UOPathState::Hash() const
+{
+  // the realm is the same for all states of a search
+  return ( static_cast<size_t>( static_cast<u16>( x ) ) << 16 | static_cast<u16>( y ) ) ^
+         ( static_cast<size_t>( static_cast<u8>( z ) ) << 24 );
+}
+inline float UOPathState::GoalDistanceEstimate( UOPathState& nodeGoal )
 {
   return ( (float)( abs( x - nodeGoal.x ) + abs( y - nodeGoal.y ) + abs( z - nodeGoal.z ) ) );
 }
-bool UOPathState::IsGoal( UOPathState& nodeGoal )
+inline bool UOPathState::IsGoal( UOPathState& nodeGoal )
 {
   return ( ( nodeGoal.x == x ) && ( nodeGoal.y == y ) &&
            ( abs( nodeGoal.z - z ) <= settingsManager.ssopt.default_character_height ) );
   // return (IsSameState(nodeGoal));
 }
-float UOPathState::GetCost( UOPathState& successor )
+inline float UOPathState::GetCost( UOPathState& successor )
 {
   int xdiff = abs( x - successor.x );
   int ydiff = abs( y - successor.y );
@@ -128,21 +136,21 @@ float UOPathState::GetCost( UOPathState& successor )
   else
     return 1.0f;
 }
-std::string UOPathState::Name()
+inline std::string UOPathState::Name()
 {
   fmt::Writer writer;
   writer.Format( "({},{},{})" ) << x << y << z;
   return writer.str();
 }
-bool UOPathState::GetSuccessors( Plib::AStarSearch<UOPathState>* astarsearch,
-                                 UOPathState* /*parent_node*/, bool doors_block )
+inline bool UOPathState::GetSuccessors( Plib::AStarSearch<UOPathState>* astarsearch,
+                                        UOPathState* /*parent_node*/, bool doors_block )
 {
   Multi::UMulti* supporting_multi = nullptr;
   Items::Item* walkon_item = nullptr;
 
-  UOPathState SolutionStartNode = ( *( astarsearch->GetSolutionStart() ) );
-  UOPathState SolutionEndNode = ( *( astarsearch->GetSolutionEnd() ) );
-  UOPathState* NewNode = new UOPathState();
+  UOPathState& SolutionStartNode = *astarsearch->GetSolutionStart();
+  UOPathState& SolutionEndNode = *astarsearch->GetSolutionEnd();
+  UOPathState NewNode( x, y, z, realm, theBlockers );
 
   for ( short i = -1; i <= 1; i++ )
   {
@@ -179,30 +187,24 @@ bool UOPathState::GetSuccessors( Plib::AStarSearch<UOPathState>* astarsearch,
 
         if ( !blocked )
         {
-          NewNode->x = newx;
-          NewNode->y = newy;
-          NewNode->z = newz;
-          NewNode->realm = realm;
-          NewNode->theBlockers = theBlockers;
-
-          if ( ( !NewNode->IsSameState( SolutionStartNode ) ) &&
-               ( !NewNode->IsSameState( SolutionEndNode ) ) )
+          NewNode.x = newx;
+          NewNode.y = newy;
+          NewNode.z = newz;
+
+          if ( ( !NewNode.IsSameState( SolutionStartNode ) ) &&
+               ( !NewNode.IsSameState( SolutionEndNode ) ) )
             blocked = ( theBlockers->IsBlocking( newx, newy, newz ) );
         }
 
         if ( !blocked )
         {
-          if ( !astarsearch->AddSuccessor( *NewNode ) )
-          {
-            delete NewNode;
+          if ( !astarsearch->AddSuccessor( NewNode ) )
             return false;
-          }
         }
       }
     }
   }
 
-  delete NewNode;
   return true;
 }
 }  // namespace Core
@@ -67,6 +67,7 @@
 #include "accounts/acscrobj.h"
 #include "cmdlevel.h"
 #include "containr.h"
+#include "decay.h"
 #include "door.h"
 #include "dynproperties.h"
 #include "equipdsc.h"
@@ -1141,6 +1142,7 @@ BObjectImp* Item::set_script_member_id( const int id, int value )
     return new BLong( invisible() );
   case MBR_DECAYAT:
     decayat_gameclock_ = value;
+    schedule_decay( this );
     return new BLong( decayat_gameclock_ );
   case MBR_SELLPRICE:
     sellprice( value );
@@ -2869,6 +2871,7 @@ BObjectImp* Character::script_method_id( const int id, Executor& ex )
         lightoverride_until( 0 );
       else
         lightoverride_until( Core::read_gameclock() + duration );
+      queue_regen();
 
       check_region_changes();
       if ( duration == -1 )
@@ -3258,6 +3261,7 @@ BObjectImp* Character::script_method_id( const int id, Executor& ex )
       if ( duration < 0 )
         return new BError( "Duration must be >= 0" );
       disable_skills_until( Core::poltime() + duration );
+      queue_regen();
       return new BLong( static_cast<int>( disable_skills_until() ) );
     }
     break;
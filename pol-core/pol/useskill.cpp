@@ -73,6 +73,7 @@ bool StartSkillScript( Network::Client* client, const Mobile::Attribute* attrib
       if ( attrib->delay_seconds )
       {
         chr->disable_skills_until( poltime() + attrib->delay_seconds );
+        chr->queue_regen();
       }
       return true;
     }
@@ -19,6 +19,7 @@
 #include "../clib/clib_endian.h"
 #include "../clib/logfacility.h"
 #include "../clib/passert.h"
+#include "decay.h"
 #include "globals/uvars.h"
 #include "item/item.h"
 #include "mobile/charactr.h"
@@ -28,6 +29,65 @@ namespace Pol
 {
 namespace Core
 {
+void ZoneItemBlocks::add( Items::Item* item, unsigned short x, unsigned short y )
+{
+  if ( !_blocks )
+    _blocks.reset( new ZoneItems[BLOCKS * BLOCKS] );
+  _blocks[index( x, y )].push_back( item );
+}
+
+bool ZoneItemBlocks::remove( Items::Item* item, unsigned short x, unsigned short y )
+{
+  if ( !_blocks )
+    return false;
+  auto remove_from = [item]( ZoneItems& block ) {
+    auto itr = std::find( block.begin(), block.end(), item );
+    if ( itr == block.end() )
+      return false;
+    block.erase( itr );
+    return true;
+  };
+  if ( remove_from( _blocks[index( x, y )] ) )
+    return true;
+  // position was changed without updating the world
+  for ( unsigned i = 0; i < BLOCKS * BLOCKS; ++i )
+  {
+    if ( remove_from( _blocks[i] ) )
+      return true;
+  }
+  return false;
+}
+
+void ZoneItemBlocks::clear()
+{
+  _blocks.reset();
+}
+
+void ZoneItemBlocks::shrink_to_fit()
+{
+  if ( !_blocks )
+    return;
+  bool empty = true;
+  for ( unsigned i = 0; i < BLOCKS * BLOCKS; ++i )
+  {
+    _blocks[i].shrink_to_fit();
+    empty = empty && _blocks[i].empty();
+  }
+  if ( empty )
+    _blocks.reset();
+}
+
+size_t ZoneItemBlocks::estimatedSize() const
+{
+  size_t size = sizeof( ZoneItemBlocks );
+  if ( _blocks )
+  {
+    for ( unsigned i = 0; i < BLOCKS * BLOCKS; ++i )
+      size += 3 * sizeof( void** ) + _blocks[i].capacity() * sizeof( void* );
+  }
+  return size;
+}
+
 void add_item_to_world( Items::Item* item )
 {
   Zone& zone = getzone( item->x, item->y, item->realm );
@@ -36,6 +96,8 @@ void add_item_to_world( Items::Item* item )
 
   item->realm->add_toplevel_item( *item );
   zone.items.push_back( item );
+  zone.item_blocks.add( item, item->x, item->y );
+  add_item_to_decay( item );
 }
 
 void remove_item_from_world( Items::Item* item )
@@ -64,6 +126,8 @@ void remove_item_from_world( Items::Item* item )
 
   item->realm->remove_toplevel_item( *item );
   zone.items.erase( itr );
+  zone.item_blocks.remove( item, item->x, item->y );
+  remove_item_from_decay( item );
 }
 
 void add_multi_to_world( Multi::UMulti* multi )
@@ -140,6 +204,7 @@ void SetCharacterWorldPosition( Mobile::Character* chr, Realms::WorldChangeReaso
     set_pos( zone.characters );
 
   chr->realm->add_mobile( *chr, reason );
+  chr->queue_regen();
 }
 
 // Function for reporting the whereabouts of chars which are not in their expected zone
@@ -240,11 +305,18 @@ void MoveItemWorldPosition( unsigned short oldx, unsigned short oldy, Items::Ite
     passert( std::find( newzone.items.begin(), newzone.items.end(), item ) == newzone.items.end() );
     newzone.items.push_back( item );
   }
+  if ( &oldzone != &newzone || ( ( oldx ^ item->x ) >> ZoneItemBlocks::BLOCK_SHIFT ) != 0 ||
+       ( ( oldy ^ item->y ) >> ZoneItemBlocks::BLOCK_SHIFT ) != 0 )
+  {
+    oldzone.item_blocks.remove( item, oldx, oldy );
+    newzone.item_blocks.add( item, item->x, item->y );
+  }
 
   if ( oldrealm != item->realm )
   {
     oldrealm->remove_toplevel_item( *item );
     item->realm->add_toplevel_item( *item );
+    schedule_decay( item );
   }
 }
 
@@ -399,6 +471,7 @@ void optimize_zones()
         realm->zone[x][y].characters.shrink_to_fit();
         realm->zone[x][y].npcs.shrink_to_fit();
         realm->zone[x][y].items.shrink_to_fit();
+        realm->zone[x][y].item_blocks.shrink_to_fit();
         realm->zone[x][y].multis.shrink_to_fit();
       }
     }
@@ -23,6 +23,7 @@
 #include "mobile/charactr.h"
 #endif
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "../clib/passert.h"
@@ -65,11 +66,44 @@ typedef std::vector<Mobile::Character*> ZoneCharacters;
 typedef std::vector<Multi::UMulti*> ZoneMultis;
 typedef std::vector<Items::Item*> ZoneItems;
 
+// The items of a zone again, grouped by blocks of 8x8 tiles.
+// Queries of a single location only have to look at the items of one block.
+class ZoneItemBlocks
+{
+public:
+  static const unsigned BLOCK_SHIFT = 3;
+  static const unsigned BLOCKS = Plib::WGRID_SIZE >> BLOCK_SHIFT;  // per side
+
+  ZoneItemBlocks() : _blocks() {}
+
+  // items of the block containing x,y; nullptr if the zone has no items at all
+  const ZoneItems* at( unsigned short x, unsigned short y ) const
+  {
+    if ( !_blocks )
+      return nullptr;
+    return &_blocks[index( x, y )];
+  }
+  void add( Items::Item* item, unsigned short x, unsigned short y );
+  // searches the other blocks if the item is not in the block of x,y
+  bool remove( Items::Item* item, unsigned short x, unsigned short y );
+  void clear();
+  void shrink_to_fit();
+  size_t estimatedSize() const;
+
+private:
+  static unsigned index( unsigned short x, unsigned short y )
+  {
+    return ( ( x >> BLOCK_SHIFT ) % BLOCKS ) * BLOCKS + ( ( y >> BLOCK_SHIFT ) % BLOCKS );
+  }
+  std::unique_ptr<ZoneItems[]> _blocks;  // allocated with the first item
+};
+
 struct Zone
 {
   ZoneCharacters characters;
   ZoneCharacters npcs;
   ZoneItems items;
+  ZoneItemBlocks item_blocks;
   ZoneMultis multis;
 };
 
@@ -173,6 +207,10 @@ struct CoordsArea
   CoordsArea( u16 x, u16 y, const Realms::Realm* realm, unsigned range );    // create from range
   CoordsArea( u16 x1, u16 y1, u16 x2, u16 y2, const Realms::Realm* realm );  // create from box
   bool inRange( const UObject* obj ) const;
+  // true if the area spans at most ZoneItemBlocks::BLOCKS blocks per side
+  bool inItemBlocks() const;
+  template <typename F>
+  void forEachItemBlock( const Zone& zone, F&& f ) const;
 
   // shifted coords
   u16 wxL;
@@ -221,6 +259,34 @@ inline bool CoordsArea::inRange( const UObject* obj ) const
   return ( obj->x >= _xL && obj->x <= _xH && obj->y >= _yL && obj->y <= _yH );
 }
 
+inline bool CoordsArea::inItemBlocks() const
+{
+  return ( ( _xH >> ZoneItemBlocks::BLOCK_SHIFT ) - ( _xL >> ZoneItemBlocks::BLOCK_SHIFT ) <
+           static_cast<int>( ZoneItemBlocks::BLOCKS ) ) &&
+         ( ( _yH >> ZoneItemBlocks::BLOCK_SHIFT ) - ( _yL >> ZoneItemBlocks::BLOCK_SHIFT ) <
+           static_cast<int>( ZoneItemBlocks::BLOCKS ) );
+}
+
+// Calls f for every block of the zone which may hold items of the area.
+// Blocks of the area outside the zone map onto other blocks of the zone, their items are out of
+// range. Only valid if inItemBlocks(), otherwise a block could be visited twice.
+template <typename F>
+inline void CoordsArea::forEachItemBlock( const Zone& zone, F&& f ) const
+{
+  const int shift = ZoneItemBlocks::BLOCK_SHIFT;
+  for ( int bx = _xL >> shift; bx <= _xH >> shift; ++bx )
+  {
+    for ( int by = _yL >> shift; by <= _yH >> shift; ++by )
+    {
+      const ZoneItems* block = zone.item_blocks.at( static_cast<unsigned short>( bx << shift ),
+                                                    static_cast<unsigned short>( by << shift ) );
+      if ( block == nullptr )
+        return;
+      f( *block );
+    }
+  }
+}
+
 inline void CoordsArea::convert( int xL, int yL, int xH, int yH, const Realms::Realm* realm )
 {
   zone_convert_clip( xL, yL, realm, &wxL, &wyL );
@@ -329,6 +395,17 @@ template <>
 template <typename F>
 void FilterImp<FilterType::Item>::call( Core::Zone& zone, const CoordsArea& coords, F&& f )
 {
+  if ( coords.inItemBlocks() )
+  {
+    coords.forEachItemBlock( zone, [&]( const ZoneItems& block ) {
+      for ( auto& item : block )
+      {
+        if ( coords.inRange( item ) )
+          f( item );
+      }
+    } );
+    return;
+  }
   for ( auto& item : zone.items )
   {
     if ( coords.inRange( item ) )
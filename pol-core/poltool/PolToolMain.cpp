@@ -5,6 +5,7 @@
 
 #include <format/format.h>
 #include "../clib/Program/ProgramMain.h"
+#include "../clib/binarycfg.h"
 #include "../clib/clib_endian.h"
 #include "../clib/fileutil.h"
 #include "../clib/logfacility.h"
@@ -42,7 +43,10 @@ void PolToolMain::showHelp()
               << "            x1 y1 [x2 y2 realm]       writes polmap info to polmap.html\n"
               << "  POLTOOL uncompressgump FileName\n"
               << "        unpacks and prints 0xDD gump from given packet log\n"
-              << "        file needs to contain a single 0xDD packetlog\n";
+              << "        file needs to contain a single 0xDD packetlog\n"
+              << "  POLTOOL convertdata InFile OutFile\n"
+              << "        converts a data file (e.g. items.txt) between the text and the\n"
+              << "        binary format, the direction depends on the format of InFile\n";
 }
 
 int PolToolMain::mapdump()
@@ -247,6 +251,34 @@ int PolToolMain::unpackCompressedGump()
   return 0;
 }
 
+int PolToolMain::convertData()
+{
+  const std::vector<std::string>& binArgs = programArgs();
+  if ( binArgs.size() < 4 )
+  {
+    showHelp();
+    return 1;
+  }
+  if ( !Clib::FileExists( binArgs[2] ) )
+  {
+    ERROR_PRINT << "File " << binArgs[2] << " not found\n";
+    return 1;
+  }
+  try
+  {
+    if ( Clib::BinaryConfigFile::is_binary( binArgs[2] ) )
+      Clib::convert_config_to_text( binArgs[2], binArgs[3] );
+    else
+      Clib::convert_config_to_binary( binArgs[2], binArgs[3] );
+  }
+  catch ( std::exception& ex )
+  {
+    ERROR_PRINT << "Conversion failed: " << ex.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
+
 int PolToolMain::main()
 {
   const std::vector<std::string>& binArgs = programArgs();
@@ -271,6 +303,10 @@ int PolToolMain::main()
   {
     return unpackCompressedGump();
   }
+  else if ( binArgs[1] == "convertdata" )
+  {
+    return convertData();
+  }
   else
   {
     ERROR_PRINT << "Unknown command " << binArgs[1] << "\n";
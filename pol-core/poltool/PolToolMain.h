@@ -20,6 +20,7 @@ private:
   virtual void showHelp();
   int mapdump();
   int unpackCompressedGump();
+  int convertData();
 };
 }
 }  // namespaces
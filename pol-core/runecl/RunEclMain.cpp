@@ -64,7 +64,8 @@ void RunEclMain::showHelp()
               << "        Options:\n"
               << "            -q    Quiet\n"
               << "            -d    Debug output\n"
-              << "            -p    Profile\n";
+              << "            -p    Profile\n"
+              << "            -n    No superinstructions\n";
   // TODO: what about "-v" and "-a"?
 }
 
@@ -212,6 +213,8 @@ int RunEclMain::runecl()
       case 'Q':
       case 'p':
       case 'P':
+      case 'n':
+      case 'N':
         break;
       default:
         ERROR_PRINT << "Unknown option: " << binArgs[i] << "\n";
@@ -234,6 +237,7 @@ int RunEclMain::main()
   m_quiet = programArgsFind( "q" );
   m_debug = programArgsFind( "d" );
   m_profile = programArgsFind( "p" );
+  Pol::Bscript::escript_config.disable_superinstructions = programArgsFind( "n" );
 
   /**********************************************
    * show copyright